@@ -0,0 +1,306 @@
+// algobase.h 算法的微基准：wstl 与 std 的同名算法在三种元素类型、多种长度下对比。
+// 名字形如 bm_copy<wstl_algo, int>/1024，参数是元素个数。
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algobase.h"
+#include "bench_types.h"
+#include "benchmark.h"
+
+namespace {
+
+	using bench::make_value;
+	using bench::pod64;
+
+	// 把被测算法包装成同一组接口，基准函数只写一遍
+
+	struct wstl_algo {
+		template <class I, class O>
+		static O copy(I first, I last, O result) {
+			return wstl::copy(first, last, result);
+		}
+
+		template <class I, class O>
+		static O copy_backward(I first, I last, O result) {
+			return wstl::copy_backward(first, last, result);
+		}
+
+		template <class I, class O, class P>
+		static O copy_if(I first, I last, O result, P pred) {
+			return wstl::copy_if(first, last, result, pred);
+		}
+
+		template <class I, class N, class O>
+		static O copy_n(I first, N n, O result) {
+			return wstl::copy_n(first, n, result).second;
+		}
+
+		template <class I, class O>
+		static O move(I first, I last, O result) {
+			return wstl::move(first, last, result);
+		}
+
+		template <class I, class O>
+		static O move_backward(I first, I last, O result) {
+			return wstl::move_backward(first, last, result);
+		}
+
+		template <class I, class T>
+		static void fill(I first, I last, const T &value) {
+			wstl::fill(first, last, value);
+		}
+
+		template <class I, class N, class T>
+		static I fill_n(I first, N n, const T &value) {
+			return wstl::fill_n(first, n, value);
+		}
+
+		template <class I1, class I2>
+		static bool equal(I1 first1, I1 last1, I2 first2) {
+			return wstl::equal(first1, last1, first2);
+		}
+
+		template <class I1, class I2>
+		static bool lexicographical_compare(I1 first1, I1 last1, I2 first2, I2 last2) {
+			return wstl::lexicographical_compare(first1, last1, first2, last2);
+		}
+
+		template <class I1, class I2>
+		static I1 mismatch(I1 first1, I1 last1, I2 first2) {
+			return wstl::mismatch(first1, last1, first2).first;
+		}
+	};
+
+	struct std_algo {
+		template <class I, class O>
+		static O copy(I first, I last, O result) {
+			return std::copy(first, last, result);
+		}
+
+		template <class I, class O>
+		static O copy_backward(I first, I last, O result) {
+			return std::copy_backward(first, last, result);
+		}
+
+		template <class I, class O, class P>
+		static O copy_if(I first, I last, O result, P pred) {
+			return std::copy_if(first, last, result, pred);
+		}
+
+		template <class I, class N, class O>
+		static O copy_n(I first, N n, O result) {
+			return std::copy_n(first, n, result);
+		}
+
+		template <class I, class O>
+		static O move(I first, I last, O result) {
+			return std::move(first, last, result);
+		}
+
+		template <class I, class O>
+		static O move_backward(I first, I last, O result) {
+			return std::move_backward(first, last, result);
+		}
+
+		template <class I, class T>
+		static void fill(I first, I last, const T &value) {
+			std::fill(first, last, value);
+		}
+
+		template <class I, class N, class T>
+		static I fill_n(I first, N n, const T &value) {
+			return std::fill_n(first, n, value);
+		}
+
+		template <class I1, class I2>
+		static bool equal(I1 first1, I1 last1, I2 first2) {
+			return std::equal(first1, last1, first2);
+		}
+
+		template <class I1, class I2>
+		static bool lexicographical_compare(I1 first1, I1 last1, I2 first2, I2 last2) {
+			return std::lexicographical_compare(first1, last1, first2, last2);
+		}
+
+		template <class I1, class I2>
+		static I1 mismatch(I1 first1, I1 last1, I2 first2) {
+			return std::mismatch(first1, last1, first2).first;
+		}
+	};
+
+	// 两边都在原始数组上运行，排除容器本身的差异
+	template <class T>
+	std::vector<T> make_array(size_t n) {
+		std::vector<T> v;
+		v.reserve(n);
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back(make_value<T>(i));
+		}
+		return v;
+	}
+
+	template <class T>
+	void set_processed(bench::state &state, size_t n) {
+		state.set_items_processed(state.iterations() * n);
+		state.set_bytes_processed(state.iterations() * n * sizeof(T));
+	}
+
+	template <class Algo, class T>
+	void bm_copy(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto src = make_array<T>(n);
+		auto dst = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::copy(src.data(), src.data() + n, dst.data()));
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_copy_backward(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto src = make_array<T>(n);
+		auto dst = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::copy_backward(src.data(), src.data() + n, dst.data() + n));
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	// copy_if 保留一半元素
+	template <class Algo, class T>
+	void bm_copy_if(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto src = make_array<T>(n);
+		auto dst = make_array<T>(n);
+		const auto pivot = make_value<T>(n / 2);
+		while (state.keep_running()) {
+			bench::do_not_optimize(
+				Algo::copy_if(src.data(), src.data() + n, dst.data(), [&pivot](const T &x) { return x < pivot; }));
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_copy_n(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto src = make_array<T>(n);
+		auto dst = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::copy_n(src.data(), n, dst.data()));
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	// move 与 move_backward 来回搬动两个数组，对非平凡类型测量的是移动赋值
+	template <class Algo, class T>
+	void bm_move(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		auto a = make_array<T>(n);
+		auto b = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::move(a.data(), a.data() + n, b.data()));
+			a.swap(b);
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_move_backward(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		auto a = make_array<T>(n);
+		auto b = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::move_backward(a.data(), a.data() + n, b.data() + n));
+			a.swap(b);
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_fill(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		auto dst = make_array<T>(n);
+		const auto value = make_value<T>(7);
+		while (state.keep_running()) {
+			Algo::fill(dst.data(), dst.data() + n, value);
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_fill_n(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		auto dst = make_array<T>(n);
+		const auto value = make_value<T>(7);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::fill_n(dst.data(), n, value));
+			bench::clobber_memory();
+		}
+		set_processed<T>(state, n);
+	}
+
+	// equal / lexicographical_compare / mismatch 比较两个相同的数组，需要走完全程
+	template <class Algo, class T>
+	void bm_equal(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto a = make_array<T>(n);
+		const auto b = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::equal(a.data(), a.data() + n, b.data()));
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_lexicographical_compare(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto a = make_array<T>(n);
+		const auto b = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::lexicographical_compare(a.data(), a.data() + n, b.data(), b.data() + n));
+		}
+		set_processed<T>(state, n);
+	}
+
+	template <class Algo, class T>
+	void bm_mismatch(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto a = make_array<T>(n);
+		const auto b = make_array<T>(n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(Algo::mismatch(a.data(), a.data() + n, b.data()));
+		}
+		set_processed<T>(state, n);
+	}
+
+#define WSTL_ALGOBASE_BENCHMARK(fn)                                        \
+	WSTL_BENCHMARK_TEMPLATE(fn, wstl_algo, int)->range(16, 65536);         \
+	WSTL_BENCHMARK_TEMPLATE(fn, std_algo, int)->range(16, 65536);          \
+	WSTL_BENCHMARK_TEMPLATE(fn, wstl_algo, pod64)->range(16, 65536);       \
+	WSTL_BENCHMARK_TEMPLATE(fn, std_algo, pod64)->range(16, 65536);        \
+	WSTL_BENCHMARK_TEMPLATE(fn, wstl_algo, std::string)->range(16, 65536); \
+	WSTL_BENCHMARK_TEMPLATE(fn, std_algo, std::string)->range(16, 65536)
+
+	WSTL_ALGOBASE_BENCHMARK(bm_copy);
+	WSTL_ALGOBASE_BENCHMARK(bm_copy_backward);
+	WSTL_ALGOBASE_BENCHMARK(bm_copy_if);
+	WSTL_ALGOBASE_BENCHMARK(bm_copy_n);
+	WSTL_ALGOBASE_BENCHMARK(bm_move);
+	WSTL_ALGOBASE_BENCHMARK(bm_move_backward);
+	WSTL_ALGOBASE_BENCHMARK(bm_fill);
+	WSTL_ALGOBASE_BENCHMARK(bm_fill_n);
+	WSTL_ALGOBASE_BENCHMARK(bm_equal);
+	WSTL_ALGOBASE_BENCHMARK(bm_lexicographical_compare);
+	WSTL_ALGOBASE_BENCHMARK(bm_mismatch);
+} // namespace
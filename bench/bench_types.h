@@ -0,0 +1,60 @@
+// wstl_bench 各基准共用的元素类型与取值：
+//   int        : 平凡类型，wstl 走 memmove / memset 快速路径
+//   pod64      : 64 字节（一个缓存行）的平凡类型
+//   std::string: 非平凡类型，取值长度超过 SSO 容量，复制需要堆分配
+
+#ifndef WSTL_BENCH_BENCH_TYPES_H
+#define WSTL_BENCH_BENCH_TYPES_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace bench {
+
+	struct pod64 {
+		uint64_t v[8];
+	};
+
+	inline bool operator==(const pod64 &lhs, const pod64 &rhs) {
+		return std::memcmp(lhs.v, rhs.v, sizeof(lhs.v)) == 0;
+	}
+
+	inline bool operator!=(const pod64 &lhs, const pod64 &rhs) {
+		return !(lhs == rhs);
+	}
+
+	inline bool operator<(const pod64 &lhs, const pod64 &rhs) {
+		for (size_t i = 0; i < 8; ++i) {
+			if (lhs.v[i] != rhs.v[i]) {
+				return lhs.v[i] < rhs.v[i];
+			}
+		}
+		return false;
+	}
+
+	// make_value, 第 i 个测试值
+	template <class T>
+	T make_value(size_t i);
+
+	template <>
+	inline int make_value<int>(size_t i) {
+		return static_cast<int>(i * 2654435761u);
+	}
+
+	template <>
+	inline pod64 make_value<pod64>(size_t i) {
+		pod64 p;
+		for (size_t k = 0; k < 8; ++k) {
+			p.v[k] = i * 8 + k;
+		}
+		return p;
+	}
+
+	template <>
+	inline std::string make_value<std::string>(size_t i) {
+		return "wstl-benchmark-value-" + std::to_string(i) + "-padding-past-sso";
+	}
+} // namespace bench
+
+#endif // WSTL_BENCH_BENCH_TYPES_H
@@ -0,0 +1,393 @@
+// wstl_bench 的运行器：参数解析、迭代次数估计、控制台与 JSON 输出。
+//
+// 用法: wstl_bench [--benchmark_filter=正则] [--benchmark_min_time=秒] [--benchmark_format=console|json]
+//                  [--benchmark_out=文件] [--benchmark_list_tests] [--benchmark_perf_counters]
+
+#include "benchmark.h"
+#include "perf_counters.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <regex>
+#include <thread>
+
+namespace bench {
+
+	namespace {
+
+		double real_now() {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		double cpu_now() {
+			timespec ts;
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+			return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+		}
+
+		std::vector<std::unique_ptr<benchmark>> &registry() {
+			static std::vector<std::unique_ptr<benchmark>> benchmarks;
+			return benchmarks;
+		}
+	} // namespace
+
+	/*****************************************************************************************/
+	// state
+
+	state::state(uint64_t iterations, const std::vector<int64_t> &args, perf_counters *perf)
+		: iterations_(iterations), remaining_(iterations), started_(false), running_(false), args_(args), perf_(perf),
+		  real_start_(0), cpu_start_(0), real_seconds_(0), cpu_seconds_(0), items_(0), bytes_(0) {}
+
+	bool state::keep_running_slow() {
+		if (!started_) {
+			started_ = true;
+			resume_timing();
+			if (remaining_ != 0) {
+				--remaining_;
+				return true;
+			}
+		}
+		pause_timing();
+		return false;
+	}
+
+	void state::pause_timing() {
+		if (running_) {
+			// 先停计数器，计数不包含读时钟的开销
+			if (perf_ != nullptr) {
+				perf_->stop();
+			}
+			real_seconds_ += real_now() - real_start_;
+			cpu_seconds_ += cpu_now() - cpu_start_;
+			running_ = false;
+		}
+	}
+
+	void state::resume_timing() {
+		if (!running_) {
+			running_ = true;
+			cpu_start_ = cpu_now();
+			real_start_ = real_now();
+			if (perf_ != nullptr) {
+				perf_->start();
+			}
+		}
+	}
+
+	/*****************************************************************************************/
+	// benchmark
+
+	benchmark::benchmark(const std::string &name, function fn) : name_(name), fn_(fn) {}
+
+	benchmark *benchmark::arg(int64_t a) {
+		arg_sets_.push_back(std::vector<int64_t>(1, a));
+		return this;
+	}
+
+	benchmark *benchmark::args(std::initializer_list<int64_t> a) {
+		arg_sets_.push_back(std::vector<int64_t>(a));
+		return this;
+	}
+
+	benchmark *benchmark::range(int64_t lo, int64_t hi, int64_t multiplier) {
+		for (auto a = lo; a < hi; a *= multiplier) {
+			arg(a);
+		}
+		return arg(hi);
+	}
+
+	benchmark *register_benchmark(const std::string &name, function fn) {
+		registry().emplace_back(new benchmark(name, fn));
+		return registry().back().get();
+	}
+
+	const std::vector<std::unique_ptr<benchmark>> &registered_benchmarks() {
+		return registry();
+	}
+
+	/*****************************************************************************************/
+	// 运行与输出
+
+	namespace {
+
+		struct run_result {
+			std::string name;
+			uint64_t iterations;
+			double real_ns; // 每次迭代
+			double cpu_ns;
+			double items_per_second;
+			double bytes_per_second;
+			std::string label;
+			std::vector<std::pair<std::string, double>> counters; // 每次迭代的硬件计数
+		};
+
+		struct options {
+			std::string filter = ".";
+			double min_time = 0.1;
+			bool json = false;
+			std::string out;
+			bool list = false;
+			bool perf = false;
+		};
+
+		std::string run_name(const benchmark &b, const std::vector<int64_t> &args) {
+			auto name = b.name();
+			for (auto a : args) {
+				name += "/" + std::to_string(a);
+			}
+			return name;
+		}
+
+		// count_one, 以相同的迭代次数再运行一轮，读取硬件计数
+		void count_one(const benchmark &b, const std::vector<int64_t> &args, perf_counters &perf, run_result &r) {
+			perf.reset();
+			state s(r.iterations, args, &perf);
+			b.fn()(s);
+			for (size_t i = 0; i < perf.size(); ++i) {
+				r.counters.emplace_back(perf.name(i), perf.value(i) / static_cast<double>(r.iterations));
+			}
+		}
+
+		// run_one, 与 Google Benchmark 相同的策略：每轮按上一轮耗时预测达到 min_time 所需的迭代次数
+		run_result run_one(const benchmark &b, const std::vector<int64_t> &args, double min_time, perf_counters *perf) {
+			const uint64_t max_iterations = 1000000000;
+			uint64_t iterations = 1;
+			for (;;) {
+				state s(iterations, args);
+				b.fn()(s);
+				const auto elapsed = s.real_seconds();
+				if (elapsed >= min_time || iterations >= max_iterations) {
+					run_result r;
+					r.name = run_name(b, args);
+					r.iterations = iterations;
+					r.real_ns = elapsed * 1e9 / static_cast<double>(iterations);
+					r.cpu_ns = s.cpu_seconds() * 1e9 / static_cast<double>(iterations);
+					r.items_per_second = elapsed > 0 ? static_cast<double>(s.items_processed()) / elapsed : 0;
+					r.bytes_per_second = elapsed > 0 ? static_cast<double>(s.bytes_processed()) / elapsed : 0;
+					r.label = s.label();
+					if (perf != nullptr && perf->available()) {
+						count_one(b, args, *perf, r);
+					}
+					return r;
+				}
+				double multiplier = elapsed > 0 ? min_time * 1.4 / elapsed : 10.0;
+				if (elapsed <= min_time * 0.1) {
+					multiplier = std::min(multiplier, 10.0);
+				}
+				auto next = static_cast<uint64_t>(static_cast<double>(iterations) * std::max(multiplier, 1.0));
+				iterations = std::min(std::max(next, iterations + 1), max_iterations);
+			}
+		}
+
+		std::string human_number(double value, const char *suffix) {
+			static const char *const prefixes[] = {"", "k", "M", "G", "T"};
+			size_t i = 0;
+			while (value >= 1000 && i + 1 < sizeof(prefixes) / sizeof(prefixes[0])) {
+				value /= 1000;
+				++i;
+			}
+			char buf[64];
+			std::snprintf(buf, sizeof(buf), "%.3g%s%s", value, prefixes[i], suffix);
+			return buf;
+		}
+
+		void print_console_header(std::FILE *out, size_t width) {
+			std::fprintf(out, "%-*s %14s %14s %12s  %s\n", static_cast<int>(width), "Benchmark", "Time", "CPU",
+						 "Iterations", "Rate");
+			std::fprintf(out, "%s\n", std::string(width + 60, '-').c_str());
+		}
+
+		void print_console(std::FILE *out, const run_result &r, size_t width) {
+			std::string rate;
+			if (r.items_per_second > 0) {
+				rate += "items=" + human_number(r.items_per_second, "/s");
+			}
+			if (r.bytes_per_second > 0) {
+				rate += (rate.empty() ? "" : " ") + std::string("bytes=") + human_number(r.bytes_per_second, "B/s");
+			}
+			for (const auto &c : r.counters) {
+				rate += (rate.empty() ? "" : " ") + c.first + "=" + human_number(c.second, "");
+			}
+			if (!r.label.empty()) {
+				rate += (rate.empty() ? "" : " ") + r.label;
+			}
+			std::fprintf(out, "%-*s %11.1f ns %11.1f ns %12llu  %s\n", static_cast<int>(width), r.name.c_str(), r.real_ns,
+						 r.cpu_ns, static_cast<unsigned long long>(r.iterations), rate.c_str());
+			std::fflush(out);
+		}
+
+		std::string json_escape(const std::string &s) {
+			std::string result;
+			for (auto c : s) {
+				switch (c) {
+				case '"':
+					result += "\\\"";
+					break;
+				case '\\':
+					result += "\\\\";
+					break;
+				case '\n':
+					result += "\\n";
+					break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						char buf[8];
+						std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+						result += buf;
+					} else {
+						result += c;
+					}
+				}
+			}
+			return result;
+		}
+
+		void print_json(std::FILE *out, const std::vector<run_result> &results, const char *executable) {
+			char host[256] = "unknown";
+			gethostname(host, sizeof(host) - 1);
+			char date[64];
+			const auto now = std::time(nullptr);
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+			std::fprintf(out, "{\n  \"context\": {\n");
+			std::fprintf(out, "    \"date\": \"%s\",\n", date);
+			std::fprintf(out, "    \"host_name\": \"%s\",\n", json_escape(host).c_str());
+			std::fprintf(out, "    \"executable\": \"%s\",\n", json_escape(executable).c_str());
+			std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+			std::fprintf(out, "    \"library_build_type\": \"release\"\n");
+#else
+			std::fprintf(out, "    \"library_build_type\": \"debug\"\n");
+#endif
+			std::fprintf(out, "  },\n  \"benchmarks\": [\n");
+			for (size_t i = 0; i < results.size(); ++i) {
+				const auto &r = results[i];
+				std::fprintf(out, "    {\n");
+				std::fprintf(out, "      \"name\": \"%s\",\n", json_escape(r.name).c_str());
+				std::fprintf(out, "      \"run_name\": \"%s\",\n", json_escape(r.name).c_str());
+				std::fprintf(out, "      \"run_type\": \"iteration\",\n");
+				std::fprintf(out, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(r.iterations));
+				std::fprintf(out, "      \"real_time\": %.6g,\n", r.real_ns);
+				std::fprintf(out, "      \"cpu_time\": %.6g,\n", r.cpu_ns);
+				std::fprintf(out, "      \"time_unit\": \"ns\"");
+				if (r.items_per_second > 0) {
+					std::fprintf(out, ",\n      \"items_per_second\": %.6g", r.items_per_second);
+				}
+				if (r.bytes_per_second > 0) {
+					std::fprintf(out, ",\n      \"bytes_per_second\": %.6g", r.bytes_per_second);
+				}
+				for (const auto &c : r.counters) {
+					std::fprintf(out, ",\n      \"%s\": %.6g", c.first.c_str(), c.second);
+				}
+				if (!r.label.empty()) {
+					std::fprintf(out, ",\n      \"label\": \"%s\"", json_escape(r.label).c_str());
+				}
+				std::fprintf(out, "\n    }%s\n", i + 1 < results.size() ? "," : "");
+			}
+			std::fprintf(out, "  ]\n}\n");
+		}
+
+		bool parse_flag(const char *arg, const char *name, std::string &value) {
+			const auto len = std::strlen(name);
+			if (std::strncmp(arg, name, len) == 0 && arg[len] == '=') {
+				value = arg + len + 1;
+				return true;
+			}
+			return false;
+		}
+
+		options parse_options(int argc, char **argv) {
+			options opts;
+			for (int i = 1; i < argc; ++i) {
+				std::string value;
+				if (parse_flag(argv[i], "--benchmark_filter", value)) {
+					opts.filter = value;
+				} else if (parse_flag(argv[i], "--benchmark_min_time", value)) {
+					opts.min_time = std::strtod(value.c_str(), nullptr);
+				} else if (parse_flag(argv[i], "--benchmark_format", value)) {
+					opts.json = value == "json";
+				} else if (parse_flag(argv[i], "--benchmark_out", value)) {
+					opts.out = value;
+				} else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) {
+					opts.list = true;
+				} else if (std::strcmp(argv[i], "--benchmark_perf_counters") == 0) {
+					opts.perf = true;
+				} else {
+					std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+					std::exit(2);
+				}
+			}
+			return opts;
+		}
+	} // namespace
+} // namespace bench
+
+int main(int argc, char **argv) {
+	const auto opts = bench::parse_options(argc, argv);
+	const std::regex filter(opts.filter);
+
+	// 展开参数组并按过滤条件筛选
+	std::vector<std::pair<const bench::benchmark *, std::vector<int64_t>>> runs;
+	size_t width = 10;
+	for (const auto &b : bench::registered_benchmarks()) {
+		auto arg_sets = b->arg_sets();
+		if (arg_sets.empty()) {
+			arg_sets.push_back(std::vector<int64_t>());
+		}
+		for (const auto &args : arg_sets) {
+			const auto name = bench::run_name(*b, args);
+			if (std::regex_search(name, filter)) {
+				runs.emplace_back(b.get(), args);
+				width = std::max(width, name.size());
+			}
+		}
+	}
+
+	if (opts.list) {
+		for (const auto &run : runs) {
+			std::printf("%s\n", bench::run_name(*run.first, run.second).c_str());
+		}
+		return 0;
+	}
+
+	// 计数器不可用时（例如容器内）给出原因，基准照常运行
+	std::unique_ptr<bench::perf_counters> perf;
+	if (opts.perf) {
+		perf.reset(new bench::perf_counters());
+		if (!perf->errors().empty()) {
+			std::fprintf(stderr, "perf counters unavailable: %s\n", perf->errors().c_str());
+		}
+	}
+
+	// --benchmark_format=json 时控制台输出 JSON，否则输出表格
+	if (!opts.json) {
+		bench::print_console_header(stdout, width);
+	}
+	std::vector<bench::run_result> results;
+	for (const auto &run : runs) {
+		results.push_back(bench::run_one(*run.first, run.second, opts.min_time, perf.get()));
+		if (!opts.json) {
+			bench::print_console(stdout, results.back(), width);
+		}
+	}
+	if (opts.json) {
+		bench::print_json(stdout, results, argv[0]);
+	}
+	if (!opts.out.empty()) {
+		auto out = std::fopen(opts.out.c_str(), "w");
+		if (out == nullptr) {
+			std::perror(opts.out.c_str());
+			return 1;
+		}
+		bench::print_json(out, results, argv[0]);
+		std::fclose(out);
+	}
+	return 0;
+}
@@ -0,0 +1,168 @@
+// wstl_bench 使用的微基准框架，接口仿照 Google Benchmark：
+//
+//   static void bm_xxx(bench::state &state) {
+//       准备数据（不计时）;
+//       while (state.keep_running()) {
+//           被测代码;
+//       }
+//       state.set_items_processed(state.iterations() * n);
+//   }
+//   WSTL_BENCHMARK(bm_xxx)->arg(16)->arg(1024);
+//
+// 每组参数单独运行一次，迭代次数自动增加，直到计时不少于 --benchmark_min_time 秒。
+// 结果输出为控制台表格，或与 Google Benchmark 兼容的 JSON（--benchmark_format=json、--benchmark_out=文件），
+// 可以直接用 Google Benchmark 的 compare.py 比较两次运行。
+// 指定 --benchmark_perf_counters 时，每组参数计时结束后再以相同的迭代次数运行一轮，
+// 用硬件计数器（见 perf_counters.h）统计每次迭代的 cycles、instructions、缓存 / 分支 / dTLB 缺失，计时结果不受影响。
+
+#ifndef WSTL_BENCH_BENCHMARK_H
+#define WSTL_BENCH_BENCHMARK_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+	class perf_counters;
+
+	// state, 一次运行的迭代控制与计时
+	class state {
+	public:
+		state(uint64_t iterations, const std::vector<int64_t> &args, perf_counters *perf = nullptr);
+
+		// 第一次调用时开始计时，迭代次数用完时停止计时并返回 false
+		bool keep_running() {
+			if (remaining_ != 0 && started_) {
+				--remaining_;
+				return true;
+			}
+			return keep_running_slow();
+		}
+
+		// 暂停 / 恢复计时，用于在迭代之间重建被测数据
+		void pause_timing();
+		void resume_timing();
+
+		uint64_t iterations() const {
+			return iterations_;
+		}
+
+		int64_t range(size_t i = 0) const {
+			return args_[i];
+		}
+
+		void set_items_processed(uint64_t items) {
+			items_ = items;
+		}
+
+		void set_bytes_processed(uint64_t bytes) {
+			bytes_ = bytes;
+		}
+
+		void set_label(const std::string &label) {
+			label_ = label;
+		}
+
+		// 以下供运行器读取
+		double real_seconds() const {
+			return real_seconds_;
+		}
+
+		double cpu_seconds() const {
+			return cpu_seconds_;
+		}
+
+		uint64_t items_processed() const {
+			return items_;
+		}
+
+		uint64_t bytes_processed() const {
+			return bytes_;
+		}
+
+		const std::string &label() const {
+			return label_;
+		}
+
+	private:
+		bool keep_running_slow();
+
+	private:
+		uint64_t iterations_;
+		uint64_t remaining_;
+		bool started_;
+		bool running_;
+		std::vector<int64_t> args_;
+		perf_counters *perf_;
+		double real_start_;
+		double cpu_start_;
+		double real_seconds_;
+		double cpu_seconds_;
+		uint64_t items_;
+		uint64_t bytes_;
+		std::string label_;
+	};
+
+	// do_not_optimize, 阻止编译器删除结果未被使用的计算
+	template <class T>
+	inline void do_not_optimize(const T &value) {
+		asm volatile("" : : "r"(&value) : "memory");
+	}
+
+	// clobber_memory, 强制之前的写入真正落到内存
+	inline void clobber_memory() {
+		asm volatile("" : : : "memory");
+	}
+
+	typedef void (*function)(state &);
+
+	// benchmark, 一个已注册的基准及其参数组
+	class benchmark {
+	public:
+		benchmark(const std::string &name, function fn);
+
+		benchmark *arg(int64_t a);
+		benchmark *args(std::initializer_list<int64_t> a);
+
+		// range, 依次添加 lo, lo * multiplier, ...，最后一个参数为 hi
+		benchmark *range(int64_t lo, int64_t hi, int64_t multiplier = 8);
+
+		const std::string &name() const {
+			return name_;
+		}
+
+		function fn() const {
+			return fn_;
+		}
+
+		const std::vector<std::vector<int64_t>> &arg_sets() const {
+			return arg_sets_;
+		}
+
+	private:
+		std::string name_;
+		function fn_;
+		std::vector<std::vector<int64_t>> arg_sets_;
+	};
+
+	benchmark *register_benchmark(const std::string &name, function fn);
+
+	const std::vector<std::unique_ptr<benchmark>> &registered_benchmarks();
+} // namespace bench
+
+#define WSTL_BENCH_CONCAT_(a, b) a##b
+#define WSTL_BENCH_CONCAT(a, b) WSTL_BENCH_CONCAT_(a, b)
+
+#define WSTL_BENCHMARK(fn)                                                                                \
+	static ::bench::benchmark *WSTL_BENCH_CONCAT(bench_registration_, __COUNTER__) __attribute__((unused)) = \
+		::bench::register_benchmark(#fn, fn)
+
+// 模板参数中的逗号由 __VA_ARGS__ 吸收
+#define WSTL_BENCHMARK_TEMPLATE(fn, ...)                                                                  \
+	static ::bench::benchmark *WSTL_BENCH_CONCAT(bench_registration_, __COUNTER__) __attribute__((unused)) = \
+		::bench::register_benchmark(#fn "<" #__VA_ARGS__ ">", fn<__VA_ARGS__>)
+
+#endif // WSTL_BENCH_BENCHMARK_H
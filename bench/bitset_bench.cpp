@@ -0,0 +1,58 @@
+// bitset.h 的微基准：稀疏集合的遍历与两个集合求交，对比 dynamic_bitset 与带摘要的 hierarchical_bitset。
+// 名字形如 bm_iterate_sparse<wstl::hierarchical_bitset<>>/16777216，参数是位数，每 4096 位中有一个 1。
+
+#include <cstdint>
+
+#include "benchmark.h"
+#include "bitset.h"
+
+namespace {
+
+	typedef wstl::dynamic_bitset<> flat_bitset;
+	typedef wstl::hierarchical_bitset<> summary_bitset;
+
+	constexpr size_t sparse_stride = 4096;
+
+	// 每 stride 位置一个 1
+	template <class Bitset>
+	void fill_sparse(Bitset &b, size_t n, size_t stride) {
+		for (size_t i = 0; i < n; i += stride) {
+			b.set(i);
+		}
+	}
+
+	template <class Bitset>
+	void bm_iterate_sparse(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		Bitset b(n);
+		fill_sparse(b, n, sparse_stride);
+		while (state.keep_running()) {
+			size_t sum = 0;
+			for (auto i = b.find_first(); i < b.size(); i = b.find_next(i)) {
+				sum += i;
+			}
+			bench::do_not_optimize(sum);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Bitset>
+	void bm_intersect(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		Bitset a(n);
+		Bitset b(n);
+		fill_sparse(a, n, sparse_stride);
+		fill_sparse(b, n, sparse_stride * 2);
+		while (state.keep_running()) {
+			Bitset c(a);
+			c &= b;
+			bench::do_not_optimize(c.count());
+		}
+		state.set_bytes_processed(state.iterations() * (n / 8) * 2);
+	}
+
+	WSTL_BENCHMARK_TEMPLATE(bm_iterate_sparse, flat_bitset)->range(16, 1 << 24, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_iterate_sparse, summary_bitset)->range(16, 1 << 24, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_intersect, flat_bitset)->range(16, 1 << 24, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_intersect, summary_bitset)->range(16, 1 << 24, 64);
+} // namespace
@@ -0,0 +1,130 @@
+// concurrent_hash_map 读写混合基准：不同线程数与读比例下的吞吐量，
+// 与单把 std::mutex 保护的 std::unordered_map 对比。
+//
+// 用法: concurrent_hash_map_bench [每个线程的操作数] [键空间大小] [最大线程数]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "concurrent_hash_map.h"
+#include "vector.h"
+
+namespace {
+
+	// 对照组：一把互斥锁保护整张表
+	class locked_map {
+	public:
+		bool find(size_t key, size_t &out) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = map_.find(key);
+			if (it == map_.end()) {
+				return false;
+			}
+			out = it->second;
+			return true;
+		}
+
+		void upsert(size_t key) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			++map_[key];
+		}
+
+		void erase(size_t key) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			map_.erase(key);
+		}
+
+	private:
+		std::unordered_map<size_t, size_t> map_;
+		std::mutex mutex_;
+	};
+
+	// 对 wstl::concurrent_hash_map 的薄包装，统一接口
+	class striped_map {
+	public:
+		bool find(size_t key, size_t &out) {
+			return map_.find(key, out);
+		}
+
+		void upsert(size_t key) {
+			map_.upsert(key, [](size_t &v) { ++v; }, static_cast<size_t>(1));
+		}
+
+		void erase(size_t key) {
+			map_.erase(key);
+		}
+
+	private:
+		wstl::concurrent_hash_map<size_t, size_t> map_{256};
+	};
+
+	// xorshift 伪随机数，避免基准被随机数生成器主导
+	inline size_t next_random(size_t &state) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+
+	// 运行一轮：写操作一半 upsert 一半 erase，返回每秒操作数
+	template <class Map>
+	double run(Map &map, unsigned threads, size_t ops, size_t keys, unsigned read_percent) {
+		for (size_t k = 0; k < keys; k += 2) {
+			map.upsert(k);
+		}
+		std::atomic<size_t> hits(0);
+		wstl::vector<std::thread> workers;
+		const auto start = std::chrono::steady_clock::now();
+		for (unsigned t = 0; t < threads; ++t) {
+			workers.emplace_back([&, t] {
+				size_t state = 0x9E3779B97F4A7C15ULL * (t + 1);
+				size_t found = 0;
+				size_t value = 0;
+				for (size_t i = 0; i < ops; ++i) {
+					const auto r = next_random(state);
+					const auto key = (r >> 8) % keys;
+					const auto dice = static_cast<unsigned>(r % 100);
+					if (dice < read_percent) {
+						found += map.find(key, value) ? 1 : 0;
+					} else if (dice & 1) {
+						map.upsert(key);
+					} else {
+						map.erase(key);
+					}
+				}
+				hits.fetch_add(found, std::memory_order_relaxed);
+			});
+		}
+		for (auto &w : workers) {
+			w.join();
+		}
+		const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return static_cast<double>(ops) * threads / elapsed;
+	}
+}
+
+int main(int argc, char **argv) {
+	const size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const size_t keys = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1 << 20;
+	const unsigned max_threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 64;
+
+	std::printf("hardware threads: %u, keys: %zu, ops/thread: %zu\n", std::thread::hardware_concurrency(), keys, ops);
+	std::printf("%8s %8s %20s %20s %8s\n", "read%", "threads", "striped ops/s", "mutex ops/s", "speedup");
+
+	const unsigned read_percents[] = {100, 90, 50};
+	for (auto read_percent : read_percents) {
+		for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+			striped_map striped;
+			locked_map locked;
+			const auto a = run(striped, threads, ops, keys, read_percent);
+			const auto b = run(locked, threads, ops, keys, read_percent);
+			std::printf("%8u %8u %20.0f %20.0f %7.2fx\n", read_percent, threads, a, b, a / b);
+		}
+	}
+	return 0;
+}
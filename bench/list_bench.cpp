@@ -0,0 +1,59 @@
+// list 的微基准：队列式的插入 / 删除（节点逐个分配与释放）以及 sort，
+// 对比 wstl::allocator、pool_allocator 与 std::list。参数是链表长度。
+
+#include <cstdint>
+#include <list>
+
+#include "benchmark.h"
+#include "list.h"
+#include "pool_allocator.h"
+
+namespace {
+
+	typedef wstl::list<uint64_t> plain_list;
+	typedef wstl::list<uint64_t, wstl::pool_allocator<uint64_t>> pooled_list;
+	typedef std::list<uint64_t> std_list;
+
+	// 保持长度 n 不变，每次迭代从头部删除一个、在尾部插入一个
+	template <class List>
+	void bm_churn(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		List l;
+		for (size_t i = 0; i < n; ++i) {
+			l.push_back(i);
+		}
+		uint64_t next = n;
+		while (state.keep_running()) {
+			l.pop_front();
+			l.push_back(next++);
+		}
+		bench::do_not_optimize(l.back());
+		state.set_items_processed(state.iterations());
+	}
+
+	template <class List>
+	void bm_sort(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		List l;
+		uint64_t x = 88172645463325252ull;
+		for (size_t i = 0; i < n; ++i) {
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+			l.push_back(x);
+		}
+		while (state.keep_running()) {
+			l.sort();
+			state.pause_timing();
+			l.reverse();
+			state.resume_timing();
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	WSTL_BENCHMARK_TEMPLATE(bm_churn, plain_list)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_churn, pooled_list)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_churn, std_list)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_sort, pooled_list)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_sort, std_list)->range(16, 1 << 16, 64);
+} // namespace
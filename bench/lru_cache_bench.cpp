@@ -0,0 +1,111 @@
+// lru_cache / clock_cache 的微基准：命中路径的 get 与淘汰路径的 put，
+// 对比常见的 std::list + std::unordered_map 实现。参数是缓存的条目数，缓存在计时前已装满。
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "lru_cache.h"
+
+namespace {
+
+	typedef wstl::lru_cache<uint64_t, uint64_t> lru;
+	typedef wstl::clock_cache<uint64_t, uint64_t> clock;
+
+	// 基准对照：链表记录最近使用顺序，哈希表保存链表迭代器
+	class std_lru {
+	public:
+		explicit std_lru(size_t capacity) : capacity_(capacity) {
+			index_.reserve(capacity);
+		}
+
+		uint64_t *get(uint64_t key) {
+			auto it = index_.find(key);
+			if (it == index_.end()) {
+				return nullptr;
+			}
+			order_.splice(order_.begin(), order_, it->second);
+			return &it->second->second;
+		}
+
+		uint64_t *put(uint64_t key, uint64_t value) {
+			auto it = index_.find(key);
+			if (it != index_.end()) {
+				it->second->second = value;
+				order_.splice(order_.begin(), order_, it->second);
+				return &it->second->second;
+			}
+			if (order_.size() == capacity_) {
+				index_.erase(order_.back().first);
+				order_.pop_back();
+			}
+			order_.emplace_front(key, value);
+			index_[key] = order_.begin();
+			return &order_.front().second;
+		}
+
+	private:
+		size_t capacity_;
+		std::list<std::pair<uint64_t, uint64_t>> order_;
+		std::unordered_map<uint64_t, std::list<std::pair<uint64_t, uint64_t>>::iterator> index_;
+	};
+
+	// 打乱顺序的键，避免按插入顺序访问时的预取优势
+	std::vector<uint64_t> shuffled_keys(size_t n, uint64_t base) {
+		std::vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; ++i) {
+			keys[i] = base + i * 0x9E3779B97F4A7C15ull;
+		}
+		uint64_t x = 88172645463325252ull;
+		for (size_t i = n; i > 1; --i) {
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+			std::swap(keys[i - 1], keys[x % i]);
+		}
+		return keys;
+	}
+
+	template <class Cache>
+	void bm_get_hit(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		Cache cache(n);
+		const auto keys = shuffled_keys(n, 1);
+		for (auto key : keys) {
+			cache.put(key, key);
+		}
+		size_t i = 0;
+		while (state.keep_running()) {
+			bench::do_not_optimize(cache.get(keys[i]));
+			if (++i == n) {
+				i = 0;
+			}
+		}
+		state.set_items_processed(state.iterations());
+	}
+
+	// 每次 put 一个新键，总要淘汰一个条目
+	template <class Cache>
+	void bm_put_evict(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		Cache cache(n);
+		for (auto key : shuffled_keys(n, 1)) {
+			cache.put(key, key);
+		}
+		uint64_t next = uint64_t(1) << 62;
+		while (state.keep_running()) {
+			bench::do_not_optimize(cache.put(next, next));
+			++next;
+		}
+		state.set_items_processed(state.iterations());
+	}
+
+	WSTL_BENCHMARK_TEMPLATE(bm_get_hit, lru)->range(16, 1 << 20, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_get_hit, clock)->range(16, 1 << 20, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_get_hit, std_lru)->range(16, 1 << 20, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_put_evict, lru)->range(16, 1 << 20, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_put_evict, clock)->range(16, 1 << 20, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_put_evict, std_lru)->range(16, 1 << 20, 64);
+} // namespace
@@ -0,0 +1,144 @@
+// 智能指针的微基准：拷贝（引用计数的增减）与创建（make_shared 一次分配 / 由指针构造两次分配），
+// 对比 wstl::shared_ptr、local_shared_ptr 与 std::shared_ptr。参数是每轮拷贝或创建的指针数。
+// 临时缓冲区：每轮申请 n 个 uint64_t 的临时空间、写一遍再归还，对比 temporary_buffer 与每次 operator new。
+// 注意 libstdc++ 在程序没有启动过线程时使用非原子计数，此时 std::shared_ptr 应与 local_shared_ptr 比较。
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark.h"
+#include "memory.h"
+
+namespace {
+
+	struct wstl_shared {
+		typedef wstl::shared_ptr<uint64_t> pointer;
+
+		static pointer make(uint64_t v) {
+			return wstl::make_shared<uint64_t>(v);
+		}
+
+		static pointer from_new(uint64_t v) {
+			return pointer(new uint64_t(v));
+		}
+	};
+
+	struct wstl_local {
+		typedef wstl::local_shared_ptr<uint64_t> pointer;
+
+		static pointer make(uint64_t v) {
+			return wstl::make_local_shared<uint64_t>(v);
+		}
+
+		static pointer from_new(uint64_t v) {
+			return pointer(new uint64_t(v));
+		}
+	};
+
+	struct std_shared {
+		typedef std::shared_ptr<uint64_t> pointer;
+
+		static pointer make(uint64_t v) {
+			return std::make_shared<uint64_t>(v);
+		}
+
+		static pointer from_new(uint64_t v) {
+			return pointer(new uint64_t(v));
+		}
+	};
+
+	// 把 n 个指针拷贝到另一个数组再清空：每个指针一次加一、一次减一
+	template <class Ptr>
+	void bm_copy(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		std::vector<typename Ptr::pointer> src, dst;
+		for (size_t i = 0; i < n; ++i) {
+			src.push_back(Ptr::make(i));
+		}
+		dst.reserve(n);
+		while (state.keep_running()) {
+			for (size_t i = 0; i < n; ++i) {
+				dst.push_back(src[i]);
+			}
+			bench::do_not_optimize(dst.data());
+			dst.clear();
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Ptr>
+	void bm_make(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		std::vector<typename Ptr::pointer> v;
+		v.reserve(n);
+		while (state.keep_running()) {
+			for (size_t i = 0; i < n; ++i) {
+				v.push_back(Ptr::make(i));
+			}
+			bench::do_not_optimize(v.data());
+			v.clear();
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Ptr>
+	void bm_from_new(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		std::vector<typename Ptr::pointer> v;
+		v.reserve(n);
+		while (state.keep_running()) {
+			for (size_t i = 0; i < n; ++i) {
+				v.push_back(Ptr::from_new(i));
+			}
+			bench::do_not_optimize(v.data());
+			v.clear();
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	struct arena_scratch {
+		static uint64_t *get(size_t n) {
+			return wstl::get_temporary_buffer<uint64_t>(static_cast<ptrdiff_t>(n)).first;
+		}
+
+		static void put(uint64_t *p) {
+			wstl::return_temporary_buffer(p);
+		}
+	};
+
+	struct heap_scratch {
+		static uint64_t *get(size_t n) {
+			return static_cast<uint64_t *>(::operator new(n * sizeof(uint64_t)));
+		}
+
+		static void put(uint64_t *p) {
+			::operator delete(p);
+		}
+	};
+
+	template <class Scratch>
+	void bm_scratch(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		while (state.keep_running()) {
+			uint64_t *p = Scratch::get(n);
+			for (size_t i = 0; i < n; ++i) {
+				p[i] = i;
+			}
+			bench::do_not_optimize(p[n - 1]);
+			Scratch::put(p);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	WSTL_BENCHMARK_TEMPLATE(bm_copy, wstl_shared)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_copy, wstl_local)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_copy, std_shared)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_make, wstl_shared)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_make, wstl_local)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_make, std_shared)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_from_new, wstl_shared)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_from_new, std_shared)->range(16, 1 << 16, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_scratch, arena_scratch)->range(16, 1 << 17, 64);
+	WSTL_BENCHMARK_TEMPLATE(bm_scratch, heap_scratch)->range(16, 1 << 17, 64);
+} // namespace
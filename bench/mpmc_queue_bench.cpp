@@ -0,0 +1,109 @@
+// mpmc_queue 竞争基准：N 个生产者 / M 个消费者通过阻塞接口收发整数，
+// 与 std::mutex + std::condition_variable 保护的有界 std::deque 对比吞吐量。
+//
+// 用法: mpmc_queue_bench [每个生产者的操作数] [消费者数量] [队列容量]
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "mpmc_queue.h"
+#include "vector.h"
+
+namespace {
+
+	// 对照组：单把互斥锁保护的有界队列
+	class locked_queue {
+	public:
+		explicit locked_queue(size_t capacity) : capacity_(capacity) {}
+
+		void push(size_t value) {
+			std::unique_lock<std::mutex> lock(mutex_);
+			not_full_.wait(lock, [this] { return queue_.size() < capacity_; });
+			queue_.push_back(value);
+			not_empty_.notify_one();
+		}
+
+		void pop(size_t &out) {
+			std::unique_lock<std::mutex> lock(mutex_);
+			not_empty_.wait(lock, [this] { return !queue_.empty(); });
+			out = queue_.front();
+			queue_.pop_front();
+			not_full_.notify_one();
+		}
+
+	private:
+		size_t capacity_;
+		std::deque<size_t> queue_;
+		std::mutex mutex_;
+		std::condition_variable not_full_;
+		std::condition_variable not_empty_;
+	};
+
+	// 运行一轮：返回每秒操作数，并校验所有元素恰好被消费一次
+	template <class Queue>
+	double run(Queue &queue, unsigned producers, unsigned consumers, size_t ops_per_producer) {
+		const size_t total = ops_per_producer * producers;
+		wstl::vector<std::thread> threads;
+		wstl::vector<size_t> sums(consumers, 0);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (unsigned p = 0; p < producers; ++p) {
+			threads.emplace_back([&queue, ops_per_producer] {
+				for (size_t i = 1; i <= ops_per_producer; ++i) {
+					queue.push(i);
+				}
+			});
+		}
+		for (unsigned c = 0; c < consumers; ++c) {
+			const size_t quota = total / consumers + (c < total % consumers ? 1 : 0);
+			threads.emplace_back([&queue, &sums, c, quota] {
+				size_t value = 0;
+				size_t sum = 0;
+				for (size_t i = 0; i < quota; ++i) {
+					queue.pop(value);
+					sum += value;
+				}
+				sums[c] = sum;
+			});
+		}
+		for (auto &t : threads) {
+			t.join();
+		}
+		const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		size_t sum = 0;
+		for (auto s : sums) {
+			sum += s;
+		}
+		if (sum != producers * (ops_per_producer * (ops_per_producer + 1) / 2)) {
+			std::fprintf(stderr, "checksum mismatch\n");
+			std::exit(1);
+		}
+		return static_cast<double>(total) / elapsed;
+	}
+}
+
+int main(int argc, char **argv) {
+	const size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+	const unsigned consumers = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 4;
+	const size_t capacity = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1024;
+
+	std::printf("hardware threads: %u, consumers: %u, capacity: %zu, ops/producer: %zu\n",
+				std::thread::hardware_concurrency(), consumers, capacity, ops);
+	std::printf("%10s %18s %18s %8s\n", "producers", "mpmc_queue ops/s", "mutex+deque ops/s", "speedup");
+
+	const unsigned producer_counts[] = {1, 2, 4, 8, 16, 32};
+	for (auto producers : producer_counts) {
+		wstl::mpmc_queue<size_t> lock_free(capacity);
+		locked_queue locked(capacity);
+		const auto a = run(lock_free, producers, consumers, ops);
+		const auto b = run(locked, producers, consumers, ops);
+		std::printf("%10u %18.0f %18.0f %7.2fx\n", producers, a, b, a / b);
+	}
+	return 0;
+}
@@ -0,0 +1,115 @@
+// perf_counters 的实现，非 Linux 平台上所有计数器都不可用。
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+namespace bench {
+
+	constexpr size_t perf_counters::max_counters;
+
+#ifdef __linux__
+
+	namespace {
+
+		struct event_desc {
+			const char *name;
+			uint32_t type;
+			uint64_t config;
+		};
+
+		const event_desc events[perf_counters::max_counters] = {
+			{"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+			{"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+			{"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+			{"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+			{"dtlb_misses", PERF_TYPE_HW_CACHE,
+			 PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+		};
+
+		int open_event(const event_desc &e) {
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = e.type;
+			attr.config = e.config;
+			attr.exclude_kernel = 1; // perf_event_paranoid = 2 时只允许统计用户态
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+		}
+	} // namespace
+
+	perf_counters::perf_counters() : size_(0) {
+		for (const auto &e : events) {
+			const int fd = open_event(e);
+			if (fd < 0) {
+				errors_ += std::string(errors_.empty() ? "" : ", ") + e.name + ": " + std::strerror(errno);
+				continue;
+			}
+			fds_[size_] = fd;
+			names_[size_] = e.name;
+			++size_;
+		}
+		reset();
+	}
+
+	perf_counters::~perf_counters() {
+		for (size_t i = 0; i < size_; ++i) {
+			::close(fds_[i]);
+		}
+	}
+
+	bool perf_counters::read_sample(size_t i, sample &s) const {
+		return ::read(fds_[i], &s, sizeof(s)) == static_cast<ssize_t>(sizeof(s));
+	}
+
+#else
+
+	perf_counters::perf_counters() : size_(0), errors_("perf_event_open is only available on Linux") {
+		reset();
+	}
+
+	perf_counters::~perf_counters() {}
+
+	bool perf_counters::read_sample(size_t, sample &) const {
+		return false;
+	}
+
+#endif
+
+	void perf_counters::start() {
+		for (size_t i = 0; i < size_; ++i) {
+			if (!read_sample(i, start_[i])) {
+				start_[i].value = start_[i].enabled = start_[i].running = 0;
+			}
+		}
+	}
+
+	void perf_counters::stop() {
+		for (size_t i = 0; i < size_; ++i) {
+			sample end;
+			if (!read_sample(i, end)) {
+				continue;
+			}
+			const auto value = static_cast<double>(end.value - start_[i].value);
+			const auto enabled = end.enabled - start_[i].enabled;
+			const auto running = end.running - start_[i].running;
+			// 被复用时只统计了 running / enabled 的时间，按比例折算
+			totals_[i] += running != 0 && running < enabled ? value * static_cast<double>(enabled) / running : value;
+		}
+	}
+
+	void perf_counters::reset() {
+		for (size_t i = 0; i < max_counters; ++i) {
+			totals_[i] = 0;
+		}
+	}
+} // namespace bench
@@ -0,0 +1,74 @@
+// wstl_bench 的硬件性能计数器（Linux perf_event_open）。
+//
+// 统计用户态的 cycles、instructions、cache-misses、branch-misses 与 dTLB 读缺失，每个计数器单独打开：
+// 虚拟机或容器里常常只有部分事件可用（或者 perf_event_paranoid 禁止访问），打不开的计数器被跳过，
+// 全部打不开时 available() 为 false，基准照常运行，只是不输出计数。
+// 计数器被复用（multiplexing）时按 time_enabled / time_running 折算。
+
+#ifndef WSTL_BENCH_PERF_COUNTERS_H
+#define WSTL_BENCH_PERF_COUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bench {
+
+	class perf_counters {
+	public:
+		static constexpr size_t max_counters = 5;
+
+		perf_counters();
+		~perf_counters();
+
+		perf_counters(const perf_counters &) = delete;
+		perf_counters &operator=(const perf_counters &) = delete;
+
+		// 打不开的计数器的原因，例如 "branch-misses: No such file or directory"，全部可用时为空
+		const std::string &errors() const {
+			return errors_;
+		}
+
+		bool available() const {
+			return size_ != 0;
+		}
+
+		// 可用的计数器个数与名字
+		size_t size() const {
+			return size_;
+		}
+
+		const char *name(size_t i) const {
+			return names_[i];
+		}
+
+		// start / stop 之间的增量累加到 value(i)
+		void start();
+		void stop();
+
+		double value(size_t i) const {
+			return totals_[i];
+		}
+
+		void reset();
+
+	private:
+		struct sample {
+			uint64_t value;
+			uint64_t enabled;
+			uint64_t running;
+		};
+
+		bool read_sample(size_t i, sample &s) const;
+
+	private:
+		int fds_[max_counters];
+		const char *names_[max_counters];
+		size_t size_;
+		sample start_[max_counters];
+		double totals_[max_counters];
+		std::string errors_;
+	};
+} // namespace bench
+
+#endif // WSTL_BENCH_PERF_COUNTERS_H
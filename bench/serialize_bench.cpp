@@ -0,0 +1,118 @@
+// serialize 吞吐量基准：把 wstl::vector<uint64_t> 写入文件再读回，
+// 对比逐元素 fwrite / fread、serialize 的单次批量读写，以及 mapped_array 的零拷贝访问。
+// 读取结果受页缓存影响，刚写完的文件通常仍在内存中。
+//
+// 用法: serialize_bench [负载字节数，默认 1 GiB] [文件路径]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "serialize.h"
+#include "vector.h"
+
+namespace {
+
+	typedef std::chrono::steady_clock clock_type;
+
+	double seconds_since(clock_type::time_point start) {
+		return std::chrono::duration<double>(clock_type::now() - start).count();
+	}
+
+	void report(const char *name, size_t bytes, double seconds) {
+		std::printf("%-28s %10.3f s %10.2f GB/s\n", name, seconds, static_cast<double>(bytes) / seconds / 1e9);
+	}
+
+	uint64_t sum(const uint64_t *first, const uint64_t *last) {
+		uint64_t s = 0;
+		for (; first != last; ++first) {
+			s += *first;
+		}
+		return s;
+	}
+
+	void check(uint64_t actual, uint64_t expected, const char *name) {
+		if (actual != expected) {
+			std::fprintf(stderr, "%s : checksum mismatch\n", name);
+			std::exit(1);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	const size_t bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 30);
+	const char *path = argc > 2 ? argv[2] : "serialize_bench.bin";
+	const size_t n = bytes / sizeof(uint64_t);
+
+	wstl::vector<uint64_t> data(n);
+	for (size_t i = 0; i < n; ++i) {
+		data[i] = i * 0x9E3779B97F4A7C15ULL;
+	}
+	const uint64_t expected = sum(data.data(), data.data() + n);
+	std::printf("payload: %zu bytes, %zu elements, file: %s\n", n * sizeof(uint64_t), n, path);
+
+	// 逐元素写出
+	{
+		auto start = clock_type::now();
+		auto out = std::fopen(path, "wb");
+		if (out == nullptr) {
+			std::perror(path);
+			return 1;
+		}
+		for (auto v : data) {
+			std::fwrite(&v, sizeof(v), 1, out);
+		}
+		std::fclose(out);
+		report("fwrite per element", n * sizeof(uint64_t), seconds_since(start));
+	}
+
+	// 逐元素读入
+	{
+		auto start = clock_type::now();
+		auto in = std::fopen(path, "rb");
+		wstl::vector<uint64_t> loaded;
+		uint64_t v;
+		while (std::fread(&v, sizeof(v), 1, in) == 1) {
+			loaded.push_back(v);
+		}
+		std::fclose(in);
+		report("fread per element", n * sizeof(uint64_t), seconds_since(start));
+		check(sum(loaded.data(), loaded.data() + loaded.size()), expected, "fread per element");
+	}
+
+	// 批量写出（含校验和）
+	{
+		auto start = clock_type::now();
+		wstl::save(path, data);
+		report("wstl::save", n * sizeof(uint64_t), seconds_since(start));
+	}
+
+	// 批量读入（含校验）
+	{
+		auto start = clock_type::now();
+		wstl::vector<uint64_t> loaded;
+		wstl::load(path, loaded);
+		report("wstl::load", n * sizeof(uint64_t), seconds_since(start));
+		check(sum(loaded.data(), loaded.data() + loaded.size()), expected, "wstl::load");
+	}
+
+	// 零拷贝映射后遍历一次
+	{
+		auto start = clock_type::now();
+		wstl::mapped_array<uint64_t> mapped(path);
+		const auto s = sum(mapped.begin(), mapped.end());
+		report("mapped_array + scan", n * sizeof(uint64_t), seconds_since(start));
+		check(s, expected, "mapped_array");
+	}
+
+	// 映射并校验整个负载
+	{
+		auto start = clock_type::now();
+		wstl::mapped_array<uint64_t> mapped(path, true);
+		report("mapped_array + verify", n * sizeof(uint64_t), seconds_since(start));
+	}
+
+	std::remove(path);
+	return 0;
+}
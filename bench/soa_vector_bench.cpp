@@ -0,0 +1,99 @@
+// soa_vector 的微基准：只读写一两个字段的循环，对比把整条记录放在一起的 vector<record>。
+// 名字形如 bm_sum_field<wstl::vector<record>>/65536，参数是行数。
+
+#include <cstdint>
+
+#include "benchmark.h"
+#include "soa_vector.h"
+#include "vector.h"
+
+namespace {
+
+	// 64 字节的记录，热循环只用到 x（以及 bm_axpy 中的 y）
+	struct record {
+		double x;
+		double y;
+		double z;
+		double w;
+		uint64_t id;
+		uint64_t flags;
+		uint64_t created;
+		uint64_t updated;
+	};
+
+	typedef wstl::vector<record> aos_table;
+	typedef wstl::soa_vector<double, double, double, double, uint64_t, uint64_t, uint64_t, uint64_t> soa_table;
+
+	void fill(aos_table &t, size_t n) {
+		t.reserve(n);
+		for (size_t i = 0; i < n; ++i) {
+			t.push_back(record{i * 0.5, i * 0.25, 0, 0, i, 0, 0, 0});
+		}
+	}
+
+	void fill(soa_table &t, size_t n) {
+		t.reserve(n);
+		for (size_t i = 0; i < n; ++i) {
+			t.emplace_back(i * 0.5, i * 0.25, 0.0, 0.0, uint64_t(i), uint64_t(0), uint64_t(0), uint64_t(0));
+		}
+	}
+
+	double sum_x(const aos_table &t) {
+		double sum = 0;
+		for (auto it = t.begin(); it != t.end(); ++it) {
+			sum += it->x;
+		}
+		return sum;
+	}
+
+	double sum_x(const soa_table &t) {
+		double sum = 0;
+		for (double x : t.field<0>()) {
+			sum += x;
+		}
+		return sum;
+	}
+
+	void axpy(aos_table &t, double a) {
+		for (auto it = t.begin(); it != t.end(); ++it) {
+			it->y += a * it->x;
+		}
+	}
+
+	void axpy(soa_table &t, double a) {
+		const double *x = t.data<0>();
+		double *y = t.data<1>();
+		const size_t n = t.size();
+		for (size_t i = 0; i < n; ++i) {
+			y[i] += a * x[i];
+		}
+	}
+
+	template <class Table>
+	void bm_sum_field(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		Table t;
+		fill(t, n);
+		while (state.keep_running()) {
+			bench::do_not_optimize(sum_x(t));
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Table>
+	void bm_axpy(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		Table t;
+		fill(t, n);
+		while (state.keep_running()) {
+			axpy(t, 1.0001);
+			bench::clobber_memory();
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	WSTL_BENCHMARK_TEMPLATE(bm_sum_field, aos_table)->range(16, 1 << 20, 16);
+	WSTL_BENCHMARK_TEMPLATE(bm_sum_field, soa_table)->range(16, 1 << 20, 16);
+	WSTL_BENCHMARK_TEMPLATE(bm_axpy, aos_table)->range(16, 1 << 20, 16);
+	WSTL_BENCHMARK_TEMPLATE(bm_axpy, soa_table)->range(16, 1 << 20, 16);
+} // namespace
@@ -0,0 +1,253 @@
+// vector 操作的微基准：wstl::vector 与 std::vector 在三种元素类型、多种长度下对比。
+// 名字形如 bm_push_back<wstl::vector<int>>/1024，参数是元素个数。
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_types.h"
+#include "benchmark.h"
+#include "vector.h"
+
+namespace {
+
+	using bench::make_value;
+	using bench::pod64;
+
+	template <class Vector>
+	Vector make_vector(size_t n) {
+		Vector v;
+		v.reserve(n);
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back(make_value<typename Vector::value_type>(i));
+		}
+		return v;
+	}
+
+	template <class Vector>
+	void bm_push_back(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto value = make_value<typename Vector::value_type>(1);
+		while (state.keep_running()) {
+			Vector v;
+			for (size_t i = 0; i < n; ++i) {
+				v.push_back(value);
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_emplace_back(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto value = make_value<typename Vector::value_type>(1);
+		while (state.keep_running()) {
+			Vector v;
+			for (size_t i = 0; i < n; ++i) {
+				v.emplace_back(value);
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_insert_front(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto value = make_value<typename Vector::value_type>(1);
+		while (state.keep_running()) {
+			Vector v;
+			for (size_t i = 0; i < n; ++i) {
+				v.insert(v.begin(), value);
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_insert_middle(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto value = make_value<typename Vector::value_type>(1);
+		while (state.keep_running()) {
+			Vector v;
+			for (size_t i = 0; i < n; ++i) {
+				v.insert(v.begin() + v.size() / 2, value);
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_erase_front(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		while (state.keep_running()) {
+			state.pause_timing();
+			Vector v(source);
+			state.resume_timing();
+			while (!v.empty()) {
+				v.erase(v.begin());
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_erase_middle(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		while (state.keep_running()) {
+			state.pause_timing();
+			Vector v(source);
+			state.resume_timing();
+			while (!v.empty()) {
+				v.erase(v.begin() + v.size() / 2);
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_copy_construct(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		while (state.keep_running()) {
+			Vector v(source);
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+		state.set_bytes_processed(state.iterations() * n * sizeof(typename Vector::value_type));
+	}
+
+	// 移动构造与元素个数无关，这里测量一次移动构造加一次移动赋值
+	template <class Vector>
+	void bm_move_construct(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		auto source = make_vector<Vector>(n);
+		while (state.keep_running()) {
+			Vector v(std::move(source));
+			bench::do_not_optimize(v);
+			source = std::move(v);
+		}
+	}
+
+	template <class Vector>
+	void bm_assign(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		Vector v;
+		while (state.keep_running()) {
+			v.assign(source.begin(), source.end());
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+		state.set_bytes_processed(state.iterations() * n * sizeof(typename Vector::value_type));
+	}
+
+	// 尾部批量追加：以 16 个元素为一批插入到末尾，wstl::vector 走 append_range 路径
+	template <class Vector>
+	void bm_append_range(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		const auto first = source.data();
+		while (state.keep_running()) {
+			Vector v;
+			for (size_t i = 0; i < n; i += 16) {
+				v.insert(v.end(), first + i, first + i + 16);
+			}
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	// 删除一半元素（隔一个删一个）：wstl::erase_if 对比 std 的 erase(remove_if) 惯用法
+	// 谓词按值传递、可能被算法拷贝，计数器放在外面
+	struct every_other {
+		size_t *count;
+
+		template <class T>
+		bool operator()(const T &) const {
+			return ((*count)++ & 1) != 0;
+		}
+	};
+
+	template <class T>
+	void erase_every_other(wstl::vector<T> &v) {
+		size_t count = 0;
+		wstl::erase_if(v, every_other{&count});
+	}
+
+	template <class T>
+	void erase_every_other(std::vector<T> &v) {
+		size_t count = 0;
+		v.erase(std::remove_if(v.begin(), v.end(), every_other{&count}), v.end());
+	}
+
+	template <class Vector>
+	void bm_erase_if(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		while (state.keep_running()) {
+			state.pause_timing();
+			Vector v(source);
+			state.resume_timing();
+			erase_every_other(v);
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	// reserve：把已有的 n 个元素搬到更大的存储中
+	template <class Vector>
+	void bm_reserve(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto source = make_vector<Vector>(n);
+		while (state.keep_running()) {
+			state.pause_timing();
+			Vector v(source);
+			state.resume_timing();
+			v.reserve(n * 2);
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+	template <class Vector>
+	void bm_resize(bench::state &state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		while (state.keep_running()) {
+			Vector v;
+			v.resize(n);
+			bench::do_not_optimize(v);
+		}
+		state.set_items_processed(state.iterations() * n);
+	}
+
+#define WSTL_VECTOR_BENCHMARK(fn, lo, hi)                                  \
+	WSTL_BENCHMARK_TEMPLATE(fn, wstl::vector<int>)->range(lo, hi);         \
+	WSTL_BENCHMARK_TEMPLATE(fn, std::vector<int>)->range(lo, hi);          \
+	WSTL_BENCHMARK_TEMPLATE(fn, wstl::vector<pod64>)->range(lo, hi);       \
+	WSTL_BENCHMARK_TEMPLATE(fn, std::vector<pod64>)->range(lo, hi);        \
+	WSTL_BENCHMARK_TEMPLATE(fn, wstl::vector<std::string>)->range(lo, hi); \
+	WSTL_BENCHMARK_TEMPLATE(fn, std::vector<std::string>)->range(lo, hi)
+
+	WSTL_VECTOR_BENCHMARK(bm_push_back, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_emplace_back, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_insert_front, 16, 4096);
+	WSTL_VECTOR_BENCHMARK(bm_insert_middle, 16, 4096);
+	WSTL_VECTOR_BENCHMARK(bm_erase_front, 16, 4096);
+	WSTL_VECTOR_BENCHMARK(bm_erase_middle, 16, 4096);
+	WSTL_VECTOR_BENCHMARK(bm_erase_if, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_copy_construct, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_move_construct, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_assign, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_append_range, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_reserve, 16, 65536);
+	WSTL_VECTOR_BENCHMARK(bm_resize, 16, 65536);
+} // namespace
@@ -1,7 +1,561 @@
-﻿#include <iostream>
+﻿#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <thread>
 
+#include "aligned_allocator.h"
+#include "basic_string.h"
+#include "bitset.h"
+#include "concurrent_hash_map.h"
+#include "concurrent_vector.h"
+#include "epoch.h"
+#include "intrusive_hash_set.h"
+#include "intrusive_list.h"
+#include "list.h"
+#include "lru_cache.h"
+#include "memory.h"
+#if !defined(_WIN32)
+#include "mmap_vector.h"
+#endif
+#include "mpmc_queue.h"
+#include "numa_allocator.h"
+#include "pool_allocator.h"
+#include "queue.h"
+#include "serialize.h"
+#include "slot_map.h"
+#include "soa_vector.h"
+#include "span.h"
+#include "stats_allocator.h"
+#include "string_view.h"
 #include "vector.h"
 
+void test_mpmc_queue() {
+	wstl::mpmc_queue<int> queue(6);
+	std::cout << "mpmc_queue capacity: " << queue.capacity() << std::endl;
+
+	for (int i = 0; queue.try_push(i); ++i) {
+	}
+	std::cout << "mpmc_queue size after fill: " << queue.size() << std::endl;
+
+	int value = 0;
+	while (queue.try_pop(value)) {
+		std::cout << value << " ";
+	}
+	std::cout << std::endl;
+
+	// 4 个生产者 / 4 个消费者，校验和应为 4 * (1 + 2 + ... + 10000)
+	const int n = 10000;
+	long long sums[4] = {0, 0, 0, 0};
+	wstl::vector<std::thread> threads;
+	for (int p = 0; p < 4; ++p) {
+		threads.emplace_back([&queue] {
+			for (int i = 1; i <= n; ++i) {
+				queue.push(i);
+			}
+		});
+	}
+	for (int c = 0; c < 4; ++c) {
+		threads.emplace_back([&queue, &sums, c] {
+			int v = 0;
+			for (int i = 0; i < n; ++i) {
+				queue.pop(v);
+				sums[c] += v;
+			}
+		});
+	}
+	for (auto &t : threads) {
+		t.join();
+	}
+	std::cout << "mpmc_queue checksum: " << sums[0] + sums[1] + sums[2] + sums[3] << " (expected "
+			  << 4LL * n * (n + 1) / 2 << ")" << std::endl;
+}
+
+void test_concurrent_vector() {
+	wstl::concurrent_vector<int> cv;
+	cv.push_back(1);
+	const int *first = &cv[0];
+
+	// 4 个线程并发追加，元素地址不随增长改变
+	wstl::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&cv] {
+			for (int i = 0; i < 5000; ++i) {
+				cv.push_back(i);
+			}
+		});
+	}
+	for (auto &t : threads) {
+		t.join();
+	}
+	long long sum = 0;
+	for (auto v : cv) {
+		sum += v;
+	}
+	std::cout << "concurrent_vector size: " << cv.size() << ", sum: " << sum
+			  << ", first element stable: " << (first == &cv[0]) << std::endl;
+
+	auto it = cv.grow_by(3, 7);
+	for (; it != cv.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+
+	// 拷贝可能抛出异常的类型先在槽位之外构造
+	const wstl::string word = "segment";
+	wstl::concurrent_vector<wstl::string> words;
+	words.push_back(word);
+	words.grow_by(2, word);
+	wstl::concurrent_vector<wstl::string> copy(words);
+	std::cout << "concurrent_vector<string> copy size: " << copy.size() << ", back: " << copy.back() << std::endl;
+}
+
+void test_concurrent_hash_map() {
+	wstl::concurrent_hash_map<int, int> map(8);
+
+	// 4 个线程对同一组键计数
+	wstl::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&map] {
+			for (int i = 0; i < 10000; ++i) {
+				map.upsert(i % 100, [](int &v) { ++v; }, 1);
+			}
+		});
+	}
+	for (auto &t : threads) {
+		t.join();
+	}
+	int value = 0;
+	map.find(42, value);
+	std::cout << "concurrent_hash_map size: " << map.size() << ", map[42]: " << value << std::endl;
+
+	map.erase(42);
+	std::cout << "contains 42 after erase: " << map.contains(42) << ", insert 42: " << map.insert(42, 7)
+			  << ", insert 42 again: " << map.insert(42, 8) << std::endl;
+}
+
+void test_epoch() {
+	// 一个读线程在临界区内反复读取共享指针，写线程替换指针并延迟释放旧值
+	auto initial = wstl::allocator<int>::allocate();
+	wstl::construct(initial, 0);
+	std::atomic<int *> shared(initial);
+	std::atomic<bool> done(false);
+	long long observed = 0;
+
+	std::thread reader([&] {
+		while (!done.load()) {
+			wstl::epoch_guard guard;
+			observed += *shared.load(std::memory_order_acquire);
+		}
+	});
+	std::thread writer([&] {
+		for (int i = 1; i <= 10000; ++i) {
+			auto fresh = wstl::allocator<int>::allocate();
+			wstl::construct(fresh, i);
+			wstl::epoch_guard guard;
+			wstl::retire(shared.exchange(fresh, std::memory_order_acq_rel));
+		}
+		done.store(true);
+	});
+	writer.join();
+	reader.join();
+
+	std::cout << "epoch shared value: " << *shared.load() << ", epoch advanced: "
+			  << (wstl::epoch_domain::instance().epoch() > 0) << std::endl;
+	wstl::retire(shared.load());
+}
+
+void test_priority_queue() {
+	wstl::quaternary_priority_queue<int> pq{5, 1, 4, 1, 5, 9, 2, 6};
+	int more[] = {3, 8, 7};
+	pq.push_range(more, more + 3);
+	std::cout << "priority_queue: ";
+	while (!pq.empty()) {
+		std::cout << pq.top() << " ";
+		pq.pop();
+	}
+	std::cout << std::endl;
+
+	// 小顶堆，按 id 降低优先级
+	wstl::indexed_priority_queue<int, wstl::greater<int>> ipq(4);
+	ipq.push(0, 40);
+	ipq.push(1, 10);
+	ipq.push(2, 30);
+	ipq.push(3, 20);
+	ipq.decrease_key(0, 5);
+	ipq.erase(2);
+	std::cout << "indexed_priority_queue: ";
+	while (!ipq.empty()) {
+		std::cout << ipq.top_id() << ":" << ipq.top() << " ";
+		ipq.pop();
+	}
+	std::cout << std::endl;
+}
+
+void test_string() {
+	wstl::string s = "hello";
+	std::cout << "string sso capacity: " << s.capacity() << std::endl;
+	s += ", wstl string with small-string optimization";
+	s.replace(0, 5, "HELLO");
+	std::cout << s << " (" << s.size() << ")" << std::endl;
+	std::cout << "find \"string\": " << s.find("string") << ", rfind 's': " << s.rfind('s') << std::endl;
+
+	wstl::string digits;
+	digits.resize_and_overwrite(16, [](char *p, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			p[i] = static_cast<char>('0' + i % 10);
+		}
+		return n / 2;
+	});
+	std::cout << "resize_and_overwrite: " << digits << std::endl;
+}
+
+void test_views() {
+	// 不分配内存地切分请求行
+	wstl::string line = "GET /index.html HTTP/1.1";
+	wstl::string_view rest = line;
+	const auto method = rest.substr(0, rest.find(' '));
+	rest.remove_prefix(method.size() + 1);
+	const auto path = rest.substr(0, rest.find(' '));
+	std::cout << "method: " << method << ", path: " << path << ", version: " << rest.substr(path.size() + 1) << std::endl;
+
+	wstl::vector<int> vec{1, 2, 3, 4, 5, 6};
+	wstl::span<int> all(vec);
+	wstl::fill(all.last(2), 0);
+	int head[] = {7, 8};
+	wstl::copy(wstl::span<int>(head), all.subspan(1));
+	std::cout << "span: ";
+	for (auto x : all) {
+		std::cout << x << " ";
+	}
+	std::cout << ", first 3 equal: " << wstl::equal(all.first<3>(), wstl::span<const int>(vec.data(), 3)) << std::endl;
+}
+
+#if !defined(_WIN32)
+void test_mmap_vector() {
+	const char *path = "wstl_mmap_vector_test.bin";
+	{
+		wstl::mmap_vector<int> out(path, wstl::mmap_mode::truncate);
+		for (int i = 0; i < 100000; ++i) {
+			out.push_back(i);
+		}
+	}
+	wstl::mmap_vector<int> in(path);
+	long long sum = 0;
+	for (auto x : in) {
+		sum += x;
+	}
+	bool rejected = false;
+	try {
+		in.pop_back();
+	} catch (const std::runtime_error &) {
+		rejected = true;
+	}
+	std::cout << "mmap_vector size: " << in.size() << ", sum: " << sum << ", read_only pop_back rejected: " << rejected
+			  << std::endl;
+	in.close();
+	std::remove(path);
+}
+#endif
+
+void test_serialize() {
+	const char *path = "wstl_serialize_test.bin";
+	wstl::vector<int> nums;
+	for (int i = 0; i < 1000; ++i) {
+		nums.push_back(i * 3);
+	}
+	wstl::save(path, nums);
+	wstl::vector<int> loaded;
+	wstl::load(path, loaded);
+	std::cout << "serialize size: " << loaded.size() << ", back: " << loaded.back();
+#if !defined(_WIN32)
+	wstl::mapped_array<int> mapped(path, true);
+	std::cout << ", mapped back: " << mapped.back();
+	mapped.close();
+#endif
+	std::cout << std::endl;
+
+	wstl::vector<wstl::string> words;
+	words.push_back(wstl::string("short"));
+	words.push_back(wstl::string(40, 'x'));
+	wstl::pair<int, wstl::vector<wstl::string>> record(7, words);
+	wstl::save(path, record);
+	wstl::pair<int, wstl::vector<wstl::string>> restored;
+	wstl::load(path, restored);
+	std::cout << "serialize record: " << restored.first << " " << restored.second[0] << " "
+			  << restored.second[1].size() << std::endl;
+
+	wstl::vector<wstl::pair<int, int>> pairs;
+	for (int i = 0; i < 1000; ++i) {
+		pairs.push_back(wstl::make_pair(i, -i));
+	}
+	wstl::save(path, pairs);
+	wstl::vector<wstl::pair<int, int>> loaded_pairs;
+	wstl::load(path, loaded_pairs);
+	std::cout << "serialize pairs: " << loaded_pairs.size() << ", back: " << loaded_pairs.back().second;
+#if !defined(_WIN32)
+	wstl::mapped_array<wstl::pair<int, int>> mapped_pairs(path, true);
+	std::cout << ", mapped back: " << mapped_pairs.back().second;
+	mapped_pairs.close();
+#endif
+	std::cout << std::endl;
+	std::remove(path);
+}
+
+void test_aligned_allocator() {
+	wstl::vector<double, wstl::aligned_allocator<double>> small(10, 1.0);
+	wstl::vector<double, wstl::aligned_allocator<double>> large(1 << 20, 2.0);
+	std::cout << "aligned_allocator small aligned: " << (reinterpret_cast<uintptr_t>(small.data()) % 64 == 0)
+			  << ", large huge-page aligned: "
+			  << (!wstl::aligned_allocator<double>::uses_huge_pages(large.size()) ||
+				  reinterpret_cast<uintptr_t>(large.data()) % wstl::huge_page_size == 0)
+			  << std::endl;
+}
+
+void test_numa_vector() {
+	wstl::vector<long, wstl::numa_allocator<long, wstl::numa_policy::local>> vec(1 << 20, 3, wstl::parallel_init);
+	long long sum = 0;
+	for (auto x : vec) {
+		sum += x;
+	}
+	std::cout << "numa nodes: " << wstl::numa_node_count() << ", parallel_init sum: " << sum << std::endl;
+}
+
+WSTL_ALLOC_TAG(test_stats_tag);
+
+void test_stats_allocator() {
+	typedef wstl::stats_allocator<int, test_stats_tag> alloc_type;
+	{
+		wstl::vector<int, alloc_type> vec;
+		for (int i = 0; i < 1000; ++i) {
+			vec.push_back(i);
+		}
+		const auto s = alloc_type::snapshot();
+		std::cout << "stats_allocator " << s.name << " allocations: " << s.allocations << ", live: " << s.live_bytes
+				  << ", peak: " << s.peak_bytes << std::endl;
+	}
+	const auto s = alloc_type::snapshot();
+	std::cout << "stats_allocator after destroy live: " << s.live_bytes << ", deallocations: " << s.deallocations
+			  << std::endl;
+}
+
+void test_vector_append() {
+	wstl::vector<int> vec;
+	const int values[] = {1, 2, 3, 4, 5};
+	vec.append_range(values, values + 5);
+	vec.append_range(vec.begin(), vec.end());
+	int next = 100;
+	vec.append_n(3, [&next]() { return next++; });
+	vec.emplace_back_n(2, 7);
+	std::cout << "vector append:";
+	for (auto it = vec.begin(); it != vec.end(); ++it) {
+		std::cout << " " << *it;
+	}
+	vec.reserve(64);
+	vec.shrink_to_fit();
+	std::cout << ", capacity after shrink_to_fit: " << vec.capacity() << std::endl;
+#ifdef WSTL_ENABLE_STATS
+	const auto stats = wstl::vector_stats::snapshot();
+	std::cout << "vector_stats reallocations: " << stats.reallocations << ", bytes moved: " << stats.bytes_moved
+			  << std::endl;
+#endif
+}
+
+void test_vector_erase() {
+	wstl::vector<int> vec = {1, 1, 2, 3, 3, 3, 4, 5, 6, 7, 8, 9};
+	vec.erase(wstl::unique(vec.begin(), vec.end()), vec.end());
+	wstl::erase_if(vec, [](int x) { return x % 3 == 0; });
+	vec.erase_indices({0, 2});
+	std::cout << "vector erase:";
+	for (auto it = vec.begin(); it != vec.end(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << std::endl;
+}
+
+// 只能遍历一次的输入迭代器，依次产生 [*next, end)，next 为空指针时是尾后迭代器
+struct counting_input_iterator : wstl::iterator<wstl::input_iterator_tag, int> {
+	int *next;
+	int end;
+
+	counting_input_iterator(int *next, int end) : next(next), end(end) {}
+
+	int operator*() const {
+		return *next;
+	}
+
+	counting_input_iterator &operator++() {
+		++*next;
+		return *this;
+	}
+
+	bool at_end() const {
+		return next == nullptr || *next == end;
+	}
+
+	bool operator!=(const counting_input_iterator &rhs) const {
+		return at_end() != rhs.at_end();
+	}
+
+	bool operator==(const counting_input_iterator &rhs) const {
+		return !(*this != rhs);
+	}
+};
+
+void test_vector_input_iterator() {
+	int next = 10;
+	const counting_input_iterator last(nullptr, 0);
+	wstl::vector<int> vec = {1, 2, 3};
+	vec.insert(vec.begin() + 1, counting_input_iterator(&next, 13), last);
+	std::cout << "vector input iterator insert:";
+	for (auto it = vec.begin(); it != vec.end(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << std::endl;
+}
+
+void test_slot_map() {
+	wstl::slot_map<int> map;
+	const auto a = map.insert(1);
+	const auto b = map.insert(2);
+	const auto c = map.insert(3);
+	map.erase(a);
+	const auto d = map.insert(4);
+	std::cout << "slot_map size: " << map.size() << ", b: " << map[b] << ", c: " << map[c] << ", d: " << map[d]
+			  << ", a valid: " << map.contains(a) << std::endl;
+}
+
+void test_soa_vector() {
+	wstl::soa_vector<int, double> table;
+	table.emplace_back(3, 0.5);
+	table.emplace_back(1, 1.5);
+	table.emplace_back(2, 2.5);
+	wstl::make_heap(table.begin(), table.end(), wstl::soa_field_less<0>());
+	wstl::sort_heap(table.begin(), table.end(), wstl::soa_field_less<0>());
+	double sum = 0;
+	for (double x : table.field<1>()) {
+		sum += x;
+	}
+	std::cout << "soa_vector:";
+	for (auto it = table.begin(); it != table.end(); ++it) {
+		std::cout << " (" << wstl::get<0>(*it) << ", " << wstl::get<1>(*it) << ")";
+	}
+	std::cout << ", sum: " << sum << std::endl;
+}
+
+void test_bitset() {
+	wstl::hierarchical_bitset<> ids(1 << 20);
+	ids.set(3);
+	ids.set(70000);
+	ids.set(1000000);
+	wstl::hierarchical_bitset<> filter(1 << 20);
+	filter.set(70000);
+	filter.set(1000000);
+	ids &= filter;
+	std::cout << "hierarchical_bitset count: " << ids.count() << ", ids:";
+	for (auto i = ids.find_first(); i < ids.size(); i = ids.find_next(i)) {
+		std::cout << " " << i;
+	}
+	wstl::bitset<100> bits;
+	bits.set(1);
+	bits.set(99);
+	std::cout << ", bitset<100> flipped count: " << (~bits).count() << std::endl;
+}
+
+struct intrusive_task {
+	int id;
+	wstl::intrusive_list_hook run_hook;
+	wstl::intrusive_hash_hook id_hook;
+
+	explicit intrusive_task(int id) : id(id) {}
+
+	bool operator==(const intrusive_task &rhs) const {
+		return id == rhs.id;
+	}
+};
+
+struct intrusive_task_hash {
+	size_t operator()(const intrusive_task &task) const {
+		return static_cast<size_t>(task.id);
+	}
+};
+
+void test_intrusive() {
+	intrusive_task a(1), b(2), c(3);
+	wstl::intrusive_list<intrusive_task, &intrusive_task::run_hook> run_queue;
+	wstl::intrusive_hash_set<intrusive_task, &intrusive_task::id_hook, intrusive_task_hash> by_id;
+	run_queue.push_back(a);
+	run_queue.push_back(b);
+	run_queue.push_front(c);
+	by_id.insert(a);
+	by_id.insert(b);
+	by_id.insert(c);
+	run_queue.remove(b);
+	std::cout << "intrusive_list:";
+	for (auto it = run_queue.begin(); it != run_queue.end(); ++it) {
+		std::cout << " " << it->id;
+	}
+	std::cout << ", intrusive_hash_set size: " << by_id.size() << ", contains 2: " << by_id.contains(b) << std::endl;
+}
+
+void test_list() {
+	wstl::list<int, wstl::pool_allocator<int>> lst = {5, 3, 1};
+	wstl::list<int, wstl::pool_allocator<int>> other = {4, 2};
+	lst.sort();
+	other.sort();
+	lst.merge(other);
+	lst.splice(lst.begin(), lst, --lst.end());
+	lst.splice(lst.begin(), lst, lst.begin());
+	lst.splice(++lst.begin(), lst, lst.begin());
+	std::cout << "list:";
+	for (auto it = lst.begin(); it != lst.end(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << ", size: " << lst.size() << std::endl;
+}
+
+void test_lru_cache() {
+	wstl::lru_cache<int, int> lru(2);
+	lru.put(1, 10);
+	lru.put(2, 20);
+	lru.get(1);
+	lru.put(3, 30);
+	wstl::clock_cache<int, int> clock(2);
+	clock.put(1, 10);
+	clock.put(2, 20);
+	clock.get(1);
+	clock.put(3, 30);
+	std::cout << "lru_cache contains 1, 2, 3: " << lru.contains(1) << lru.contains(2) << lru.contains(3)
+			  << ", clock_cache contains 1, 2, 3: " << clock.contains(1) << clock.contains(2) << clock.contains(3)
+			  << std::endl;
+}
+
+void test_smart_ptr() {
+	wstl::unique_ptr<int> u = wstl::make_unique<int>(1);
+	wstl::shared_ptr<int> s = wstl::make_shared<int>(2);
+	wstl::weak_ptr<int> w = s;
+	wstl::shared_ptr<int> t = w.lock();
+	wstl::local_shared_ptr<int> l = wstl::make_local_shared<int>(3);
+	std::cout << "unique_ptr size: " << sizeof(u) << ", values: " << *u << " " << *t << " " << *l
+			  << ", shared use_count: " << s.use_count();
+	s.reset();
+	t.reset();
+	std::cout << ", weak expired: " << w.expired() << std::endl;
+}
+
+void test_temporary_buffer() {
+	int *first = nullptr;
+	bool reused = true;
+	for (int i = 0; i < 4; ++i) {
+		wstl::temporary_buffer<int> buffer(100 - i);
+		if (first == nullptr) {
+			first = buffer.data();
+		}
+		reused = reused && buffer.data() == first;
+		wstl::uninitialized_fill_n(buffer.begin(), buffer.size(), i);
+	}
+	std::cout << "temporary_buffer reused across calls: " << reused << std::endl;
+}
+
 int main() {
 	wstl::vector<int> vec;
 	vec.push_back(1);
@@ -75,4 +629,30 @@ int main() {
 		std::cout << i << " ";
 	}
 	std::cout << std::endl;
+
+	test_mpmc_queue();
+	test_concurrent_vector();
+	test_concurrent_hash_map();
+	test_epoch();
+	test_priority_queue();
+	test_string();
+	test_views();
+#if !defined(_WIN32)
+	test_mmap_vector();
+#endif
+	test_serialize();
+	test_aligned_allocator();
+	test_numa_vector();
+	test_stats_allocator();
+	test_vector_append();
+	test_vector_erase();
+	test_vector_input_iterator();
+	test_slot_map();
+	test_soa_vector();
+	test_bitset();
+	test_intrusive();
+	test_list();
+	test_lru_cache();
+	test_smart_ptr();
+	test_temporary_buffer();
 }
\ No newline at end of file
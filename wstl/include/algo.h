@@ -5,6 +5,7 @@
 #include <ctime>
 
 #include "algobase.h"
+#include "functional.h"
 #include "memory.h"
 
 namespace wstl {
@@ -15,6 +16,399 @@ namespace wstl {
 			wstl::iter_swap(first++, last);
 		}
 	}
+
+	// find, 在 [first, last) 中查找第一个等于 value 的元素
+	template <class InputIterator, class T>
+	InputIterator find(InputIterator first, InputIterator last, const T &value) {
+		while (first != last && !(*first == value)) {
+			++first;
+		}
+		return first;
+	}
+
+	// find_if, 在 [first, last) 中查找第一个使 pred 为 true 的元素
+	template <class InputIterator, class UnaryPredicate>
+	InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate pred) {
+		while (first != last && !pred(*first)) {
+			++first;
+		}
+		return first;
+	}
+
+	// adjacent_find, 查找第一对满足 pred 的相邻元素，返回其中的第一个
+	template <class ForwardIterator, class BinaryPredicate>
+	ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last, BinaryPredicate pred) {
+		if (first == last) {
+			return last;
+		}
+		ForwardIterator next = first;
+		while (++next != last) {
+			if (pred(*first, *next)) {
+				return first;
+			}
+			first = next;
+		}
+		return last;
+	}
+
+	template <class ForwardIterator>
+	ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last) {
+		return wstl::adjacent_find(first, last, wstl::equal_to<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	/**
+	 * rotate
+	 * @tparam ForwardIterator
+	 * @param first, middle, last
+	 * @return ForwardIterator
+	 * @note 把 [middle, last) 移到 [first, middle) 之前，返回原来的 *first 的新位置；只需要前向迭代器，共约 n 次交换
+	 */
+	template <class ForwardIterator>
+	ForwardIterator rotate(ForwardIterator first, ForwardIterator middle, ForwardIterator last) {
+		if (first == middle) {
+			return last;
+		}
+		if (middle == last) {
+			return first;
+		}
+		ForwardIterator result = last;
+		bool result_known = false;
+		while (first != middle && middle != last) {
+			// 把 [middle, last) 逐个交换到前面，剩下的 [write, next_read, last) 继续旋转
+			ForwardIterator write = first;
+			ForwardIterator next_read = first;
+			for (ForwardIterator read = middle; read != last; ++write, ++read) {
+				if (write == next_read) {
+					next_read = read;
+				}
+				wstl::iter_swap(write, read);
+			}
+			if (!result_known) {
+				result = write;
+				result_known = true;
+			}
+			first = write;
+			middle = next_read;
+		}
+		return result;
+	}
+
+	/*****************************************************************************************/
+	// 										删除算法
+	/*****************************************************************************************/
+
+	// 以下算法不改变容器大小，把保留的元素依次移到前面并返回新的逻辑结尾，[返回值, last) 中的元素处于有效但未指定的状态
+	// 逐段压缩：先找出一段连续保留的元素，再整段搬移，
+	// 平凡类型的指针区间由 wstl::move 转为 memmove，保留段越长越接近内存带宽
+	// 每个元素的 pred 只求值一次，且在该元素被搬移之前
+
+	// compact_run, 把长度为 len 的保留段 [first, last) 移到 result；
+	// 短段逐个移动，避免删除密集时每个元素都付出一次 memmove 调用的开销
+	template <class ForwardIterator, class Distance>
+	ForwardIterator compact_run(ForwardIterator first, ForwardIterator last, Distance len, ForwardIterator result) {
+		if (len < 16) {
+			for (; first != last; ++first, ++result) {
+				*result = wstl::move(*first);
+			}
+			return result;
+		}
+		return wstl::move(first, last, result);
+	}
+
+	/**
+	 * remove_if
+	 * @tparam ForwardIterator, UnaryPredicate
+	 * @param first, last, pred
+	 * @return ForwardIterator
+	 * @note 删除 [first, last) 中使 pred 为 true 的元素，保持其余元素的相对顺序
+	 */
+	template <class ForwardIterator, class UnaryPredicate>
+	ForwardIterator remove_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred) {
+		first = wstl::find_if(first, last, pred);
+		ForwardIterator result = first;
+		while (first != last) {
+			// *first 需要删除，跳过连续的待删除元素
+			do {
+				++first;
+			} while (first != last && pred(*first));
+			if (first == last) {
+				break;
+			}
+			// *first 需要保留，向后找出整段保留的元素
+			ForwardIterator run = first;
+			size_t len = 1;
+			while (++first != last && !pred(*first)) {
+				++len;
+			}
+			result = wstl::compact_run(run, first, len, result);
+		}
+		return result;
+	}
+
+	// remove, 删除 [first, last) 中等于 value 的元素
+	template <class ForwardIterator, class T>
+	ForwardIterator remove(ForwardIterator first, ForwardIterator last, const T &value) {
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		return wstl::remove_if(first, last, [&value](const value_type &x) { return x == value; });
+	}
+
+	/**
+	 * unique
+	 * @tparam ForwardIterator, BinaryPredicate
+	 * @param first, last, pred
+	 * @return ForwardIterator
+	 * @note 连续的等价元素只保留第一个，pred 须为等价关系
+	 */
+	template <class ForwardIterator, class BinaryPredicate>
+	ForwardIterator unique(ForwardIterator first, ForwardIterator last, BinaryPredicate pred) {
+		first = wstl::adjacent_find(first, last, pred);
+		if (first == last) {
+			return last;
+		}
+		ForwardIterator prev = first;
+		ForwardIterator result = ++first;
+		while (first != last) {
+			// *first 与 *prev 等价，需要删除；prev 只指向尚未搬移的元素
+			do {
+				prev = first;
+				++first;
+			} while (first != last && pred(*prev, *first));
+			if (first == last) {
+				break;
+			}
+			ForwardIterator run = first;
+			size_t len = 0;
+			do {
+				prev = first;
+				++first;
+				++len;
+			} while (first != last && !pred(*prev, *first));
+			result = wstl::compact_run(run, first, len, result);
+		}
+		return result;
+	}
+
+	template <class ForwardIterator>
+	ForwardIterator unique(ForwardIterator first, ForwardIterator last) {
+		return wstl::unique(first, last, wstl::equal_to<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	/*****************************************************************************************/
+	// 										堆算法
+	/*****************************************************************************************/
+
+	// 堆以数组形式存放在 [first, last) 中，下标为 i 的节点的子节点为 [D * i + 1, D * i + D]
+	// 默认 D = 2（二叉堆）；D = 4 时树高减半，同一父节点的子节点位于同一缓存行，大堆的 pop 更快
+	// 比较函数 comp(a, b) 为 true 表示 a 的优先级低于 b，堆顶为优先级最高的元素
+
+	/**
+	 * heap_sift_up
+	 * @tparam D, RandomAccessIterator, Distance, T, Compare
+	 * @param first, hole, top, value, comp
+	 * @return void
+	 * @note 从空位 hole 开始向上寻找 value 的位置，不越过 top
+	 */
+	template <size_t D, class RandomAccessIterator, class Distance, class T, class Compare>
+	void heap_sift_up(RandomAccessIterator first, Distance hole, Distance top, T value, Compare comp) {
+		while (hole > top) {
+			const Distance parent = (hole - 1) / static_cast<Distance>(D);
+			if (!comp(*(first + parent), value)) {
+				break;
+			}
+			*(first + hole) = wstl::move(*(first + parent));
+			hole = parent;
+		}
+		*(first + hole) = wstl::move(value);
+	}
+
+	/**
+	 * heap_adjust
+	 * @tparam D, RandomAccessIterator, Distance, T, Compare
+	 * @param first, hole, len, value, comp
+	 * @return void
+	 * @note 空位 hole 先沿优先级最高的子节点下沉到叶子，再把 value 从叶子向上放回（每层少一次比较）
+	 */
+	template <size_t D, class RandomAccessIterator, class Distance, class T, class Compare>
+	void heap_adjust(RandomAccessIterator first, Distance hole, Distance len, T value, Compare comp) {
+		const Distance top = hole;
+		const Distance arity = static_cast<Distance>(D);
+		for (;;) {
+			const Distance child = arity * hole + 1;
+			if (child >= len) {
+				break;
+			}
+			Distance best = child;
+			const Distance last = len - child < arity ? len : child + arity;
+			for (Distance c = child + 1; c < last; ++c) {
+				if (comp(*(first + best), *(first + c))) {
+					best = c;
+				}
+			}
+			*(first + hole) = wstl::move(*(first + best));
+			hole = best;
+		}
+		wstl::heap_sift_up<D>(first, hole, top, wstl::move(value), comp);
+	}
+
+	/**
+	 * dary_push_heap / push_heap
+	 * @tparam D, RandomAccessIterator, Compare
+	 * @param first, last, comp
+	 * @return void
+	 * @note [first, last - 1) 是堆，把 *(last - 1) 加入堆中
+	 */
+	template <size_t D, class RandomAccessIterator, class Compare>
+	void dary_push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type distance_type;
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		const distance_type len = last - first;
+		if (len > 1) {
+			value_type value = wstl::move(*(last - 1));
+			wstl::heap_sift_up<D>(first, len - 1, static_cast<distance_type>(0), wstl::move(value), comp);
+		}
+	}
+
+	template <class RandomAccessIterator, class Compare>
+	void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		wstl::dary_push_heap<2>(first, last, comp);
+	}
+
+	template <class RandomAccessIterator>
+	void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
+		wstl::dary_push_heap<2>(first, last, wstl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+	/**
+	 * dary_pop_heap / pop_heap
+	 * @tparam D, RandomAccessIterator, Compare
+	 * @param first, last, comp
+	 * @return void
+	 * @note 把堆顶移动到 last - 1，[first, last - 1) 重新成为堆
+	 */
+	template <size_t D, class RandomAccessIterator, class Compare>
+	void dary_pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type distance_type;
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		const distance_type len = last - first;
+		if (len > 1) {
+			value_type value = wstl::move(*(last - 1));
+			*(last - 1) = wstl::move(*first);
+			wstl::heap_adjust<D>(first, static_cast<distance_type>(0), len - 1, wstl::move(value), comp);
+		}
+	}
+
+	template <class RandomAccessIterator, class Compare>
+	void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		wstl::dary_pop_heap<2>(first, last, comp);
+	}
+
+	template <class RandomAccessIterator>
+	void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
+		wstl::dary_pop_heap<2>(first, last, wstl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+	/**
+	 * dary_make_heap / make_heap
+	 * @tparam D, RandomAccessIterator, Compare
+	 * @param first, last, comp
+	 * @return void
+	 * @note 自底向上建堆（Floyd），O(n)
+	 */
+	template <size_t D, class RandomAccessIterator, class Compare>
+	void dary_make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type distance_type;
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		const distance_type len = last - first;
+		if (len < 2) {
+			return;
+		}
+		for (distance_type parent = (len - 2) / static_cast<distance_type>(D);; --parent) {
+			value_type value = wstl::move(*(first + parent));
+			wstl::heap_adjust<D>(first, parent, len, wstl::move(value), comp);
+			if (parent == 0) {
+				return;
+			}
+		}
+	}
+
+	template <class RandomAccessIterator, class Compare>
+	void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		wstl::dary_make_heap<2>(first, last, comp);
+	}
+
+	template <class RandomAccessIterator>
+	void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+		wstl::dary_make_heap<2>(first, last, wstl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+	/**
+	 * dary_sort_heap / sort_heap
+	 * @tparam D, RandomAccessIterator, Compare
+	 * @param first, last, comp
+	 * @return void
+	 * @note 不断 pop_heap，把堆排成按 comp 升序的序列
+	 */
+	template <size_t D, class RandomAccessIterator, class Compare>
+	void dary_sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		while (last - first > 1) {
+			wstl::dary_pop_heap<D>(first, last--, comp);
+		}
+	}
+
+	template <class RandomAccessIterator, class Compare>
+	void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		wstl::dary_sort_heap<2>(first, last, comp);
+	}
+
+	template <class RandomAccessIterator>
+	void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+		wstl::dary_sort_heap<2>(first, last, wstl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+	/**
+	 * dary_is_heap_until / is_heap_until / is_heap
+	 * @tparam D, RandomAccessIterator, Compare
+	 * @param first, last, comp
+	 * @return RandomAccessIterator / bool
+	 * @note 返回第一个破坏堆性质的位置
+	 */
+	template <size_t D, class RandomAccessIterator, class Compare>
+	RandomAccessIterator dary_is_heap_until(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type distance_type;
+		const distance_type len = last - first;
+		for (distance_type child = 1; child < len; ++child) {
+			if (comp(*(first + (child - 1) / static_cast<distance_type>(D)), *(first + child))) {
+				return first + child;
+			}
+		}
+		return last;
+	}
+
+	template <class RandomAccessIterator, class Compare>
+	RandomAccessIterator is_heap_until(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		return wstl::dary_is_heap_until<2>(first, last, comp);
+	}
+
+	template <class RandomAccessIterator>
+	RandomAccessIterator is_heap_until(RandomAccessIterator first, RandomAccessIterator last) {
+		return wstl::dary_is_heap_until<2>(first, last,
+										   wstl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+	template <size_t D, class RandomAccessIterator, class Compare>
+	bool dary_is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		return wstl::dary_is_heap_until<D>(first, last, comp) == last;
+	}
+
+	template <class RandomAccessIterator, class Compare>
+	bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+		return wstl::dary_is_heap_until<2>(first, last, comp) == last;
+	}
+
+	template <class RandomAccessIterator>
+	bool is_heap(RandomAccessIterator first, RandomAccessIterator last) {
+		return wstl::is_heap_until(first, last) == last;
+	}
 }
 
 #endif // WSTL_ALGO_H
\ No newline at end of file
@@ -7,7 +7,9 @@
 
 #include <cstring>
 
+#include "exceptdef.h"
 #include "iterator.h"
+#include "span.h"
 #include "util.h"
 
 namespace wstl {
@@ -132,7 +134,7 @@ namespace wstl {
 
 	template <class BidirectionalIterator1, class BidirectionalIterator2>
 	BidirectionalIterator2
-	copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator1 result) {
+	copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
 		return unchecked_copy_backward(first, last, result);
 	}
 
@@ -238,7 +240,7 @@ namespace wstl {
 	template <class RandomAccessIterator, class T>
 	void
 	fill_cat(RandomAccessIterator first, RandomAccessIterator last, const T &value, wstl::random_access_iterator_tag) {
-		fill_n(first, last - first, value);
+		wstl::fill_n(first, last - first, value);
 	}
 
 	template <class ForwardIterator, class T>
@@ -383,12 +385,23 @@ namespace wstl {
 	}
 
 	// iter_swap, 交换迭代器指向的元素
+	// 解引用得到的是代理对象而不是引用时（例如 soa_vector 的行引用），调用代理对象的 swap 成员交换其代表的值
 
 	template <class ForwardIterator1, class ForwardIterator2>
-	void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
+	void iter_swap_aux(ForwardIterator1 a, ForwardIterator2 b, std::true_type) {
 		wstl::swap(*a, *b);
 	}
 
+	template <class ForwardIterator1, class ForwardIterator2>
+	void iter_swap_aux(ForwardIterator1 a, ForwardIterator2 b, std::false_type) {
+		(*a).swap(*b);
+	}
+
+	template <class ForwardIterator1, class ForwardIterator2>
+	void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
+		wstl::iter_swap_aux(a, b, std::is_reference<decltype(*a)>());
+	}
+
 	// equal, 比较两个区间内的元素是否相等
 
 	template <class InputIterator1, class InputIterator2>
@@ -446,7 +459,7 @@ namespace wstl {
 
 	// const unsigned char * 版本的特化版本，直接使用 std::memcmp 比较
 	template <>
-	bool lexicographical_compare(const unsigned char *first1, const unsigned char *last1, const unsigned char *first2,
+	inline bool lexicographical_compare(const unsigned char *first1, const unsigned char *last1, const unsigned char *first2,
 								 const unsigned char *last2) {
 		const auto len1 = static_cast<size_t>(last1 - first1);
 		const auto len2 = static_cast<size_t>(last2 - first2);
@@ -474,6 +487,52 @@ namespace wstl {
 		}
 		return wstl::pair<InputIterator1, InputIterator2>(first1, first2);
 	}
+
+	/*****************************************************************************************/
+	// 										span 版本
+	/*****************************************************************************************/
+
+	// 以下重载直接接受 span，便于对切分出的子视图调用算法，内部转发给迭代器版本（保留 memmove / memset / memcmp 快速路径）
+
+	// copy, 把 src 复制到 dst 的开头，要求 dst.size() >= src.size()，返回 dst 中未写入的部分
+	template <class T, size_t E1, class U, size_t E2>
+	span<U> copy(span<T, E1> src, span<U, E2> dst) {
+		WSTL_DEBUG(src.size() <= dst.size());
+		wstl::copy(src.begin(), src.end(), dst.begin());
+		return span<U>(dst).subspan(src.size());
+	}
+
+	// fill, 把 s 中的元素填充为 value
+	template <class T, size_t Extent, class V>
+	void fill(span<T, Extent> s, const V &value) {
+		wstl::fill(s.begin(), s.end(), value);
+	}
+
+	// equal, 长度相同且元素逐个相等；同类型整数直接使用 std::memcmp
+	template <class T, class U>
+	bool equal_span_cat(const T *first1, const U *first2, size_t n, std::false_type) {
+		return wstl::equal(first1, first1 + n, first2);
+	}
+
+	template <class T, class U>
+	bool equal_span_cat(const T *first1, const U *first2, size_t n, std::true_type) {
+		return n == 0 || std::memcmp(first1, first2, n * sizeof(T)) == 0;
+	}
+
+	template <class T, size_t E1, class U, size_t E2>
+	bool equal(span<T, E1> lhs, span<U, E2> rhs) {
+		typedef typename std::remove_cv<T>::type lhs_type;
+		typedef typename std::remove_cv<U>::type rhs_type;
+		typedef std::integral_constant<bool, std::is_integral<lhs_type>::value && std::is_same<lhs_type, rhs_type>::value>
+			is_bitwise;
+		return lhs.size() == rhs.size() && equal_span_cat(lhs.data(), rhs.data(), lhs.size(), is_bitwise());
+	}
+
+	// lexicographical_compare, span<const unsigned char> 使用 std::memcmp 版本
+	template <class T, size_t E1, class U, size_t E2>
+	bool lexicographical_compare(span<T, E1> lhs, span<U, E2> rhs) {
+		return wstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
 }
 
 #endif // WSTL_ALGOBASE_H
@@ -0,0 +1,251 @@
+#ifndef WSTL_ALIGNED_ALLOCATOR_H
+#define WSTL_ALIGNED_ALLOCATOR_H
+
+/*
+	该文件实现对齐分配器 aligned_allocator<T, Alignment, HugeThreshold>
+
+	接口与 wstl::allocator 相同（全部是静态成员函数），可以直接作为 vector、basic_string 等容器的 Alloc 参数。
+
+	对齐：
+		返回的地址按 Alignment 对齐，默认取 64 字节（缓存行 / AVX-512 宽度）与 alignof(T) 中较大者，
+		因此 alignas(64) 的类型以及 SIMD 向量类型都能正确对齐，相邻的两个缓冲区也不会共享缓存行。
+
+	大页：
+		请求的字节数不小于 HugeThreshold（默认 2 MiB）时改用匿名 mmap，映射按 2 MiB 对齐并通过 madvise(MADV_HUGEPAGE)
+		请求透明大页，数 GB 的数组只需要原来约 1/512 的 TLB 表项。
+		内核未开启透明大页或平台没有 MADV_HUGEPAGE 时 madvise 失败被忽略，退化为普通 4 KB 页面，行为不变。
+		HugeThreshold 为 0 时关闭大页路径；大页路径只在 Linux 上提供，其他平台上所有请求都走对齐的堆内存。
+		释放时按相同的字节数判断走哪条路径，所以 deallocate 必须传入与 allocate 相同的 n（wstl 容器都是如此）。
+
+	对齐的堆内存在 POSIX 上由 posix_memalign 分配，在 Windows 上由 _aligned_malloc 分配。
+
+	分配失败抛出 std::bad_alloc。
+*/
+
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include <cstdint>
+#include <new>
+
+#include "construct.h"
+#include "sync.h"
+#include "util.h"
+
+namespace wstl {
+
+	constexpr size_t huge_page_size = size_t(2) << 20; // x86-64 / AArch64 的透明大页大小
+
+#if defined(__linux__)
+	constexpr bool huge_pages_available = true;
+#else
+	constexpr bool huge_pages_available = false;
+#endif
+
+	// huge_page_bytes, 大页路径实际映射的字节数
+	inline size_t huge_page_bytes(size_t bytes) noexcept {
+		return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+	}
+
+#if defined(__linux__)
+	// huge_page_allocate, 映射 bytes 字节（向上取整到大页）的匿名内存，起始地址按大页对齐
+	inline void *huge_page_allocate(size_t bytes) {
+		const auto len = huge_page_bytes(bytes);
+		// 多映射一个大页，再把首尾多余的部分还给内核，得到大页对齐的区间
+		const auto map_len = len + huge_page_size;
+		void *p = ::mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+		const auto raw = reinterpret_cast<uintptr_t>(p);
+		const auto aligned = (raw + huge_page_size - 1) & ~static_cast<uintptr_t>(huge_page_size - 1);
+		const auto head = static_cast<size_t>(aligned - raw);
+		if (head != 0) {
+			::munmap(p, head);
+		}
+		if (map_len - head - len != 0) {
+			::munmap(reinterpret_cast<void *>(aligned + len), map_len - head - len);
+		}
+#ifdef MADV_HUGEPAGE
+		::madvise(reinterpret_cast<void *>(aligned), len, MADV_HUGEPAGE);
+#endif
+		return reinterpret_cast<void *>(aligned);
+	}
+
+	inline void huge_page_deallocate(void *p, size_t bytes) noexcept {
+		::munmap(p, huge_page_bytes(bytes));
+	}
+#endif
+
+	// aligned_allocate, bytes 字节、按 alignment 对齐的堆内存
+	inline void *aligned_allocate(size_t bytes, size_t alignment) {
+		if (alignment < sizeof(void *)) {
+			alignment = sizeof(void *);
+		}
+#if defined(_WIN32)
+		void *p = ::_aligned_malloc(bytes, alignment);
+		if (p == nullptr) {
+			throw std::bad_alloc();
+		}
+#else
+		void *p = nullptr;
+		if (::posix_memalign(&p, alignment, bytes) != 0) {
+			throw std::bad_alloc();
+		}
+#endif
+		return p;
+	}
+
+	inline void aligned_deallocate(void *p) noexcept {
+#if defined(_WIN32)
+		::_aligned_free(p);
+#else
+		::free(p);
+#endif
+	}
+
+	// 模版类 aligned_allocator
+	template <class T, size_t Alignment = (alignof(T) > cache_line_size ? alignof(T) : cache_line_size),
+			  size_t HugeThreshold = huge_page_size>
+	class aligned_allocator {
+		static_assert((Alignment & (Alignment - 1)) == 0, "aligned_allocator : alignment must be a power of two");
+		static_assert(Alignment >= alignof(T), "aligned_allocator : alignment weaker than alignof(T)");
+		static_assert(Alignment <= huge_page_size, "aligned_allocator : alignment larger than a huge page");
+
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		static constexpr size_type alignment = Alignment;
+		static constexpr size_type huge_threshold = HugeThreshold;
+
+		// rebind, 对齐取 Alignment 与 alignof(U) 中较大的一个
+		template <class U>
+		struct rebind {
+			typedef aligned_allocator<U, (alignof(U) > Alignment ? alignof(U) : Alignment), HugeThreshold> other;
+		};
+
+	public:
+		static T *allocate();
+		static T *allocate(size_type n);
+
+		static void deallocate(T *ptr);
+		static void deallocate(T *ptr, size_type n);
+
+		static void construct(T *ptr);
+		static void construct(T *ptr, const T &value);
+		static void construct(T *ptr, T &&value);
+
+		template <class... Args>
+		static void construct(T *ptr, Args &&...args);
+
+		static void destroy(T *ptr);
+		static void destroy(T *first, T *last);
+
+		// uses_huge_pages, n 个元素的分配是否走大页路径
+		static bool uses_huge_pages(size_type n) noexcept {
+			return huge_pages_available && HugeThreshold != 0 && n * sizeof(T) >= HugeThreshold;
+		}
+	};
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	constexpr typename aligned_allocator<T, Alignment, HugeThreshold>::size_type
+		aligned_allocator<T, Alignment, HugeThreshold>::alignment;
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	constexpr typename aligned_allocator<T, Alignment, HugeThreshold>::size_type
+		aligned_allocator<T, Alignment, HugeThreshold>::huge_threshold;
+
+	// allocate 分配内存
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	T *aligned_allocator<T, Alignment, HugeThreshold>::allocate() {
+		return allocate(1);
+	}
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	T *aligned_allocator<T, Alignment, HugeThreshold>::allocate(size_type n) {
+		if (n == 0) {
+			return nullptr;
+		}
+		if (n > static_cast<size_type>(-1) / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+#if defined(__linux__)
+		if (uses_huge_pages(n)) {
+			return static_cast<T *>(huge_page_allocate(n * sizeof(T)));
+		}
+#endif
+		return static_cast<T *>(aligned_allocate(n * sizeof(T), Alignment));
+	}
+
+	// deallocate 释放内存
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::deallocate(T *ptr) {
+		deallocate(ptr, 1);
+	}
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::deallocate(T *ptr, size_type n) {
+		if (ptr == nullptr) {
+			return;
+		}
+#if defined(__linux__)
+		if (uses_huge_pages(n)) {
+			huge_page_deallocate(ptr, n * sizeof(T));
+			return;
+		}
+#endif
+		aligned_deallocate(ptr);
+	}
+
+	// construct 构造对象
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::construct(T *ptr) {
+		wstl::construct(ptr);
+	}
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::construct(T *ptr, const T &value) {
+		wstl::construct(ptr, value);
+	}
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::construct(T *ptr, T &&value) {
+		wstl::construct(ptr, wstl::move(value));
+	}
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	template <class... Args>
+	void aligned_allocator<T, Alignment, HugeThreshold>::construct(T *ptr, Args &&...args) {
+		wstl::construct(ptr, wstl::forward<Args>(args)...);
+	}
+
+	// destroy 析构对象
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::destroy(T *ptr) {
+		wstl::destroy(ptr);
+	}
+
+	template <class T, size_t Alignment, size_t HugeThreshold>
+	void aligned_allocator<T, Alignment, HugeThreshold>::destroy(T *first, T *last) {
+		wstl::destroy(first, last);
+	}
+} // namespace wstl
+
+#endif // WSTL_ALIGNED_ALLOCATOR_H
@@ -20,6 +20,12 @@ namespace wstl {
 		typedef size_t size_type;
 		typedef ptrdiff_t difference_type;
 
+		// rebind, 同一种分配器改为分配 U，节点式容器用它分配节点
+		template <class U>
+		struct rebind {
+			typedef allocator<U> other;
+		};
+
 	public:
 		static T *allocate();
 		static T *allocate(size_type n);
@@ -0,0 +1,1210 @@
+#ifndef WSTL_BASIC_STRING_H
+#define WSTL_BASIC_STRING_H
+
+/*
+	该文件实现 basic_string 类模板以及 string、wstring、u16string、u32string
+
+	内存布局（短字符串优化，SSO）：
+		对象大小为 3 个字长（64 位下 24 字节）。长字符串存放 {指针, 长度, 容量}，
+		短字符串直接存放在对象内部，最多 sizeof(对象) / sizeof(CharT) - 1 个字符（64 位下 char 为 23 个）。
+		短字符串的最后一个字符位置存放剩余容量，字符串占满时它恰好为 0，兼作结尾的空字符。
+		对象最后一个字节的最高位为 1 表示长字符串：小端机器上它是容量的最高位，大端机器上容量左移 8 位后存放标志。
+
+	查找与比较：
+		查找函数转发给 basic_string_view（见 string_view.h，char 使用 SSE2），compare 通过 Traits::compare 使用 memcmp。
+
+	异常保证：
+	basic_string 满足基本异常保证，需要重新分配内存的修改操作提供强异常安全保证
+*/
+
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <string>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "string_view.h"
+#include "util.h"
+
+namespace wstl {
+
+	/*****************************************************************************************/
+	// 									basic_string
+	/*****************************************************************************************/
+
+	// basic_string 类模板
+	template <class CharT, class Traits = std::char_traits<CharT>, class Alloc = wstl::allocator<CharT>>
+	class basic_string {
+		static_assert(std::is_trivial<CharT>::value && std::is_standard_layout<CharT>::value,
+					  "basic_string requires a trivial standard-layout character type");
+		static_assert(std::is_same<CharT, typename Traits::char_type>::value, "Traits::char_type must be CharT");
+
+	public:
+		// basic_string 的嵌套型别定义
+		typedef Traits traits_type;
+		typedef Alloc allocator_type;
+		typedef Alloc data_allocator;
+
+		typedef typename allocator_type::value_type value_type;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::size_type size_type;
+		typedef typename allocator_type::difference_type difference_type;
+
+		typedef pointer iterator;
+		typedef const_pointer const_iterator;
+		typedef wstl::reverse_iterator<iterator> reverse_iterator;
+		typedef wstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		typedef basic_string_view<CharT, Traits> view_type;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+		allocator_type get_allocator() const {
+			return data_allocator();
+		}
+
+	private:
+		struct long_rep {
+			pointer ptr;
+			size_type size;
+			size_type cap; // 编码后的容量，见 encode_cap
+		};
+
+		static_assert(sizeof(long_rep) % sizeof(CharT) == 0, "unsupported character size");
+
+		// 短字符串最多容纳的字符数
+		static constexpr size_type sso_capacity = sizeof(long_rep) / sizeof(CharT) - 1;
+
+		union {
+			long_rep l_;
+			value_type s_[sso_capacity + 1];
+		};
+
+	public:
+		// 构造、复制、移动、析构函数
+
+		basic_string() noexcept {
+			set_short_size(0);
+		}
+
+		basic_string(size_type n, value_type ch) {
+			fill_init(n, ch);
+		}
+
+		basic_string(const_pointer s) {
+			WSTL_DEBUG(s != nullptr);
+			copy_init(s, traits_type::length(s));
+		}
+
+		basic_string(const_pointer s, size_type n) {
+			copy_init(s, n);
+		}
+
+		basic_string(const basic_string &rhs, size_type pos, size_type n = npos) {
+			THROW_OUT_OF_RANGE_IF(pos > rhs.size(), "basic_string : out of range");
+			copy_init(rhs.data() + pos, wstl::min(n, rhs.size() - pos));
+		}
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		basic_string(InputIterator first, InputIterator last) {
+			range_init(first, last, iterator_category(first));
+		}
+
+		basic_string(std::initializer_list<value_type> il) {
+			copy_init(il.begin(), il.size());
+		}
+
+		explicit basic_string(view_type sv) {
+			copy_init(sv.data(), sv.size());
+		}
+
+		basic_string(const basic_string &rhs) {
+			copy_init(rhs.data(), rhs.size());
+		}
+
+		basic_string(basic_string &&rhs) noexcept {
+			std::memcpy(static_cast<void *>(&l_), &rhs.l_, sizeof(long_rep));
+			rhs.set_short_size(0);
+		}
+
+		basic_string &operator=(const basic_string &rhs) {
+			if (this != &rhs) {
+				assign(rhs.data(), rhs.size());
+			}
+			return *this;
+		}
+
+		basic_string &operator=(basic_string &&rhs) noexcept {
+			if (this != &rhs) {
+				release();
+				std::memcpy(static_cast<void *>(&l_), &rhs.l_, sizeof(long_rep));
+				rhs.set_short_size(0);
+			}
+			return *this;
+		}
+
+		basic_string &operator=(const_pointer s) {
+			return assign(s);
+		}
+
+		basic_string &operator=(value_type ch) {
+			return assign(1, ch);
+		}
+
+		basic_string &operator=(std::initializer_list<value_type> il) {
+			return assign(il.begin(), il.size());
+		}
+
+		~basic_string() {
+			release();
+		}
+
+	public:
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return data();
+		}
+
+		const_iterator begin() const noexcept {
+			return data();
+		}
+
+		iterator end() noexcept {
+			return data() + size();
+		}
+
+		const_iterator end() const noexcept {
+			return data() + size();
+		}
+
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() noexcept {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+
+		const_iterator cend() const noexcept {
+			return end();
+		}
+
+		const_reverse_iterator crbegin() const noexcept {
+			return rbegin();
+		}
+
+		const_reverse_iterator crend() const noexcept {
+			return rend();
+		}
+
+		// 容量相关操作
+
+		size_type size() const noexcept {
+			return is_long() ? l_.size : sso_capacity - static_cast<size_type>(s_[sso_capacity]);
+		}
+
+		size_type length() const noexcept {
+			return size();
+		}
+
+		size_type capacity() const noexcept {
+			return is_long() ? decode_cap(l_.cap) : sso_capacity;
+		}
+
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		size_type max_size() const noexcept {
+			// 容量需要腾出最高字节存放标志，并为结尾空字符留出位置
+			return (static_cast<size_type>(-1) >> 8) / sizeof(value_type) - 1;
+		}
+
+		void reserve(size_type n);
+
+		void shrink_to_fit();
+
+		// 访问元素相关操作
+
+		reference operator[](size_type n) {
+			WSTL_DEBUG(n <= size());
+			return data()[n];
+		}
+
+		const_reference operator[](size_type n) const {
+			WSTL_DEBUG(n <= size());
+			return data()[n];
+		}
+
+		reference at(size_type n) {
+			THROW_OUT_OF_RANGE_IF(n >= size(), "basic_string : out of range");
+			return data()[n];
+		}
+
+		const_reference at(size_type n) const {
+			THROW_OUT_OF_RANGE_IF(n >= size(), "basic_string : out of range");
+			return data()[n];
+		}
+
+		reference front() {
+			WSTL_DEBUG(!empty());
+			return data()[0];
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return data()[0];
+		}
+
+		reference back() {
+			WSTL_DEBUG(!empty());
+			return data()[size() - 1];
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return data()[size() - 1];
+		}
+
+		pointer data() noexcept {
+			return is_long() ? l_.ptr : s_;
+		}
+
+		const_pointer data() const noexcept {
+			return is_long() ? l_.ptr : s_;
+		}
+
+		const_pointer c_str() const noexcept {
+			return data();
+		}
+
+		operator view_type() const noexcept {
+			return view_type(data(), size());
+		}
+
+		// 修改容器相关操作
+
+		// assign
+
+		basic_string &assign(const basic_string &str) {
+			return *this = str;
+		}
+
+		basic_string &assign(basic_string &&str) noexcept {
+			return *this = wstl::move(str);
+		}
+
+		basic_string &assign(const basic_string &str, size_type pos, size_type n = npos) {
+			THROW_OUT_OF_RANGE_IF(pos > str.size(), "basic_string : out of range");
+			return assign(str.data() + pos, wstl::min(n, str.size() - pos));
+		}
+
+		basic_string &assign(const_pointer s, size_type n);
+
+		basic_string &assign(const_pointer s) {
+			return assign(s, traits_type::length(s));
+		}
+
+		basic_string &assign(size_type n, value_type ch) {
+			clear();
+			return append(n, ch);
+		}
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		basic_string &assign(InputIterator first, InputIterator last) {
+			basic_string tmp(first, last);
+			swap(tmp);
+			return *this;
+		}
+
+		basic_string &assign(std::initializer_list<value_type> il) {
+			return assign(il.begin(), il.size());
+		}
+
+		// append / push_back / pop_back
+
+		basic_string &append(const basic_string &str) {
+			return append(str.data(), str.size());
+		}
+
+		basic_string &append(const basic_string &str, size_type pos, size_type n = npos) {
+			THROW_OUT_OF_RANGE_IF(pos > str.size(), "basic_string : out of range");
+			return append(str.data() + pos, wstl::min(n, str.size() - pos));
+		}
+
+		basic_string &append(const_pointer s, size_type n);
+
+		basic_string &append(const_pointer s) {
+			return append(s, traits_type::length(s));
+		}
+
+		basic_string &append(size_type n, value_type ch);
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		basic_string &append(InputIterator first, InputIterator last) {
+			const basic_string tmp(first, last);
+			return append(tmp.data(), tmp.size());
+		}
+
+		basic_string &append(std::initializer_list<value_type> il) {
+			return append(il.begin(), il.size());
+		}
+
+		basic_string &append(view_type sv) {
+			return append(sv.data(), sv.size());
+		}
+
+		basic_string &operator+=(const basic_string &str) {
+			return append(str.data(), str.size());
+		}
+
+		basic_string &operator+=(const_pointer s) {
+			return append(s);
+		}
+
+		basic_string &operator+=(value_type ch) {
+			push_back(ch);
+			return *this;
+		}
+
+		basic_string &operator+=(std::initializer_list<value_type> il) {
+			return append(il.begin(), il.size());
+		}
+
+		basic_string &operator+=(view_type sv) {
+			return append(sv.data(), sv.size());
+		}
+
+		void push_back(value_type ch) {
+			const auto old_size = size();
+			if (old_size < capacity()) {
+				data()[old_size] = ch;
+				set_size(old_size + 1);
+			} else {
+				append_realloc(&ch, 1);
+			}
+		}
+
+		void pop_back() {
+			WSTL_DEBUG(!empty());
+			set_size(size() - 1);
+		}
+
+		// insert
+
+		basic_string &insert(size_type pos, const basic_string &str) {
+			return replace(pos, 0, str.data(), str.size());
+		}
+
+		basic_string &insert(size_type pos, const basic_string &str, size_type subpos, size_type n = npos) {
+			THROW_OUT_OF_RANGE_IF(subpos > str.size(), "basic_string : out of range");
+			return replace(pos, 0, str.data() + subpos, wstl::min(n, str.size() - subpos));
+		}
+
+		basic_string &insert(size_type pos, const_pointer s, size_type n) {
+			return replace(pos, 0, s, n);
+		}
+
+		basic_string &insert(size_type pos, const_pointer s) {
+			return replace(pos, 0, s, traits_type::length(s));
+		}
+
+		basic_string &insert(size_type pos, size_type n, value_type ch) {
+			return replace(pos, 0, n, ch);
+		}
+
+		iterator insert(const_iterator position, value_type ch) {
+			const auto pos = static_cast<size_type>(position - cbegin());
+			replace(pos, 0, 1, ch);
+			return begin() + pos;
+		}
+
+		iterator insert(const_iterator position, size_type n, value_type ch) {
+			const auto pos = static_cast<size_type>(position - cbegin());
+			replace(pos, 0, n, ch);
+			return begin() + pos;
+		}
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		iterator insert(const_iterator position, InputIterator first, InputIterator last) {
+			const auto pos = static_cast<size_type>(position - cbegin());
+			const basic_string tmp(first, last);
+			replace(pos, 0, tmp.data(), tmp.size());
+			return begin() + pos;
+		}
+
+		iterator insert(const_iterator position, std::initializer_list<value_type> il) {
+			const auto pos = static_cast<size_type>(position - cbegin());
+			replace(pos, 0, il.begin(), il.size());
+			return begin() + pos;
+		}
+
+		// erase / clear
+
+		basic_string &erase(size_type pos = 0, size_type n = npos);
+
+		iterator erase(const_iterator position) {
+			WSTL_DEBUG(position >= cbegin() && position < cend());
+			const auto pos = static_cast<size_type>(position - cbegin());
+			erase(pos, 1);
+			return begin() + pos;
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			WSTL_DEBUG(first >= cbegin() && last <= cend() && !(last < first));
+			const auto pos = static_cast<size_type>(first - cbegin());
+			erase(pos, static_cast<size_type>(last - first));
+			return begin() + pos;
+		}
+
+		void clear() noexcept {
+			set_size(0);
+		}
+
+		// replace
+
+		basic_string &replace(size_type pos, size_type n1, const basic_string &str) {
+			return replace(pos, n1, str.data(), str.size());
+		}
+
+		basic_string &replace(size_type pos, size_type n1, const_pointer s, size_type n2);
+
+		basic_string &replace(size_type pos, size_type n1, const_pointer s) {
+			return replace(pos, n1, s, traits_type::length(s));
+		}
+
+		basic_string &replace(size_type pos, size_type n1, size_type n2, value_type ch);
+
+		basic_string &replace(const_iterator first, const_iterator last, const basic_string &str) {
+			return replace(static_cast<size_type>(first - cbegin()), static_cast<size_type>(last - first), str.data(), str.size());
+		}
+
+		basic_string &replace(const_iterator first, const_iterator last, const_pointer s, size_type n) {
+			return replace(static_cast<size_type>(first - cbegin()), static_cast<size_type>(last - first), s, n);
+		}
+
+		// resize
+
+		void resize(size_type n, value_type ch);
+
+		void resize(size_type n) {
+			resize(n, value_type());
+		}
+
+		// resize_and_overwrite, 扩容到至少 n 个字符（新增部分不初始化），
+		// 再调用 op(data(), n) 写入内容，op 返回最终长度 (<= n)
+		template <class Operation>
+		void resize_and_overwrite(size_type n, Operation op);
+
+		// 其他操作
+
+		basic_string substr(size_type pos = 0, size_type n = npos) const {
+			return basic_string(*this, pos, n);
+		}
+
+		size_type copy(pointer dest, size_type n, size_type pos = 0) const {
+			THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string : out of range");
+			n = wstl::min(n, size() - pos);
+			traits_type::copy(dest, data() + pos, n);
+			return n;
+		}
+
+		void swap(basic_string &rhs) noexcept {
+			long_rep tmp;
+			std::memcpy(static_cast<void *>(&tmp), &l_, sizeof(long_rep));
+			std::memcpy(static_cast<void *>(&l_), &rhs.l_, sizeof(long_rep));
+			std::memcpy(static_cast<void *>(&rhs.l_), &tmp, sizeof(long_rep));
+		}
+
+		// 查找相关操作
+
+		size_type find(const_pointer s, size_type pos, size_type n) const noexcept {
+			return view_type(data(), size()).find(s, pos, n);
+		}
+
+		size_type find(const basic_string &str, size_type pos = 0) const noexcept {
+			return find(str.data(), pos, str.size());
+		}
+
+		size_type find(const_pointer s, size_type pos = 0) const noexcept {
+			return find(s, pos, traits_type::length(s));
+		}
+
+		size_type find(value_type ch, size_type pos = 0) const noexcept {
+			return view_type(data(), size()).find(ch, pos);
+		}
+
+		size_type rfind(const_pointer s, size_type pos, size_type n) const noexcept {
+			return view_type(data(), size()).rfind(s, pos, n);
+		}
+
+		size_type rfind(const basic_string &str, size_type pos = npos) const noexcept {
+			return rfind(str.data(), pos, str.size());
+		}
+
+		size_type rfind(const_pointer s, size_type pos = npos) const noexcept {
+			return rfind(s, pos, traits_type::length(s));
+		}
+
+		size_type rfind(value_type ch, size_type pos = npos) const noexcept {
+			return view_type(data(), size()).rfind(ch, pos);
+		}
+
+		size_type find_first_of(const_pointer s, size_type pos, size_type n) const noexcept {
+			return view_type(data(), size()).find_first_of(s, pos, n);
+		}
+
+		size_type find_first_of(const basic_string &str, size_type pos = 0) const noexcept {
+			return find_first_of(str.data(), pos, str.size());
+		}
+
+		size_type find_first_of(const_pointer s, size_type pos = 0) const noexcept {
+			return find_first_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_first_of(value_type ch, size_type pos = 0) const noexcept {
+			return find(ch, pos);
+		}
+
+		size_type find_last_of(const_pointer s, size_type pos, size_type n) const noexcept {
+			return view_type(data(), size()).find_last_of(s, pos, n);
+		}
+
+		size_type find_last_of(const basic_string &str, size_type pos = npos) const noexcept {
+			return find_last_of(str.data(), pos, str.size());
+		}
+
+		size_type find_last_of(const_pointer s, size_type pos = npos) const noexcept {
+			return find_last_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_last_of(value_type ch, size_type pos = npos) const noexcept {
+			return rfind(ch, pos);
+		}
+
+		size_type find_first_not_of(const_pointer s, size_type pos, size_type n) const noexcept {
+			return view_type(data(), size()).find_first_not_of(s, pos, n);
+		}
+
+		size_type find_first_not_of(const basic_string &str, size_type pos = 0) const noexcept {
+			return find_first_not_of(str.data(), pos, str.size());
+		}
+
+		size_type find_first_not_of(const_pointer s, size_type pos = 0) const noexcept {
+			return find_first_not_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_first_not_of(value_type ch, size_type pos = 0) const noexcept {
+			return find_first_not_of(&ch, pos, 1);
+		}
+
+		size_type find_last_not_of(const_pointer s, size_type pos, size_type n) const noexcept {
+			return view_type(data(), size()).find_last_not_of(s, pos, n);
+		}
+
+		size_type find_last_not_of(const basic_string &str, size_type pos = npos) const noexcept {
+			return find_last_not_of(str.data(), pos, str.size());
+		}
+
+		size_type find_last_not_of(const_pointer s, size_type pos = npos) const noexcept {
+			return find_last_not_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_last_not_of(value_type ch, size_type pos = npos) const noexcept {
+			return find_last_not_of(&ch, pos, 1);
+		}
+
+		bool contains(const basic_string &str) const noexcept {
+			return find(str) != npos;
+		}
+
+		bool contains(const_pointer s) const noexcept {
+			return find(s) != npos;
+		}
+
+		bool contains(value_type ch) const noexcept {
+			return find(ch) != npos;
+		}
+
+		bool starts_with(const basic_string &str) const noexcept {
+			return starts_with(str.data(), str.size());
+		}
+
+		bool starts_with(const_pointer s) const noexcept {
+			return starts_with(s, traits_type::length(s));
+		}
+
+		bool starts_with(value_type ch) const noexcept {
+			return !empty() && traits_type::eq(front(), ch);
+		}
+
+		bool ends_with(const basic_string &str) const noexcept {
+			return ends_with(str.data(), str.size());
+		}
+
+		bool ends_with(const_pointer s) const noexcept {
+			return ends_with(s, traits_type::length(s));
+		}
+
+		bool ends_with(value_type ch) const noexcept {
+			return !empty() && traits_type::eq(back(), ch);
+		}
+
+		// 比较相关操作
+
+		int compare(const basic_string &str) const noexcept {
+			return compare_chars(data(), size(), str.data(), str.size());
+		}
+
+		int compare(size_type pos, size_type n, const basic_string &str) const {
+			return compare(pos, n, str.data(), str.size());
+		}
+
+		int compare(size_type pos1, size_type n1, const basic_string &str, size_type pos2, size_type n2 = npos) const {
+			THROW_OUT_OF_RANGE_IF(pos2 > str.size(), "basic_string : out of range");
+			return compare(pos1, n1, str.data() + pos2, wstl::min(n2, str.size() - pos2));
+		}
+
+		int compare(const_pointer s) const noexcept {
+			return compare_chars(data(), size(), s, traits_type::length(s));
+		}
+
+		int compare(size_type pos, size_type n1, const_pointer s) const {
+			return compare(pos, n1, s, traits_type::length(s));
+		}
+
+		int compare(size_type pos, size_type n1, const_pointer s, size_type n2) const {
+			THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string : out of range");
+			return compare_chars(data() + pos, wstl::min(n1, size() - pos), s, n2);
+		}
+
+	private:
+		// helper functions
+
+		// 长 / 短字符串状态
+
+		bool is_long() const noexcept {
+			return (reinterpret_cast<const unsigned char *>(&l_)[sizeof(long_rep) - 1] & 0x80) != 0;
+		}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		static size_type encode_cap(size_type cap) noexcept {
+			return (cap << 8) | 0x80;
+		}
+
+		static size_type decode_cap(size_type cap) noexcept {
+			return cap >> 8;
+		}
+#else
+		static size_type encode_cap(size_type cap) noexcept {
+			return cap | (static_cast<size_type>(1) << (sizeof(size_type) * 8 - 1));
+		}
+
+		static size_type decode_cap(size_type cap) noexcept {
+			return cap & (static_cast<size_type>(-1) >> 1);
+		}
+#endif
+
+		void set_short_size(size_type n) noexcept {
+			s_[sso_capacity] = static_cast<value_type>(sso_capacity - n);
+			s_[n] = value_type();
+		}
+
+		void set_long(pointer p, size_type n, size_type cap) noexcept {
+			l_.ptr = p;
+			l_.size = n;
+			l_.cap = encode_cap(cap);
+			p[n] = value_type();
+		}
+
+		void set_size(size_type n) noexcept {
+			if (is_long()) {
+				l_.size = n;
+				l_.ptr[n] = value_type();
+			} else {
+				set_short_size(n);
+			}
+		}
+
+		// s 是否指向当前字符串的内容
+		bool aliases(const_pointer s) const noexcept {
+			const auto p = data();
+			return !std::less<const_pointer>()(s, p) && !std::less<const_pointer>()(p + size(), s);
+		}
+
+		// initialize / destroy
+
+		pointer init_space(size_type n);
+
+		void copy_init(const_pointer s, size_type n);
+
+		void fill_init(size_type n, value_type ch);
+
+		template <class InputIterator>
+		void range_init(InputIterator first, InputIterator last, input_iterator_tag);
+
+		template <class ForwardIterator>
+		void range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+		void release() noexcept {
+			if (is_long()) {
+				data_allocator::deallocate(l_.ptr, decode_cap(l_.cap) + 1);
+			}
+		}
+
+		// calculate the growth size
+		size_type get_new_cap(size_type add_size) const;
+
+		size_type round_cap(size_type cap) const noexcept;
+
+		// reallocate
+
+		void reallocate(size_type new_cap);
+
+		void append_realloc(const_pointer s, size_type n);
+
+		pointer make_gap(size_type pos, size_type n1, size_type n2);
+
+		// compare / search
+
+		static int compare_chars(const_pointer s1, size_type n1, const_pointer s2, size_type n2) noexcept {
+			const auto result = traits_type::compare(s1, s2, wstl::min(n1, n2));
+			if (result != 0) {
+				return result;
+			}
+			return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+		}
+
+		bool starts_with(const_pointer s, size_type n) const noexcept {
+			return size() >= n && traits_type::compare(data(), s, n) == 0;
+		}
+
+		bool ends_with(const_pointer s, size_type n) const noexcept {
+			const auto sz = size();
+			return sz >= n && traits_type::compare(data() + sz - n, s, n) == 0;
+		}
+	};
+
+	template <class CharT, class Traits, class Alloc>
+	constexpr typename basic_string<CharT, Traits, Alloc>::size_type basic_string<CharT, Traits, Alloc>::npos;
+
+	template <class CharT, class Traits, class Alloc>
+	constexpr typename basic_string<CharT, Traits, Alloc>::size_type basic_string<CharT, Traits, Alloc>::sso_capacity;
+
+	/******************************************************************************************************/
+
+	// reserve, 容量不足时重新分配到恰好 n，不会缩小
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::reserve(size_type n) {
+		if (n > capacity()) {
+			THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string : exceed max_size() in basic_string::reserve");
+			reallocate(round_cap(n));
+		}
+	}
+
+	// shrink_to_fit, 能放进对象内部时回到短字符串
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::shrink_to_fit() {
+		if (!is_long()) {
+			return;
+		}
+		const auto n = l_.size;
+		if (n <= sso_capacity) {
+			const auto p = l_.ptr;
+			const auto cap = decode_cap(l_.cap);
+			traits_type::copy(s_, p, n);
+			set_short_size(n);
+			data_allocator::deallocate(p, cap + 1);
+		} else if (round_cap(n) < decode_cap(l_.cap)) {
+			reallocate(round_cap(n));
+		}
+	}
+
+	// assign, s 可以指向自身内容
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> &basic_string<CharT, Traits, Alloc>::assign(const_pointer s, size_type n) {
+		if (n <= capacity()) {
+			traits_type::move(data(), s, n);
+			set_size(n);
+		} else {
+			THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string : exceed max_size() in basic_string::assign");
+			const auto cap = round_cap(n);
+			auto p = data_allocator::allocate(cap + 1);
+			traits_type::copy(p, s, n);
+			release();
+			set_long(p, n, cap);
+		}
+		return *this;
+	}
+
+	// append, 在容量内直接复制，否则按 get_new_cap 扩容
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> &basic_string<CharT, Traits, Alloc>::append(const_pointer s, size_type n) {
+		const auto old_size = size();
+		if (n <= capacity() - old_size) {
+			if (n != 0) {
+				traits_type::copy(data() + old_size, s, n);
+				set_size(old_size + n);
+			}
+		} else {
+			append_realloc(s, n);
+		}
+		return *this;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> &basic_string<CharT, Traits, Alloc>::append(size_type n, value_type ch) {
+		const auto old_size = size();
+		if (n != 0) {
+			traits_type::assign(make_gap(old_size, 0, n), n, ch);
+		}
+		return *this;
+	}
+
+	// erase, 删除 [pos, pos + n)
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> &basic_string<CharT, Traits, Alloc>::erase(size_type pos, size_type n) {
+		const auto old_size = size();
+		THROW_OUT_OF_RANGE_IF(pos > old_size, "basic_string : out of range");
+		n = wstl::min(n, old_size - pos);
+		if (n != 0) {
+			auto p = data();
+			traits_type::move(p + pos, p + pos + n, old_size - pos - n);
+			set_size(old_size - n);
+		}
+		return *this;
+	}
+
+	// replace, 用 [s, s + n2) 替换 [pos, pos + n1)，s 可以指向自身内容
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> &
+	basic_string<CharT, Traits, Alloc>::replace(size_type pos, size_type n1, const_pointer s, size_type n2) {
+		const auto old_size = size();
+		THROW_OUT_OF_RANGE_IF(pos > old_size, "basic_string : out of range");
+		n1 = wstl::min(n1, old_size - pos);
+		if (n2 != 0 && aliases(s)) {
+			const basic_string tmp(s, n2);
+			return replace(pos, n1, tmp.data(), n2);
+		}
+		auto p = make_gap(pos, n1, n2);
+		if (n2 != 0) {
+			traits_type::copy(p, s, n2);
+		}
+		return *this;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> &
+	basic_string<CharT, Traits, Alloc>::replace(size_type pos, size_type n1, size_type n2, value_type ch) {
+		const auto old_size = size();
+		THROW_OUT_OF_RANGE_IF(pos > old_size, "basic_string : out of range");
+		n1 = wstl::min(n1, old_size - pos);
+		auto p = make_gap(pos, n1, n2);
+		if (n2 != 0) {
+			traits_type::assign(p, n2, ch);
+		}
+		return *this;
+	}
+
+	// resize
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::resize(size_type n, value_type ch) {
+		const auto old_size = size();
+		if (n <= old_size) {
+			set_size(n);
+		} else {
+			append(n - old_size, ch);
+		}
+	}
+
+	// resize_and_overwrite
+	template <class CharT, class Traits, class Alloc>
+	template <class Operation>
+	void basic_string<CharT, Traits, Alloc>::resize_and_overwrite(size_type n, Operation op) {
+		if (n > capacity()) {
+			THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string : exceed max_size() in basic_string::resize_and_overwrite");
+			const auto old_size = size();
+			reallocate(n > old_size ? get_new_cap(n - old_size) : round_cap(n));
+		}
+		const auto new_size = static_cast<size_type>(op(data(), n));
+		WSTL_DEBUG(new_size <= n);
+		set_size(new_size);
+	}
+
+	//******************************************************************** */
+	// helper function
+
+	// init_space, 为 n 个字符准备空间并设置长度，返回数据指针
+	template <class CharT, class Traits, class Alloc>
+	typename basic_string<CharT, Traits, Alloc>::pointer basic_string<CharT, Traits, Alloc>::init_space(size_type n) {
+		if (n <= sso_capacity) {
+			set_short_size(n);
+			return s_;
+		}
+		THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string : exceed max_size()");
+		const auto cap = round_cap(n);
+		auto p = data_allocator::allocate(cap + 1);
+		set_long(p, n, cap);
+		return p;
+	}
+
+	// copy_init
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::copy_init(const_pointer s, size_type n) {
+		traits_type::copy(init_space(n), s, n);
+	}
+
+	// fill_init
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::fill_init(size_type n, value_type ch) {
+		traits_type::assign(init_space(n), n, ch);
+	}
+
+	// range_init
+	template <class CharT, class Traits, class Alloc>
+	template <class InputIterator>
+	void basic_string<CharT, Traits, Alloc>::range_init(InputIterator first, InputIterator last, input_iterator_tag) {
+		set_short_size(0);
+		try {
+			for (; first != last; ++first) {
+				push_back(*first);
+			}
+		} catch (...) {
+			release();
+			throw;
+		}
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	template <class ForwardIterator>
+	void basic_string<CharT, Traits, Alloc>::range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		auto p = init_space(static_cast<size_type>(wstl::distance(first, last)));
+		try {
+			for (; first != last; ++first, ++p) {
+				traits_type::assign(*p, *first);
+			}
+		} catch (...) {
+			release();
+			throw;
+		}
+	}
+
+	// get_new_cap, 与 vector 相同的 1.5 倍增长，保证循环追加的均摊复杂度为 O(1)
+	template <class CharT, class Traits, class Alloc>
+	typename basic_string<CharT, Traits, Alloc>::size_type
+	basic_string<CharT, Traits, Alloc>::get_new_cap(size_type add_size) const {
+		const auto old_size = size();
+		THROW_LENGTH_ERROR_IF(add_size > max_size() - old_size, "basic_string : size too big in basic_string::get_new_cap");
+		const auto old_cap = capacity();
+		const auto grown = old_cap > max_size() - old_cap / 2 ? max_size() : old_cap + old_cap / 2;
+		const auto new_cap = wstl::max(wstl::max(grown, old_size + add_size), 2 * sso_capacity + 1);
+		return round_cap(new_cap);
+	}
+
+	// round_cap, 把分配的字节数（含结尾空字符）向上取整到 16 字节，多出的部分本来也会被 malloc 浪费
+	template <class CharT, class Traits, class Alloc>
+	typename basic_string<CharT, Traits, Alloc>::size_type
+	basic_string<CharT, Traits, Alloc>::round_cap(size_type cap) const noexcept {
+		const size_type unit = sizeof(value_type) >= 16 ? 1 : 16 / sizeof(value_type);
+		return wstl::min((cap + unit) / unit * unit - 1, max_size());
+	}
+
+	// reallocate, 移动到容量为 new_cap 的新空间
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::reallocate(size_type new_cap) {
+		const auto n = size();
+		WSTL_DEBUG(new_cap >= n);
+		auto p = data_allocator::allocate(new_cap + 1);
+		traits_type::copy(p, data(), n);
+		release();
+		set_long(p, n, new_cap);
+	}
+
+	// append_realloc, 扩容并追加，旧空间在复制完 s 之后才释放，因此 s 可以指向自身内容
+	template <class CharT, class Traits, class Alloc>
+	void basic_string<CharT, Traits, Alloc>::append_realloc(const_pointer s, size_type n) {
+		const auto old_size = size();
+		const auto new_cap = get_new_cap(n);
+		auto p = data_allocator::allocate(new_cap + 1);
+		traits_type::copy(p, data(), old_size);
+		traits_type::copy(p + old_size, s, n);
+		release();
+		set_long(p, old_size + n, new_cap);
+	}
+
+	// make_gap, 把 [pos, pos + n1) 替换为 n2 个未初始化字符，返回其起始位置
+	template <class CharT, class Traits, class Alloc>
+	typename basic_string<CharT, Traits, Alloc>::pointer
+	basic_string<CharT, Traits, Alloc>::make_gap(size_type pos, size_type n1, size_type n2) {
+		const auto old_size = size();
+		THROW_LENGTH_ERROR_IF(n2 > n1 && n2 - n1 > max_size() - old_size, "basic_string : size too big");
+		const auto new_size = old_size - n1 + n2;
+		const auto tail = old_size - pos - n1;
+		if (new_size <= capacity()) {
+			auto p = data();
+			if (n1 != n2 && tail != 0) {
+				traits_type::move(p + pos + n2, p + pos + n1, tail);
+			}
+			set_size(new_size);
+			return p + pos;
+		}
+		const auto new_cap = get_new_cap(new_size - old_size);
+		auto p = data_allocator::allocate(new_cap + 1);
+		const auto old = data();
+		traits_type::copy(p, old, pos);
+		traits_type::copy(p + pos + n2, old + pos + n1, tail);
+		release();
+		set_long(p, new_size, new_cap);
+		return p + pos;
+	}
+
+	/******************************************************************************************************/
+	// 重载 operator+
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(const basic_string<CharT, Traits, Alloc> &lhs,
+												 const basic_string<CharT, Traits, Alloc> &rhs) {
+		basic_string<CharT, Traits, Alloc> result;
+		result.reserve(lhs.size() + rhs.size());
+		result.append(lhs).append(rhs);
+		return result;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(basic_string<CharT, Traits, Alloc> &&lhs,
+												 const basic_string<CharT, Traits, Alloc> &rhs) {
+		return wstl::move(lhs.append(rhs));
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(const basic_string<CharT, Traits, Alloc> &lhs, const CharT *rhs) {
+		basic_string<CharT, Traits, Alloc> result(lhs);
+		return wstl::move(result.append(rhs));
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(basic_string<CharT, Traits, Alloc> &&lhs, const CharT *rhs) {
+		return wstl::move(lhs.append(rhs));
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(const CharT *lhs, const basic_string<CharT, Traits, Alloc> &rhs) {
+		basic_string<CharT, Traits, Alloc> result(lhs);
+		return wstl::move(result.append(rhs));
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(const basic_string<CharT, Traits, Alloc> &lhs, CharT rhs) {
+		basic_string<CharT, Traits, Alloc> result(lhs);
+		result.push_back(rhs);
+		return result;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	basic_string<CharT, Traits, Alloc> operator+(basic_string<CharT, Traits, Alloc> &&lhs, CharT rhs) {
+		lhs.push_back(rhs);
+		return wstl::move(lhs);
+	}
+
+	// 重载比较操作符
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator==(const basic_string<CharT, Traits, Alloc> &lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return lhs.size() == rhs.size() && Traits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator==(const basic_string<CharT, Traits, Alloc> &lhs, const CharT *rhs) noexcept {
+		return lhs.compare(rhs) == 0;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator==(const CharT *lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return rhs.compare(lhs) == 0;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator!=(const basic_string<CharT, Traits, Alloc> &lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator!=(const basic_string<CharT, Traits, Alloc> &lhs, const CharT *rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator!=(const CharT *lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator<(const basic_string<CharT, Traits, Alloc> &lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return lhs.compare(rhs) < 0;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator>(const basic_string<CharT, Traits, Alloc> &lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return rhs < lhs;
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator<=(const basic_string<CharT, Traits, Alloc> &lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return !(rhs < lhs);
+	}
+
+	template <class CharT, class Traits, class Alloc>
+	bool operator>=(const basic_string<CharT, Traits, Alloc> &lhs, const basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		return !(lhs < rhs);
+	}
+
+	// 重载 swap
+	template <class CharT, class Traits, class Alloc>
+	void swap(basic_string<CharT, Traits, Alloc> &lhs, basic_string<CharT, Traits, Alloc> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+	// 输出到流
+	template <class CharT, class Traits, class Alloc>
+	std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os,
+												  const basic_string<CharT, Traits, Alloc> &str) {
+		return os.write(str.data(), static_cast<std::streamsize>(str.size()));
+	}
+
+	typedef basic_string<char> string;
+	typedef basic_string<wchar_t> wstring;
+	typedef basic_string<char16_t> u16string;
+	typedef basic_string<char32_t> u32string;
+} // namespace wstl
+
+namespace std {
+	// 哈希，使 basic_string 可以作为 unordered 容器与 concurrent_hash_map 的键
+	template <class CharT, class Alloc>
+	struct hash<wstl::basic_string<CharT, std::char_traits<CharT>, Alloc>> {
+		size_t operator()(const wstl::basic_string<CharT, std::char_traits<CharT>, Alloc> &str) const noexcept {
+			return wstl::hash_bytes(str.data(), str.size() * sizeof(CharT));
+		}
+	};
+} // namespace std
+
+#endif // WSTL_BASIC_STRING_H
@@ -0,0 +1,912 @@
+#ifndef WSTL_BITSET_H
+#define WSTL_BITSET_H
+
+/*
+	该文件实现位集合：定长的 bitset<N>、变长的 dynamic_bitset<Alloc>、带两级摘要的 hierarchical_bitset<Alloc>
+
+	存储与运算：
+		三者都以 64 位字存放，最后一个字中超出 size() 的位始终为 0。
+		count 使用 popcount，find_first / find_next 逐字跳过全 0 的字并用 tzcnt（count trailing zeros）定位，
+		编译时开启 -mpopcnt / -mbmi（或 -march=native）会生成对应的单条指令。
+		与另一个位集合的 &=、|=、^=、and_not 按字批量计算，开启 AVX2 时每次处理 4 个字，否则使用 SSE2 每次 2 个字。
+
+	遍历：
+		for (auto i = b.find_first(); i < b.size(); i = b.find_next(i)) { ... }
+		或 b.for_each([](size_t i) { ... })，后者直接在字内逐个取出最低位的 1，少一次查找。
+
+	hierarchical_bitset：
+		在位数组之上维护两级摘要：summary 的第 i 位表示第 i 个字不为 0，top 的第 j 位表示 summary 的第 j 个字不为 0。
+		查找下一个 1 时先看当前字，再看 summary，最后在 top 中定位，一次最多跳过 64 * 64 个全 0 的字（26 万位），
+		稀疏集合（例如数千万个 ID 中只有少数命中）的遍历时间与 1 的个数成正比，而不是与位数成正比。
+		代价是 set / reset 需要同时维护摘要，批量运算之后整体重建一次摘要。
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define WSTL_BITSET_AVX2 1
+#elif defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define WSTL_BITSET_SSE2 1
+#endif
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "vector.h"
+
+namespace wstl {
+
+	/*****************************************************************************************/
+	// 									按字运算的辅助函数
+	/*****************************************************************************************/
+
+	constexpr size_t bits_per_word = 64;
+
+	// bit_word_count, 存放 n 位需要的字数
+	constexpr size_t bit_word_count(size_t n) noexcept {
+		return (n + bits_per_word - 1) / bits_per_word;
+	}
+
+	// bit_tail_mask, 最后一个字中有效位的掩码，n 为 64 的倍数时为全 1
+	constexpr uint64_t bit_tail_mask(size_t n) noexcept {
+		return n % bits_per_word == 0 ? ~uint64_t(0) : (uint64_t(1) << (n % bits_per_word)) - 1;
+	}
+
+	// bit_popcount, x 中 1 的个数
+	// 没有开启 popcnt 指令时 __builtin_popcountll 是一次库函数调用，不如内联的位运算快
+	inline size_t bit_popcount(uint64_t x) noexcept {
+#if defined(__POPCNT__) && (defined(__GNUC__) || defined(__clang__))
+		return static_cast<size_t>(__builtin_popcountll(x));
+#else
+		x = x - ((x >> 1) & 0x5555555555555555ull);
+		x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+		x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+		return static_cast<size_t>((x * 0x0101010101010101ull) >> 56);
+#endif
+	}
+
+	// bit_ctz, x 最低位的 1 的下标，x 不能为 0
+	inline size_t bit_ctz(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_ctzll(x));
+#else
+		size_t n = 0;
+		while ((x & 1) == 0) {
+			x >>= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	// bit_count_words, words[0, n) 中 1 的个数
+	inline size_t bit_count_words(const uint64_t *words, size_t n) noexcept {
+		size_t count = 0;
+		for (size_t i = 0; i < n; ++i) {
+			count += bit_popcount(words[i]);
+		}
+		return count;
+	}
+
+	// bit_find_from, words[0, n) 中下标不小于 pos 的第一个 1，找不到时返回 n * 64
+	inline size_t bit_find_from(const uint64_t *words, size_t n, size_t pos) noexcept {
+		auto w = pos / bits_per_word;
+		if (w >= n) {
+			return n * bits_per_word;
+		}
+		auto word = words[w] & (~uint64_t(0) << (pos % bits_per_word));
+		while (word == 0) {
+			if (++w == n) {
+				return n * bits_per_word;
+			}
+			word = words[w];
+		}
+		return w * bits_per_word + bit_ctz(word);
+	}
+
+	// bit_for_each_words, 按从低到高的顺序对每个 1 的下标调用 f
+	template <class Function>
+	void bit_for_each_words(const uint64_t *words, size_t n, Function f) {
+		for (size_t w = 0; w < n; ++w) {
+			for (auto word = words[w]; word != 0; word &= word - 1) {
+				f(w * bits_per_word + bit_ctz(word));
+			}
+		}
+	}
+
+	// 批量按字运算：dst[i] = op(dst[i], src[i])，op 同时提供标量与 SIMD 两个版本
+
+	struct bit_and_op {
+		uint64_t operator()(uint64_t a, uint64_t b) const noexcept {
+			return a & b;
+		}
+#if defined(WSTL_BITSET_AVX2)
+		__m256i operator()(__m256i a, __m256i b) const noexcept {
+			return _mm256_and_si256(a, b);
+		}
+#elif defined(WSTL_BITSET_SSE2)
+		__m128i operator()(__m128i a, __m128i b) const noexcept {
+			return _mm_and_si128(a, b);
+		}
+#endif
+	};
+
+	struct bit_or_op {
+		uint64_t operator()(uint64_t a, uint64_t b) const noexcept {
+			return a | b;
+		}
+#if defined(WSTL_BITSET_AVX2)
+		__m256i operator()(__m256i a, __m256i b) const noexcept {
+			return _mm256_or_si256(a, b);
+		}
+#elif defined(WSTL_BITSET_SSE2)
+		__m128i operator()(__m128i a, __m128i b) const noexcept {
+			return _mm_or_si128(a, b);
+		}
+#endif
+	};
+
+	struct bit_xor_op {
+		uint64_t operator()(uint64_t a, uint64_t b) const noexcept {
+			return a ^ b;
+		}
+#if defined(WSTL_BITSET_AVX2)
+		__m256i operator()(__m256i a, __m256i b) const noexcept {
+			return _mm256_xor_si256(a, b);
+		}
+#elif defined(WSTL_BITSET_SSE2)
+		__m128i operator()(__m128i a, __m128i b) const noexcept {
+			return _mm_xor_si128(a, b);
+		}
+#endif
+	};
+
+	// a & ~b
+	struct bit_andnot_op {
+		uint64_t operator()(uint64_t a, uint64_t b) const noexcept {
+			return a & ~b;
+		}
+#if defined(WSTL_BITSET_AVX2)
+		__m256i operator()(__m256i a, __m256i b) const noexcept {
+			return _mm256_andnot_si256(b, a);
+		}
+#elif defined(WSTL_BITSET_SSE2)
+		__m128i operator()(__m128i a, __m128i b) const noexcept {
+			return _mm_andnot_si128(b, a);
+		}
+#endif
+	};
+
+	template <class Op>
+	void bit_apply_words(uint64_t *dst, const uint64_t *src, size_t n, Op op) noexcept {
+		size_t i = 0;
+#if defined(WSTL_BITSET_AVX2)
+		for (; i + 4 <= n; i += 4) {
+			const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+			const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), op(a, b));
+		}
+#elif defined(WSTL_BITSET_SSE2)
+		for (; i + 2 <= n; i += 2) {
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), op(a, b));
+		}
+#endif
+		for (; i < n; ++i) {
+			dst[i] = op(dst[i], src[i]);
+		}
+	}
+
+	/*****************************************************************************************/
+	// 									bitset<N>
+	/*****************************************************************************************/
+
+	template <size_t N>
+	class bitset {
+	public:
+		typedef size_t size_type;
+
+		static constexpr size_type word_count = bit_word_count(N) == 0 ? 1 : bit_word_count(N);
+
+	private:
+		uint64_t words_[word_count];
+
+	public:
+		bitset() noexcept : words_() {}
+
+		// 低 64 位取自 value
+		bitset(uint64_t value) noexcept : words_() {
+			words_[0] = N < bits_per_word ? value & bit_tail_mask(N) : value;
+		}
+
+		// 容量与查询
+
+		constexpr size_type size() const noexcept {
+			return N;
+		}
+
+		bool test(size_type pos) const {
+			THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N> : out of range");
+			return (*this)[pos];
+		}
+
+		bool operator[](size_type pos) const noexcept {
+			WSTL_DEBUG(pos < N);
+			return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+		}
+
+		size_type count() const noexcept {
+			return bit_count_words(words_, word_count);
+		}
+
+		bool any() const noexcept {
+			for (size_type i = 0; i < word_count; ++i) {
+				if (words_[i] != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool none() const noexcept {
+			return !any();
+		}
+
+		bool all() const noexcept {
+			return count() == N;
+		}
+
+		// 查找：找不到时返回 size()
+
+		size_type find_first() const noexcept {
+			return clamp(bit_find_from(words_, word_count, 0));
+		}
+
+		size_type find_next(size_type pos) const noexcept {
+			return clamp(bit_find_from(words_, word_count, pos + 1));
+		}
+
+		template <class Function>
+		void for_each(Function f) const {
+			bit_for_each_words(words_, word_count, f);
+		}
+
+		// 修改
+
+		bitset &set() noexcept {
+			for (size_type i = 0; i < word_count; ++i) {
+				words_[i] = ~uint64_t(0);
+			}
+			trim();
+			return *this;
+		}
+
+		bitset &set(size_type pos, bool value = true) {
+			THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N> : out of range");
+			const auto mask = uint64_t(1) << (pos % bits_per_word);
+			if (value) {
+				words_[pos / bits_per_word] |= mask;
+			} else {
+				words_[pos / bits_per_word] &= ~mask;
+			}
+			return *this;
+		}
+
+		bitset &reset() noexcept {
+			for (size_type i = 0; i < word_count; ++i) {
+				words_[i] = 0;
+			}
+			return *this;
+		}
+
+		bitset &reset(size_type pos) {
+			return set(pos, false);
+		}
+
+		bitset &flip() noexcept {
+			for (size_type i = 0; i < word_count; ++i) {
+				words_[i] = ~words_[i];
+			}
+			trim();
+			return *this;
+		}
+
+		bitset &flip(size_type pos) {
+			THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N> : out of range");
+			words_[pos / bits_per_word] ^= uint64_t(1) << (pos % bits_per_word);
+			return *this;
+		}
+
+		// 批量运算
+
+		bitset &operator&=(const bitset &rhs) noexcept {
+			bit_apply_words(words_, rhs.words_, word_count, bit_and_op());
+			return *this;
+		}
+
+		bitset &operator|=(const bitset &rhs) noexcept {
+			bit_apply_words(words_, rhs.words_, word_count, bit_or_op());
+			return *this;
+		}
+
+		bitset &operator^=(const bitset &rhs) noexcept {
+			bit_apply_words(words_, rhs.words_, word_count, bit_xor_op());
+			return *this;
+		}
+
+		// and_not, 去掉 rhs 中为 1 的位（*this &= ~rhs）
+		bitset &and_not(const bitset &rhs) noexcept {
+			bit_apply_words(words_, rhs.words_, word_count, bit_andnot_op());
+			return *this;
+		}
+
+		bitset operator~() const noexcept {
+			bitset tmp(*this);
+			return tmp.flip();
+		}
+
+		bool operator==(const bitset &rhs) const noexcept {
+			return std::memcmp(words_, rhs.words_, sizeof(words_)) == 0;
+		}
+
+		bool operator!=(const bitset &rhs) const noexcept {
+			return !(*this == rhs);
+		}
+
+		// 底层的字
+
+		uint64_t *data() noexcept {
+			return words_;
+		}
+
+		const uint64_t *data() const noexcept {
+			return words_;
+		}
+
+	private:
+		// 清除最后一个字中超出 N 的位
+		void trim() noexcept {
+			words_[word_count - 1] &= N == 0 ? 0 : bit_tail_mask(N);
+		}
+
+		static size_type clamp(size_type pos) noexcept {
+			return pos < N ? pos : N;
+		}
+	};
+
+	template <size_t N>
+	constexpr typename bitset<N>::size_type bitset<N>::word_count;
+
+	template <size_t N>
+	bitset<N> operator&(const bitset<N> &lhs, const bitset<N> &rhs) noexcept {
+		bitset<N> tmp(lhs);
+		return tmp &= rhs;
+	}
+
+	template <size_t N>
+	bitset<N> operator|(const bitset<N> &lhs, const bitset<N> &rhs) noexcept {
+		bitset<N> tmp(lhs);
+		return tmp |= rhs;
+	}
+
+	template <size_t N>
+	bitset<N> operator^(const bitset<N> &lhs, const bitset<N> &rhs) noexcept {
+		bitset<N> tmp(lhs);
+		return tmp ^= rhs;
+	}
+
+	/*****************************************************************************************/
+	// 									dynamic_bitset
+	/*****************************************************************************************/
+
+	template <class Alloc = wstl::allocator<uint64_t>>
+	class dynamic_bitset {
+	public:
+		typedef Alloc allocator_type;
+		typedef size_t size_type;
+
+	private:
+		vector<uint64_t, Alloc> words_;
+		size_type size_;
+
+	public:
+		dynamic_bitset() noexcept : size_(0) {}
+
+		explicit dynamic_bitset(size_type n, bool value = false)
+			: words_(bit_word_count(n), value ? ~uint64_t(0) : 0), size_(n) {
+			trim();
+		}
+
+		// 容量与查询
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		size_type num_words() const noexcept {
+			return words_.size();
+		}
+
+		// resize, 新增的位取 value
+		void resize(size_type n, bool value = false);
+
+		void push_back(bool value) {
+			resize(size_ + 1, value);
+		}
+
+		void clear() noexcept {
+			words_.clear();
+			size_ = 0;
+		}
+
+		bool test(size_type pos) const {
+			THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset : out of range");
+			return (*this)[pos];
+		}
+
+		bool operator[](size_type pos) const noexcept {
+			WSTL_DEBUG(pos < size_);
+			return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+		}
+
+		size_type count() const noexcept {
+			return bit_count_words(words_.data(), words_.size());
+		}
+
+		bool any() const noexcept {
+			for (auto it = words_.begin(); it != words_.end(); ++it) {
+				if (*it != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool none() const noexcept {
+			return !any();
+		}
+
+		bool all() const noexcept {
+			return count() == size_;
+		}
+
+		// 查找：找不到时返回 size()
+
+		size_type find_first() const noexcept {
+			return clamp(bit_find_from(words_.data(), words_.size(), 0));
+		}
+
+		size_type find_next(size_type pos) const noexcept {
+			return clamp(bit_find_from(words_.data(), words_.size(), pos + 1));
+		}
+
+		template <class Function>
+		void for_each(Function f) const {
+			bit_for_each_words(words_.data(), words_.size(), f);
+		}
+
+		// 修改
+
+		dynamic_bitset &set() noexcept {
+			wstl::fill(words_.begin(), words_.end(), ~uint64_t(0));
+			trim();
+			return *this;
+		}
+
+		dynamic_bitset &set(size_type pos, bool value = true) {
+			THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset : out of range");
+			const auto mask = uint64_t(1) << (pos % bits_per_word);
+			if (value) {
+				words_[pos / bits_per_word] |= mask;
+			} else {
+				words_[pos / bits_per_word] &= ~mask;
+			}
+			return *this;
+		}
+
+		dynamic_bitset &reset() noexcept {
+			wstl::fill(words_.begin(), words_.end(), uint64_t(0));
+			return *this;
+		}
+
+		dynamic_bitset &reset(size_type pos) {
+			return set(pos, false);
+		}
+
+		dynamic_bitset &flip() noexcept {
+			for (auto it = words_.begin(); it != words_.end(); ++it) {
+				*it = ~*it;
+			}
+			trim();
+			return *this;
+		}
+
+		dynamic_bitset &flip(size_type pos) {
+			THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset : out of range");
+			words_[pos / bits_per_word] ^= uint64_t(1) << (pos % bits_per_word);
+			return *this;
+		}
+
+		// 批量运算，两边的 size() 必须相同
+
+		dynamic_bitset &operator&=(const dynamic_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_and_op());
+			return *this;
+		}
+
+		dynamic_bitset &operator|=(const dynamic_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_or_op());
+			return *this;
+		}
+
+		dynamic_bitset &operator^=(const dynamic_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_xor_op());
+			return *this;
+		}
+
+		dynamic_bitset &and_not(const dynamic_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_andnot_op());
+			return *this;
+		}
+
+		dynamic_bitset operator~() const {
+			dynamic_bitset tmp(*this);
+			return tmp.flip();
+		}
+
+		bool operator==(const dynamic_bitset &rhs) const noexcept {
+			return size_ == rhs.size_ && words_ == rhs.words_;
+		}
+
+		bool operator!=(const dynamic_bitset &rhs) const noexcept {
+			return !(*this == rhs);
+		}
+
+		void swap(dynamic_bitset &rhs) noexcept {
+			words_.swap(rhs.words_);
+			wstl::swap(size_, rhs.size_);
+		}
+
+		// 底层的字
+
+		uint64_t *data() noexcept {
+			return words_.data();
+		}
+
+		const uint64_t *data() const noexcept {
+			return words_.data();
+		}
+
+	private:
+		void trim() noexcept {
+			if (!words_.empty()) {
+				words_.back() &= bit_tail_mask(size_);
+			}
+		}
+
+		size_type clamp(size_type pos) const noexcept {
+			return pos < size_ ? pos : size_;
+		}
+	};
+
+	template <class Alloc>
+	void dynamic_bitset<Alloc>::resize(size_type n, bool value) {
+		const auto old_size = size_;
+		// 先补齐原来最后一个字中新增的位
+		if (value && n > old_size && old_size % bits_per_word != 0) {
+			words_.back() |= ~bit_tail_mask(old_size);
+		}
+		words_.resize(bit_word_count(n), value ? ~uint64_t(0) : 0);
+		size_ = n;
+		trim();
+	}
+
+	template <class Alloc>
+	dynamic_bitset<Alloc> operator&(const dynamic_bitset<Alloc> &lhs, const dynamic_bitset<Alloc> &rhs) {
+		dynamic_bitset<Alloc> tmp(lhs);
+		return tmp &= rhs;
+	}
+
+	template <class Alloc>
+	dynamic_bitset<Alloc> operator|(const dynamic_bitset<Alloc> &lhs, const dynamic_bitset<Alloc> &rhs) {
+		dynamic_bitset<Alloc> tmp(lhs);
+		return tmp |= rhs;
+	}
+
+	template <class Alloc>
+	dynamic_bitset<Alloc> operator^(const dynamic_bitset<Alloc> &lhs, const dynamic_bitset<Alloc> &rhs) {
+		dynamic_bitset<Alloc> tmp(lhs);
+		return tmp ^= rhs;
+	}
+
+	template <class Alloc>
+	void swap(dynamic_bitset<Alloc> &lhs, dynamic_bitset<Alloc> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+	/*****************************************************************************************/
+	// 									hierarchical_bitset
+	/*****************************************************************************************/
+
+	template <class Alloc = wstl::allocator<uint64_t>>
+	class hierarchical_bitset {
+	public:
+		typedef Alloc allocator_type;
+		typedef size_t size_type;
+
+	private:
+		vector<uint64_t, Alloc> words_;   // 位数组
+		vector<uint64_t, Alloc> summary_; // 第 i 位：words_[i] != 0
+		vector<uint64_t, Alloc> top_;	  // 第 j 位：summary_[j] != 0
+		size_type size_;
+
+	public:
+		hierarchical_bitset() noexcept : size_(0) {}
+
+		explicit hierarchical_bitset(size_type n)
+			: words_(bit_word_count(n), 0), summary_(bit_word_count(bit_word_count(n)), 0),
+			  top_(bit_word_count(bit_word_count(bit_word_count(n))), 0), size_(n) {}
+
+		// 容量与查询
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		// resize, 新增的位为 0
+		void resize(size_type n);
+
+		bool test(size_type pos) const {
+			THROW_OUT_OF_RANGE_IF(pos >= size_, "hierarchical_bitset : out of range");
+			return (*this)[pos];
+		}
+
+		bool operator[](size_type pos) const noexcept {
+			WSTL_DEBUG(pos < size_);
+			return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+		}
+
+		// count, 只访问非 0 的字
+		size_type count() const noexcept {
+			size_type n = 0;
+			for_each_word([this, &n](size_type w) { n += bit_popcount(words_[w]); });
+			return n;
+		}
+
+		bool any() const noexcept {
+			for (auto it = top_.begin(); it != top_.end(); ++it) {
+				if (*it != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool none() const noexcept {
+			return !any();
+		}
+
+		// 查找：找不到时返回 size()
+
+		size_type find_first() const noexcept {
+			return find_from(0);
+		}
+
+		size_type find_next(size_type pos) const noexcept {
+			return find_from(pos + 1);
+		}
+
+		template <class Function>
+		void for_each(Function f) const {
+			for_each_word([this, &f](size_type w) {
+				for (auto word = words_[w]; word != 0; word &= word - 1) {
+					f(w * bits_per_word + bit_ctz(word));
+				}
+			});
+		}
+
+		// 修改
+
+		hierarchical_bitset &set(size_type pos, bool value = true);
+
+		hierarchical_bitset &reset(size_type pos) {
+			return set(pos, false);
+		}
+
+		// reset, 只清零非 0 的字
+		hierarchical_bitset &reset() noexcept {
+			for_each_word([this](size_type w) { words_[w] = 0; });
+			wstl::fill(summary_.begin(), summary_.end(), uint64_t(0));
+			wstl::fill(top_.begin(), top_.end(), uint64_t(0));
+			return *this;
+		}
+
+		// 批量运算，两边的 size() 必须相同，运算后重建摘要
+
+		hierarchical_bitset &operator&=(const hierarchical_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_and_op());
+			rebuild_summary();
+			return *this;
+		}
+
+		hierarchical_bitset &operator|=(const hierarchical_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_or_op());
+			rebuild_summary();
+			return *this;
+		}
+
+		hierarchical_bitset &operator^=(const hierarchical_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_xor_op());
+			rebuild_summary();
+			return *this;
+		}
+
+		hierarchical_bitset &and_not(const hierarchical_bitset &rhs) noexcept {
+			WSTL_DEBUG(size_ == rhs.size_);
+			bit_apply_words(words_.data(), rhs.words_.data(), words_.size(), bit_andnot_op());
+			rebuild_summary();
+			return *this;
+		}
+
+		bool operator==(const hierarchical_bitset &rhs) const noexcept {
+			return size_ == rhs.size_ && words_ == rhs.words_;
+		}
+
+		bool operator!=(const hierarchical_bitset &rhs) const noexcept {
+			return !(*this == rhs);
+		}
+
+		void swap(hierarchical_bitset &rhs) noexcept {
+			words_.swap(rhs.words_);
+			summary_.swap(rhs.summary_);
+			top_.swap(rhs.top_);
+			wstl::swap(size_, rhs.size_);
+		}
+
+		const uint64_t *data() const noexcept {
+			return words_.data();
+		}
+
+	private:
+		// helper functions
+
+		size_type find_from(size_type pos) const noexcept;
+
+		size_type next_word(size_type w) const noexcept;
+
+		template <class Function>
+		void for_each_word(Function f) const;
+
+		void rebuild_summary() noexcept;
+	};
+
+	// resize
+	template <class Alloc>
+	void hierarchical_bitset<Alloc>::resize(size_type n) {
+		const auto words = bit_word_count(n);
+		words_.resize(words, 0);
+		summary_.resize(bit_word_count(words), 0);
+		top_.resize(bit_word_count(bit_word_count(words)), 0);
+		size_ = n;
+		if (!words_.empty()) {
+			words_.back() &= bit_tail_mask(n);
+		}
+		rebuild_summary();
+	}
+
+	// set, 字由 0 变为非 0 或由非 0 变为 0 时同步更新摘要
+	template <class Alloc>
+	hierarchical_bitset<Alloc> &hierarchical_bitset<Alloc>::set(size_type pos, bool value) {
+		THROW_OUT_OF_RANGE_IF(pos >= size_, "hierarchical_bitset : out of range");
+		const auto w = pos / bits_per_word;
+		const auto s = w / bits_per_word;
+		const auto mask = uint64_t(1) << (pos % bits_per_word);
+		if (value) {
+			if (words_[w] == 0) {
+				summary_[s] |= uint64_t(1) << (w % bits_per_word);
+				top_[s / bits_per_word] |= uint64_t(1) << (s % bits_per_word);
+			}
+			words_[w] |= mask;
+		} else if (words_[w] & mask) {
+			words_[w] &= ~mask;
+			if (words_[w] == 0) {
+				summary_[s] &= ~(uint64_t(1) << (w % bits_per_word));
+				if (summary_[s] == 0) {
+					top_[s / bits_per_word] &= ~(uint64_t(1) << (s % bits_per_word));
+				}
+			}
+		}
+		return *this;
+	}
+
+	// helper function
+
+	// find_from, 下标不小于 pos 的第一个 1
+	template <class Alloc>
+	typename hierarchical_bitset<Alloc>::size_type hierarchical_bitset<Alloc>::find_from(size_type pos) const noexcept {
+		if (pos >= size_) {
+			return size_;
+		}
+		const auto w = pos / bits_per_word;
+		const auto word = words_[w] & (~uint64_t(0) << (pos % bits_per_word));
+		if (word != 0) {
+			return w * bits_per_word + bit_ctz(word);
+		}
+		const auto next = next_word(w + 1);
+		return next == words_.size() ? size_ : next * bits_per_word + bit_ctz(words_[next]);
+	}
+
+	// next_word, 下标不小于 w 的第一个非 0 的字，找不到时返回字数
+	template <class Alloc>
+	typename hierarchical_bitset<Alloc>::size_type hierarchical_bitset<Alloc>::next_word(size_type w) const noexcept {
+		const auto s = w / bits_per_word;
+		if (s >= summary_.size()) {
+			return words_.size();
+		}
+		const auto bits = summary_[s] & (~uint64_t(0) << (w % bits_per_word));
+		if (bits != 0) {
+			return s * bits_per_word + bit_ctz(bits);
+		}
+		// 在 top 中找到下一个非 0 的摘要字
+		const auto next = bit_find_from(top_.data(), top_.size(), s + 1);
+		if (next >= summary_.size()) {
+			return words_.size();
+		}
+		return next * bits_per_word + bit_ctz(summary_[next]);
+	}
+
+	// for_each_word, 按顺序对每个非 0 的字的下标调用 f，由 top 与 summary 逐级定位
+	template <class Alloc>
+	template <class Function>
+	void hierarchical_bitset<Alloc>::for_each_word(Function f) const {
+		bit_for_each_words(top_.data(), top_.size(), [this, &f](size_type s) {
+			for (auto bits = summary_[s]; bits != 0; bits &= bits - 1) {
+				f(s * bits_per_word + bit_ctz(bits));
+			}
+		});
+	}
+
+	// rebuild_summary, 按位数组重建两级摘要
+	template <class Alloc>
+	void hierarchical_bitset<Alloc>::rebuild_summary() noexcept {
+		wstl::fill(summary_.begin(), summary_.end(), uint64_t(0));
+		wstl::fill(top_.begin(), top_.end(), uint64_t(0));
+		for (size_type w = 0; w < words_.size(); ++w) {
+			if (words_[w] != 0) {
+				summary_[w / bits_per_word] |= uint64_t(1) << (w % bits_per_word);
+			}
+		}
+		for (size_type s = 0; s < summary_.size(); ++s) {
+			if (summary_[s] != 0) {
+				top_[s / bits_per_word] |= uint64_t(1) << (s % bits_per_word);
+			}
+		}
+	}
+
+	template <class Alloc>
+	void swap(hierarchical_bitset<Alloc> &lhs, hierarchical_bitset<Alloc> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_BITSET_H
@@ -0,0 +1,594 @@
+#ifndef WSTL_CONCURRENT_HASH_MAP_H
+#define WSTL_CONCURRENT_HASH_MAP_H
+
+/*
+	该文件实现 concurrent_hash_map：分片加锁的开放寻址哈希表
+
+	键按哈希值高位分配到 2 的幂个分片（shard），每个分片是一张独立的开放寻址表，
+	由自己的读写自旋锁保护，锁字各自独占缓存行。读操作只获取所在分片的读锁，
+	不同分片之间没有任何共享写入，因此读操作可以随线程数近似线性扩展。
+
+	分片内部采用分组探测：每 8 个槽位为一组，每个槽位对应一个控制字节
+		empty    0x80
+		deleted  0xFE
+		full     0x00 ~ 0x7F（哈希值低 7 位）
+	查找时一次读入 8 个控制字节，用 SWAR 位运算同时比较整组，只对候选槽位比较键值。
+	组之间使用三角数探测，分片按 7/8 的装载因子独立扩容。
+
+	所有公有成员函数都是线程安全的。由于元素可能被其他线程修改或删除，
+	接口不返回元素的引用：find 拷贝出值，visit / modify 在持锁期间对元素调用函数对象。
+
+	异常保证：
+	当 std::is_nothrow_move_constructible<value_type>::value 为 true 时，
+	insert，emplace，insert_or_assign，upsert 提供强异常安全保证。
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "sync.h"
+#include "util.h"
+
+namespace wstl {
+
+	// concurrent_hash_map 类模板
+	template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+			  class Alloc = wstl::allocator<wstl::pair<Key, T>>>
+	class concurrent_hash_map {
+	public:
+		// concurrent_hash_map 的嵌套型别定义
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef Hash hasher;
+		typedef KeyEqual key_equal;
+		typedef Alloc allocator_type;
+		typedef Alloc data_allocator;
+
+		typedef typename allocator_type::value_type value_type;
+		typedef typename allocator_type::size_type size_type;
+		typedef typename allocator_type::difference_type difference_type;
+
+	private:
+		typedef unsigned char ctrl_type;
+		typedef wstl::allocator<ctrl_type> ctrl_allocator;
+		typedef value_type *slot_pointer;
+
+		static constexpr ctrl_type ctrl_empty = 0x80;
+		static constexpr ctrl_type ctrl_deleted = 0xFE;
+		static constexpr size_type group_width = 8;
+
+		// 单个分片：一张开放寻址表
+		struct shard_base {
+			mutable spin_rw_lock lock;
+			ctrl_type *ctrl;
+			slot_pointer slots;
+			size_type capacity;	   // 槽位数，0 或 group_width 的 2 的幂倍
+			size_type growth_left; // 还能占用多少个 empty 槽位
+			std::atomic<size_type> size;
+		};
+
+		// 填充到缓存行的整数倍，避免相邻分片的锁字伪共享
+		struct shard : shard_base {
+			char pad[cache_line_size - sizeof(shard_base) % cache_line_size];
+		};
+
+		typedef wstl::allocator<shard> shard_allocator;
+
+		shard *shards_;
+		size_type shard_mask_;
+		size_type shard_shift_;
+		hasher hash_;
+		key_equal equal_;
+
+	public:
+		// 构造、析构函数
+
+		// shard_count 向上取整为 2 的幂，建议不少于并发线程数的数倍
+		explicit concurrent_hash_map(size_type shard_count = 64, const hasher &hash = hasher(),
+									 const key_equal &equal = key_equal());
+
+		concurrent_hash_map(const concurrent_hash_map &) = delete;
+		concurrent_hash_map &operator=(const concurrent_hash_map &) = delete;
+
+		~concurrent_hash_map();
+
+	public:
+		// 容量相关操作
+
+		// 并发修改时只是一个近似值
+		size_type size() const noexcept;
+
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		size_type shard_count() const noexcept {
+			return shard_mask_ + 1;
+		}
+
+		// reserve, 为 n 个元素预留空间（按分片平均分配）
+		void reserve(size_type n);
+
+		// 查找相关操作
+
+		bool find(const key_type &key, mapped_type &out) const;
+
+		bool contains(const key_type &key) const;
+
+		size_type count(const key_type &key) const {
+			return contains(key) ? 1 : 0;
+		}
+
+		// visit, 持读锁对元素调用 f(const mapped_type&)，返回是否找到
+		template <class Function>
+		bool visit(const key_type &key, Function f) const;
+
+		// modify, 持写锁对元素调用 f(mapped_type&)，返回是否找到
+		template <class Function>
+		bool modify(const key_type &key, Function f);
+
+		// 修改容器相关操作
+
+		// insert / emplace, 键不存在时插入，返回是否插入
+		bool insert(const value_type &value) {
+			return emplace(value.first, value.second);
+		}
+
+		bool insert(const key_type &key, const mapped_type &value) {
+			return emplace(key, value);
+		}
+
+		template <class... Args>
+		bool emplace(const key_type &key, Args &&...args);
+
+		// insert_or_assign, 键存在时赋值，否则插入，返回是否插入
+		template <class M>
+		bool insert_or_assign(const key_type &key, M &&value);
+
+		// upsert, 键存在时调用 update(mapped_type&)，否则以 args 构造新值插入，返回是否插入
+		template <class Function, class... Args>
+		bool upsert(const key_type &key, Function update, Args &&...args);
+
+		// erase, 删除键，返回是否删除
+		bool erase(const key_type &key);
+
+		void clear();
+
+		// for_each, 逐个分片持读锁遍历，调用 f(const key_type&, const mapped_type&)
+		template <class Function>
+		void for_each(Function f) const;
+
+	private:
+		// helper functions
+
+		size_type hash_of(const key_type &key) const;
+
+		shard &shard_of(size_type hash) const noexcept {
+			return shards_[(hash >> shard_shift_) & shard_mask_];
+		}
+
+		static ctrl_type h2(size_type hash) noexcept {
+			return static_cast<ctrl_type>(hash & 0x7F);
+		}
+
+		static size_type h1(size_type hash) noexcept {
+			return hash >> 7;
+		}
+
+		// 8 个控制字节的 SWAR 操作，返回值每个命中字节的最高位为 1
+		static uint64_t load_group(const ctrl_type *ctrl) noexcept;
+
+		static uint64_t match_byte(uint64_t group, ctrl_type b) noexcept {
+			const uint64_t lsbs = 0x0101010101010101ULL;
+			const uint64_t x = group ^ (lsbs * b);
+			return (x - lsbs) & ~x & 0x8080808080808080ULL;
+		}
+
+		static uint64_t match_empty(uint64_t group) noexcept {
+			return group & ~(group << 6) & 0x8080808080808080ULL;
+		}
+
+		static uint64_t match_empty_or_deleted(uint64_t group) noexcept {
+			return group & ~(group << 7) & 0x8080808080808080ULL;
+		}
+
+		static size_type lowest_byte(uint64_t mask) noexcept;
+
+		slot_pointer find_in(const shard &s, const key_type &key, size_type hash) const;
+
+		size_type find_insert_slot(const shard &s, size_type hash) const noexcept;
+
+		template <class... Args>
+		slot_pointer emplace_new(shard &s, const key_type &key, size_type hash, Args &&...args);
+
+		void rehash(shard &s, size_type new_capacity);
+
+		static void destroy_shard(shard &s) noexcept;
+	};
+
+	/******************************************************************************************************/
+
+	// 构造函数
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::concurrent_hash_map(size_type shard_count, const hasher &hash,
+																			 const key_equal &equal)
+		: shards_(nullptr), shard_mask_(0), shard_shift_(0), hash_(hash), equal_(equal) {
+		size_type n = 1;
+		size_type bits = 0;
+		while (n < shard_count && bits < 16) {
+			n <<= 1;
+			++bits;
+		}
+		shards_ = shard_allocator::allocate(n);
+		for (size_type i = 0; i < n; ++i) {
+			wstl::construct(shards_ + i);
+			shards_[i].ctrl = nullptr;
+			shards_[i].slots = nullptr;
+			shards_[i].capacity = 0;
+			shards_[i].growth_left = 0;
+			shards_[i].size.store(0, std::memory_order_relaxed);
+		}
+		shard_mask_ = n - 1;
+		// 分片号取哈希值的高位，与组内探测使用的低位相互独立
+		shard_shift_ = sizeof(size_type) * 8 - (bits == 0 ? 1 : bits);
+	}
+
+	// 析构函数
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::~concurrent_hash_map() {
+		for (size_type i = 0; i < shard_count(); ++i) {
+			destroy_shard(shards_[i]);
+		}
+		wstl::destroy(shards_, shards_ + shard_count());
+		shard_allocator::deallocate(shards_, shard_count());
+	}
+
+	// size, 各分片元素数之和
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	typename concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::size() const noexcept {
+		size_type n = 0;
+		for (size_type i = 0; i < shard_count(); ++i) {
+			n += shards_[i].size.load(std::memory_order_relaxed);
+		}
+		return n;
+	}
+
+	// reserve, 为每个分片预留 n / shard_count 个元素的空间
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	void concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::reserve(size_type n) {
+		const auto per_shard = n / shard_count() + 1;
+		size_type cap = group_width;
+		while (cap - cap / 8 < per_shard) {
+			cap <<= 1;
+		}
+		for (size_type i = 0; i < shard_count(); ++i) {
+			auto &s = shards_[i];
+			std::lock_guard<spin_rw_lock> lock(s.lock);
+			if (s.capacity < cap) {
+				rehash(s, cap);
+			}
+		}
+	}
+
+	// find, 找到时把值拷贝到 out
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::find(const key_type &key, mapped_type &out) const {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		shared_lock_guard<spin_rw_lock> lock(s.lock);
+		auto slot = find_in(s, key, hash);
+		if (slot == nullptr) {
+			return false;
+		}
+		out = slot->second;
+		return true;
+	}
+
+	// contains, 判断键是否存在
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::contains(const key_type &key) const {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		shared_lock_guard<spin_rw_lock> lock(s.lock);
+		return find_in(s, key, hash) != nullptr;
+	}
+
+	// visit, 持读锁访问元素
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class Function>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::visit(const key_type &key, Function f) const {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		shared_lock_guard<spin_rw_lock> lock(s.lock);
+		auto slot = find_in(s, key, hash);
+		if (slot == nullptr) {
+			return false;
+		}
+		f(static_cast<const mapped_type &>(slot->second));
+		return true;
+	}
+
+	// modify, 持写锁修改元素
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class Function>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::modify(const key_type &key, Function f) {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		std::lock_guard<spin_rw_lock> lock(s.lock);
+		auto slot = find_in(s, key, hash);
+		if (slot == nullptr) {
+			return false;
+		}
+		f(slot->second);
+		return true;
+	}
+
+	// emplace, 键不存在时以 args 构造值并插入
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class... Args>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::emplace(const key_type &key, Args &&...args) {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		std::lock_guard<spin_rw_lock> lock(s.lock);
+		if (find_in(s, key, hash) != nullptr) {
+			return false;
+		}
+		emplace_new(s, key, hash, wstl::forward<Args>(args)...);
+		return true;
+	}
+
+	// insert_or_assign, 键存在时赋值，否则插入
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class M>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::insert_or_assign(const key_type &key, M &&value) {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		std::lock_guard<spin_rw_lock> lock(s.lock);
+		auto slot = find_in(s, key, hash);
+		if (slot != nullptr) {
+			slot->second = wstl::forward<M>(value);
+			return false;
+		}
+		emplace_new(s, key, hash, wstl::forward<M>(value));
+		return true;
+	}
+
+	// upsert, 键存在时原地更新，否则插入
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class Function, class... Args>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::upsert(const key_type &key, Function update, Args &&...args) {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		std::lock_guard<spin_rw_lock> lock(s.lock);
+		auto slot = find_in(s, key, hash);
+		if (slot != nullptr) {
+			update(slot->second);
+			return false;
+		}
+		emplace_new(s, key, hash, wstl::forward<Args>(args)...);
+		return true;
+	}
+
+	// erase, 删除键
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::erase(const key_type &key) {
+		const auto hash = hash_of(key);
+		auto &s = shard_of(hash);
+		std::lock_guard<spin_rw_lock> lock(s.lock);
+		auto slot = find_in(s, key, hash);
+		if (slot == nullptr) {
+			return false;
+		}
+		const auto index = static_cast<size_type>(slot - s.slots);
+		data_allocator::destroy(slot);
+		// 所在组仍有 empty 槽位时，任何探测序列都不会越过这一组，可以直接标记为 empty
+		const auto group_start = index & ~(group_width - 1);
+		if (match_empty(load_group(s.ctrl + group_start)) != 0) {
+			s.ctrl[index] = ctrl_empty;
+			++s.growth_left;
+		} else {
+			s.ctrl[index] = ctrl_deleted;
+		}
+		s.size.store(s.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// clear, 清空所有分片并释放存储
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	void concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::clear() {
+		for (size_type i = 0; i < shard_count(); ++i) {
+			auto &s = shards_[i];
+			std::lock_guard<spin_rw_lock> lock(s.lock);
+			destroy_shard(s);
+		}
+	}
+
+	// for_each, 遍历所有元素
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class Function>
+	void concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::for_each(Function f) const {
+		for (size_type i = 0; i < shard_count(); ++i) {
+			auto &s = shards_[i];
+			shared_lock_guard<spin_rw_lock> lock(s.lock);
+			for (size_type j = 0; j < s.capacity; ++j) {
+				if ((s.ctrl[j] & 0x80) == 0) {
+					f(static_cast<const key_type &>(s.slots[j].first), static_cast<const mapped_type &>(s.slots[j].second));
+				}
+			}
+		}
+	}
+
+	//******************************************************************** */
+	// helper function
+
+	// hash_of, 对用户哈希值再做一次乘法混合，避免 std::hash 恒等映射导致高低位分布不均
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	typename concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::hash_of(const key_type &key) const {
+		uint64_t h = static_cast<uint64_t>(hash_(key));
+		h ^= h >> 33;
+		h *= 0xFF51AFD7ED558CCDULL;
+		h ^= h >> 33;
+		return static_cast<size_type>(h);
+	}
+
+	// load_group, 读入 8 个控制字节，统一成小端字节序
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	uint64_t concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::load_group(const ctrl_type *ctrl) noexcept {
+		uint64_t group;
+		std::memcpy(&group, ctrl, sizeof(group));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		group = __builtin_bswap64(group);
+#endif
+		return group;
+	}
+
+	// lowest_byte, 最低位命中字节的下标
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	typename concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::lowest_byte(uint64_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_type>(__builtin_ctzll(mask)) >> 3;
+#else
+		size_type n = 0;
+		while ((mask & 0xFF) == 0) {
+			mask >>= 8;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	// find_in, 在分片中查找键，调用者持有锁
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	typename concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::slot_pointer
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::find_in(const shard &s, const key_type &key, size_type hash) const {
+		if (s.capacity == 0) {
+			return nullptr;
+		}
+		const auto group_mask = s.capacity / group_width - 1;
+		const auto tag = h2(hash);
+		auto g = h1(hash) & group_mask;
+		for (size_type step = 1;; ++step) {
+			const auto group = load_group(s.ctrl + g * group_width);
+			for (auto m = match_byte(group, tag); m != 0; m &= m - 1) {
+				const auto index = g * group_width + lowest_byte(m);
+				if (equal_(s.slots[index].first, key)) {
+					return s.slots + index;
+				}
+			}
+			if (match_empty(group) != 0 || step > group_mask) {
+				return nullptr;
+			}
+			g = (g + step) & group_mask;
+		}
+	}
+
+	// find_insert_slot, 沿探测序列找到第一个 empty 或 deleted 槽位
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	typename concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::find_insert_slot(const shard &s, size_type hash) const noexcept {
+		const auto group_mask = s.capacity / group_width - 1;
+		auto g = h1(hash) & group_mask;
+		for (size_type step = 1;; ++step) {
+			const auto m = match_empty_or_deleted(load_group(s.ctrl + g * group_width));
+			if (m != 0) {
+				return g * group_width + lowest_byte(m);
+			}
+			g = (g + step) & group_mask;
+		}
+	}
+
+	// emplace_new, 插入一个确定不存在的键，必要时先扩容，调用者持有写锁
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	template <class... Args>
+	typename concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::slot_pointer
+	concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::emplace_new(shard &s, const key_type &key, size_type hash,
+																	Args &&...args) {
+		if (s.capacity == 0) {
+			rehash(s, group_width);
+		}
+		auto index = find_insert_slot(s, hash);
+		if (s.growth_left == 0 && s.ctrl[index] == ctrl_empty) {
+			// 墓碑较多时原地重建，否则容量翻倍
+			const auto size = s.size.load(std::memory_order_relaxed);
+			rehash(s, size + 1 > (s.capacity - s.capacity / 8) / 2 ? s.capacity * 2 : s.capacity);
+			index = find_insert_slot(s, hash);
+		}
+		data_allocator::construct(s.slots + index, key, mapped_type(wstl::forward<Args>(args)...));
+		if (s.ctrl[index] == ctrl_empty) {
+			--s.growth_left;
+		}
+		s.ctrl[index] = h2(hash);
+		s.size.store(s.size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return s.slots + index;
+	}
+
+	// rehash, 把分片中的元素移动到容量为 new_capacity 的新表中
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	void concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::rehash(shard &s, size_type new_capacity) {
+		THROW_LENGTH_ERROR_IF(new_capacity > static_cast<size_type>(-1) / sizeof(value_type) / 2,
+							  "concurrent_hash_map : size too big");
+		auto new_ctrl = ctrl_allocator::allocate(new_capacity);
+		slot_pointer new_slots;
+		try {
+			new_slots = data_allocator::allocate(new_capacity);
+		} catch (...) {
+			ctrl_allocator::deallocate(new_ctrl, new_capacity);
+			throw;
+		}
+		std::memset(new_ctrl, ctrl_empty, new_capacity);
+
+		shard tmp;
+		tmp.ctrl = new_ctrl;
+		tmp.slots = new_slots;
+		tmp.capacity = new_capacity;
+		for (size_type i = 0; i < s.capacity; ++i) {
+			if ((s.ctrl[i] & 0x80) == 0) {
+				const auto hash = hash_of(s.slots[i].first);
+				const auto index = find_insert_slot(tmp, hash);
+				data_allocator::construct(new_slots + index, wstl::move(s.slots[i]));
+				data_allocator::destroy(s.slots + i);
+				new_ctrl[index] = h2(hash);
+			}
+		}
+		if (s.capacity != 0) {
+			ctrl_allocator::deallocate(s.ctrl, s.capacity);
+			data_allocator::deallocate(s.slots, s.capacity);
+		}
+		s.ctrl = new_ctrl;
+		s.slots = new_slots;
+		s.capacity = new_capacity;
+		s.growth_left = new_capacity - new_capacity / 8 - s.size.load(std::memory_order_relaxed);
+	}
+
+	// destroy_shard, 销毁分片中的元素并释放存储，调用者持有写锁或独占访问
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	void concurrent_hash_map<Key, T, Hash, KeyEqual, Alloc>::destroy_shard(shard &s) noexcept {
+		if (s.capacity == 0) {
+			return;
+		}
+		for (size_type i = 0; i < s.capacity; ++i) {
+			if ((s.ctrl[i] & 0x80) == 0) {
+				data_allocator::destroy(s.slots + i);
+			}
+		}
+		ctrl_allocator::deallocate(s.ctrl, s.capacity);
+		data_allocator::deallocate(s.slots, s.capacity);
+		s.ctrl = nullptr;
+		s.slots = nullptr;
+		s.capacity = 0;
+		s.growth_left = 0;
+		s.size.store(0, std::memory_order_relaxed);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_CONCURRENT_HASH_MAP_H
@@ -0,0 +1,775 @@
+#ifndef WSTL_CONCURRENT_VECTOR_H
+#define WSTL_CONCURRENT_VECTOR_H
+
+/*
+	该文件实现 concurrent_vector 容器：支持多线程并发追加、元素地址永不失效的分段数组
+
+	存储由按指数增长的段组成：第 k 段容纳 first_segment_size << k 个元素，
+	下标到 (段, 段内偏移) 的映射只需一次最高位计算。增长时只分配新段，已有元素从不移动，
+	因此指针、引用、迭代器在容器生命周期内（clear / shrink_to_fit / 析构除外）始终有效。
+
+	并发保证：
+		push_back，emplace_back，grow_by，grow_to_at_least，reserve，operator[]，at，size
+	可以在多个线程中同时调用。追加操作是一次 CAS 推进 size 加上元素构造；
+	size() 统计的是已预留的槽位，其他线程读取某个元素前，需要通过自身的同步手段
+	（例如追加线程随后发布的标志位）确认该元素已构造完成。
+	clear，shrink_to_fit，swap，赋值以及析构不是线程安全的。
+
+	异常保证：
+	追加操作先检查长度并分配新下标所在的段，之后才推进 size，长度超限或段分配失败时抛出异常且 size 不变。
+	已预留的槽位必须构造成功，否则 clear / 析构会销毁未构造的对象，因此要求 T 的移动构造不抛出异常（static_assert 检查）。
+	追加时使用的构造函数（emplace_back 的参数构造、grow_by 的拷贝或默认构造、grow_to_at_least 的默认构造）
+	为 noexcept 时直接在槽位上构造；可能抛出异常时先在临时对象或临时缓冲区中构造，再预留下标并移动进槽位，
+	构造失败时容器不变。
+*/
+
+#include <atomic>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace wstl {
+
+	template <class T, class Alloc>
+	class concurrent_vector;
+
+	// concurrent_vector 的迭代器，保存容器指针与下标
+	template <class Vector, class Value>
+	class concurrent_vector_iterator : public wstl::iterator<wstl::random_access_iterator_tag, Value> {
+		template <class V, class U>
+		friend class concurrent_vector_iterator;
+
+	public:
+		typedef Value value_type;
+		typedef Value *pointer;
+		typedef Value &reference;
+		typedef ptrdiff_t difference_type;
+		typedef size_t size_type;
+		typedef concurrent_vector_iterator self;
+
+	private:
+		Vector *vec_;
+		size_type index_;
+
+	public:
+		concurrent_vector_iterator() noexcept : vec_(nullptr), index_(0) {}
+
+		concurrent_vector_iterator(Vector *vec, size_type index) noexcept : vec_(vec), index_(index) {}
+
+		// 由非 const 迭代器隐式转换为 const 迭代器
+		template <class V, class U>
+		concurrent_vector_iterator(const concurrent_vector_iterator<V, U> &rhs) noexcept
+			: vec_(rhs.vec_), index_(rhs.index_) {}
+
+		size_type index() const noexcept {
+			return index_;
+		}
+
+		reference operator*() const {
+			return (*vec_)[index_];
+		}
+
+		pointer operator->() const {
+			return &(operator*());
+		}
+
+		reference operator[](difference_type n) const {
+			return (*vec_)[index_ + n];
+		}
+
+		self &operator++() {
+			++index_;
+			return *this;
+		}
+
+		self operator++(int) {
+			self tmp = *this;
+			++index_;
+			return tmp;
+		}
+
+		self &operator--() {
+			--index_;
+			return *this;
+		}
+
+		self operator--(int) {
+			self tmp = *this;
+			--index_;
+			return tmp;
+		}
+
+		self &operator+=(difference_type n) {
+			index_ += n;
+			return *this;
+		}
+
+		self operator+(difference_type n) const {
+			return self(vec_, index_ + n);
+		}
+
+		self &operator-=(difference_type n) {
+			index_ -= n;
+			return *this;
+		}
+
+		self operator-(difference_type n) const {
+			return self(vec_, index_ - n);
+		}
+
+		template <class V, class U>
+		difference_type operator-(const concurrent_vector_iterator<V, U> &rhs) const {
+			return static_cast<difference_type>(index_) - static_cast<difference_type>(rhs.index_);
+		}
+
+		template <class V, class U>
+		bool operator==(const concurrent_vector_iterator<V, U> &rhs) const {
+			return index_ == rhs.index_;
+		}
+
+		template <class V, class U>
+		bool operator!=(const concurrent_vector_iterator<V, U> &rhs) const {
+			return index_ != rhs.index_;
+		}
+
+		template <class V, class U>
+		bool operator<(const concurrent_vector_iterator<V, U> &rhs) const {
+			return index_ < rhs.index_;
+		}
+
+		template <class V, class U>
+		bool operator>(const concurrent_vector_iterator<V, U> &rhs) const {
+			return index_ > rhs.index_;
+		}
+
+		template <class V, class U>
+		bool operator<=(const concurrent_vector_iterator<V, U> &rhs) const {
+			return index_ <= rhs.index_;
+		}
+
+		template <class V, class U>
+		bool operator>=(const concurrent_vector_iterator<V, U> &rhs) const {
+			return index_ >= rhs.index_;
+		}
+	};
+
+	template <class Vector, class Value>
+	concurrent_vector_iterator<Vector, Value>
+	operator+(ptrdiff_t n, const concurrent_vector_iterator<Vector, Value> &it) {
+		return it + n;
+	}
+
+	// concurrent_vector 类模板
+	template <class T, class Alloc = wstl::allocator<T>>
+	class concurrent_vector {
+		static_assert(!std::is_same<T, bool>::value, "concurrent_vector<bool> is abandoned in wstl");
+		static_assert(std::is_nothrow_move_constructible<T>::value, "concurrent_vector<T> requires nothrow move constructible T");
+
+	public:
+		// concurrent_vector 的嵌套型别定义
+		typedef Alloc allocator_type;
+		typedef Alloc data_allocator;
+
+		typedef typename allocator_type::value_type value_type;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::size_type size_type;
+		typedef typename allocator_type::difference_type difference_type;
+
+		typedef concurrent_vector_iterator<concurrent_vector, value_type> iterator;
+		typedef concurrent_vector_iterator<const concurrent_vector, const value_type> const_iterator;
+		typedef wstl::reverse_iterator<iterator> reverse_iterator;
+		typedef wstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		allocator_type get_allocator() const {
+			return data_allocator();
+		}
+
+	private:
+		// 第 0 段的大小为 2^first_segment_shift，之后每段翻倍
+		static constexpr size_type first_segment_shift = 4;
+		static constexpr size_type first_segment_size = static_cast<size_type>(1) << first_segment_shift;
+		static constexpr size_type max_segments = sizeof(size_type) * 8 - first_segment_shift;
+
+		std::atomic<pointer> segments_[max_segments];
+		std::atomic<size_type> size_;
+
+	public:
+		// 构造、复制、移动、析构函数
+
+		concurrent_vector() noexcept : size_(0) {
+			init_segments();
+		}
+
+		explicit concurrent_vector(size_type n) : size_(0) {
+			init_segments();
+			grow_by(n);
+		}
+
+		concurrent_vector(size_type n, const value_type &value) : size_(0) {
+			init_segments();
+			grow_by(n, value);
+		}
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		concurrent_vector(InputIterator first, InputIterator last) : size_(0) {
+			init_segments();
+			for (; first != last; ++first) {
+				emplace_back(*first);
+			}
+		}
+
+		concurrent_vector(std::initializer_list<value_type> il) : size_(0) {
+			init_segments();
+			reserve(il.size());
+			for (auto &value : il) {
+				emplace_back(value);
+			}
+		}
+
+		concurrent_vector(const concurrent_vector &rhs) : size_(0) {
+			init_segments();
+			const auto n = rhs.size();
+			reserve(n);
+			for (size_type i = 0; i < n; ++i) {
+				emplace_back(rhs[i]);
+			}
+		}
+
+		concurrent_vector(concurrent_vector &&rhs) noexcept : size_(0) {
+			init_segments();
+			swap(rhs);
+		}
+
+		concurrent_vector &operator=(const concurrent_vector &rhs) {
+			if (this != &rhs) {
+				concurrent_vector tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		concurrent_vector &operator=(concurrent_vector &&rhs) noexcept {
+			if (this != &rhs) {
+				clear();
+				free_segments(0);
+				swap(rhs);
+			}
+			return *this;
+		}
+
+		~concurrent_vector() {
+			clear();
+			free_segments(0);
+		}
+
+	public:
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return iterator(this, 0);
+		}
+
+		const_iterator begin() const noexcept {
+			return const_iterator(this, 0);
+		}
+
+		iterator end() noexcept {
+			return iterator(this, size());
+		}
+
+		const_iterator end() const noexcept {
+			return const_iterator(this, size());
+		}
+
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() noexcept {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+
+		const_iterator cend() const noexcept {
+			return end();
+		}
+
+		// 容量相关操作
+
+		size_type size() const noexcept {
+			return size_.load(std::memory_order_acquire);
+		}
+
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		size_type capacity() const noexcept;
+
+		size_type max_size() const noexcept {
+			return static_cast<size_type>(-1) / sizeof(T);
+		}
+
+		void reserve(size_type n);
+
+		void shrink_to_fit();
+
+		// 访问元素相关操作，可与追加操作并发执行
+
+		reference operator[](size_type n) {
+			WSTL_DEBUG(n < size());
+			return *slot(n);
+		}
+
+		const_reference operator[](size_type n) const {
+			WSTL_DEBUG(n < size());
+			return *slot(n);
+		}
+
+		reference at(size_type n) {
+			THROW_OUT_OF_RANGE_IF(n >= size(), "concurrent_vector<T> : out of range");
+			return (*this)[n];
+		}
+
+		const_reference at(size_type n) const {
+			THROW_OUT_OF_RANGE_IF(n >= size(), "concurrent_vector<T> : out of range");
+			return (*this)[n];
+		}
+
+		reference front() {
+			WSTL_DEBUG(!empty());
+			return (*this)[0];
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return (*this)[0];
+		}
+
+		reference back() {
+			WSTL_DEBUG(!empty());
+			return (*this)[size() - 1];
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return (*this)[size() - 1];
+		}
+
+		// 修改容器相关操作，可并发调用
+
+		template <class... Args>
+		iterator emplace_back(Args &&...args);
+
+		iterator push_back(const value_type &value) {
+			return emplace_back(value);
+		}
+
+		iterator push_back(value_type &&value) {
+			return emplace_back(wstl::move(value));
+		}
+
+		// grow_by, 一次预留 n 个连续下标并构造，返回指向第一个新元素的迭代器
+		iterator grow_by(size_type n);
+
+		iterator grow_by(size_type n, const value_type &value);
+
+		template <class ForwardIterator, typename std::enable_if<wstl::is_forward_iterator<ForwardIterator>::value, int>::type = 0>
+		iterator grow_by(ForwardIterator first, ForwardIterator last);
+
+		// grow_to_at_least, 保证 size() >= n，返回指向原来第 n 个位置之前的迭代器
+		iterator grow_to_at_least(size_type n);
+
+		// 以下操作不是线程安全的
+
+		void clear();
+
+		void swap(concurrent_vector &rhs) noexcept;
+
+	private:
+		// helper functions
+
+		void init_segments() noexcept;
+
+		// 下标所在的段号
+		static size_type segment_index_of(size_type index) noexcept {
+			return log2_floor((index >> first_segment_shift) + 1);
+		}
+
+		// 第 k 段第一个元素的下标
+		static size_type segment_base(size_type k) noexcept {
+			return ((static_cast<size_type>(1) << k) - 1) << first_segment_shift;
+		}
+
+		static size_type segment_size(size_type k) noexcept {
+			return first_segment_size << k;
+		}
+
+		static size_type log2_floor(size_type x) noexcept;
+
+		// 已分配段中第 index 个元素的地址
+		pointer slot(size_type index) const noexcept {
+			const auto k = segment_index_of(index);
+			return segments_[k].load(std::memory_order_acquire) + (index - segment_base(k));
+		}
+
+		pointer ensure_segment(size_type k);
+
+		void ensure_range(size_type first, size_type last);
+
+		size_type reserve_slots(size_type n);
+
+		// 构造可能抛出异常时，先在临时缓冲区中构造，再预留下标并移动进槽位
+		template <class Construct>
+		static pointer stage(size_type n, Construct construct);
+
+		static void unstage(pointer buf, size_type n) noexcept;
+
+		static void default_construct_n(pointer buf, size_type n);
+
+		void move_in(size_type first, pointer buf, size_type n) noexcept;
+
+		iterator append_staged(pointer buf, size_type n);
+
+		void free_segments(size_type first_segment) noexcept;
+	};
+
+	/******************************************************************************************************/
+
+	// capacity, 已分配段的总容量
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::capacity() const noexcept {
+		size_type k = 0;
+		while (k < max_segments && segments_[k].load(std::memory_order_acquire) != nullptr) {
+			++k;
+		}
+		return segment_base(k);
+	}
+
+	// reserve, 预先分配覆盖 [0, n) 的所有段
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::reserve(size_type n) {
+		THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T> : exceed max_size() in concurrent_vector::reserve");
+		if (n != 0) {
+			ensure_range(0, n);
+		}
+	}
+
+	// shrink_to_fit, 释放 size() 之后不再使用的段
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::shrink_to_fit() {
+		const auto n = size();
+		free_segments(n == 0 ? 0 : segment_index_of(n - 1) + 1);
+	}
+
+	// emplace_back, 预留一个下标后就地构造
+	template <class T, class Alloc>
+	template <class... Args>
+	typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::emplace_back(Args &&...args) {
+		if (std::is_nothrow_constructible<T, Args &&...>::value) {
+			const auto index = reserve_slots(1);
+			data_allocator::construct(slot(index), wstl::forward<Args>(args)...);
+			return iterator(this, index);
+		}
+		// 构造可能抛出异常，先在槽位之外构造
+		value_type tmp(wstl::forward<Args>(args)...);
+		const auto index = reserve_slots(1);
+		data_allocator::construct(slot(index), wstl::move(tmp));
+		return iterator(this, index);
+	}
+
+	// grow_by, 预留 n 个下标并默认构造
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_by(size_type n) {
+		if (!std::is_nothrow_default_constructible<T>::value) {
+			return append_staged(stage(n, [n](pointer buf) { default_construct_n(buf, n); }), n);
+		}
+		const auto first = reserve_slots(n);
+		for (auto index = first; index != first + n; ++index) {
+			data_allocator::construct(slot(index));
+		}
+		return iterator(this, first);
+	}
+
+	// grow_by, 预留 n 个下标并以 value 填充
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::iterator
+	concurrent_vector<T, Alloc>::grow_by(size_type n, const value_type &value) {
+		if (!std::is_nothrow_copy_constructible<T>::value) {
+			return append_staged(stage(n, [n, &value](pointer buf) { wstl::uninitialized_fill_n(buf, n, value); }), n);
+		}
+		const auto first = reserve_slots(n);
+		auto index = first;
+		const auto last = first + n;
+		while (index != last) {
+			// 每次填充一段内连续的部分
+			const auto k = segment_index_of(index);
+			const auto seg_end = wstl::min(segment_base(k) + segment_size(k), last);
+			const auto ptr = slot(index);
+			wstl::uninitialized_fill_n(ptr, seg_end - index, value);
+			index = seg_end;
+		}
+		return iterator(this, first);
+	}
+
+	// grow_by, 预留 [first, last) 长度的下标并拷贝区间内容
+	template <class T, class Alloc>
+	template <class ForwardIterator, typename std::enable_if<wstl::is_forward_iterator<ForwardIterator>::value, int>::type>
+	typename concurrent_vector<T, Alloc>::iterator
+	concurrent_vector<T, Alloc>::grow_by(ForwardIterator first, ForwardIterator last) {
+		const auto n = static_cast<size_type>(wstl::distance(first, last));
+		if (!std::is_nothrow_constructible<T, decltype(*first)>::value) {
+			return append_staged(stage(n, [first, n](pointer buf) { wstl::uninitialized_copy_n(first, n, buf); }), n);
+		}
+		const auto start = reserve_slots(n);
+		auto index = start;
+		const auto end = start + n;
+		while (index != end) {
+			const auto k = segment_index_of(index);
+			const auto seg_end = wstl::min(segment_base(k) + segment_size(k), end);
+			for (auto ptr = slot(index); index != seg_end; ++index, ++ptr, ++first) {
+				data_allocator::construct(ptr, *first);
+			}
+		}
+		return iterator(this, start);
+	}
+
+	// grow_to_at_least, 用 CAS 把 size_ 推进到至少 n，并默认构造新增元素
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_to_at_least(size_type n) {
+		THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T> : size too big");
+		const bool nothrow = std::is_nothrow_default_constructible<T>::value;
+		auto old_size = size_.load(std::memory_order_relaxed);
+		if (old_size >= n) {
+			return iterator(this, n);
+		}
+		// 默认构造可能抛出异常时，先构造最多需要的 n - old_size 个元素，size_ 只增不减，CAS 成功时需要的不会更多
+		const auto staged = nothrow ? 0 : n - old_size;
+		pointer buf = nothrow ? nullptr : stage(staged, [staged](pointer p) { default_construct_n(p, staged); });
+		try {
+			while (old_size < n) {
+				ensure_range(old_size, n);
+				if (size_.compare_exchange_weak(old_size, n, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					if (nothrow) {
+						for (auto index = old_size; index != n; ++index) {
+							data_allocator::construct(slot(index));
+						}
+					} else {
+						move_in(old_size, buf, n - old_size);
+					}
+					break;
+				}
+			}
+		} catch (...) {
+			unstage(buf, staged);
+			throw;
+		}
+		unstage(buf, staged);
+		return iterator(this, n);
+	}
+
+	// clear, 销毁所有元素但保留已分配的段
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::clear() {
+		const auto n = size_.load(std::memory_order_relaxed);
+		size_type index = 0;
+		while (index != n) {
+			const auto k = segment_index_of(index);
+			const auto seg_end = wstl::min(segment_base(k) + segment_size(k), n);
+			const auto ptr = slot(index);
+			data_allocator::destroy(ptr, ptr + (seg_end - index));
+			index = seg_end;
+		}
+		size_.store(0, std::memory_order_relaxed);
+	}
+
+	// swap, 交换两个 concurrent_vector 的段表
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::swap(concurrent_vector &rhs) noexcept {
+		if (this != &rhs) {
+			for (size_type k = 0; k < max_segments; ++k) {
+				auto tmp = segments_[k].load(std::memory_order_relaxed);
+				segments_[k].store(rhs.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				rhs.segments_[k].store(tmp, std::memory_order_relaxed);
+			}
+			auto tmp = size_.load(std::memory_order_relaxed);
+			size_.store(rhs.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			rhs.size_.store(tmp, std::memory_order_relaxed);
+		}
+	}
+
+	//******************************************************************** */
+	// helper function
+
+	// init_segments, 所有段初始化为空
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::init_segments() noexcept {
+		for (size_type k = 0; k < max_segments; ++k) {
+			segments_[k].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	// log2_floor, 最高有效位的位置，x 必须大于 0
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::log2_floor(size_type x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		return sizeof(size_type) * 8 - 1 - static_cast<size_type>(__builtin_clzll(static_cast<unsigned long long>(x)));
+#else
+		size_type r = 0;
+		while (x >>= 1) {
+			++r;
+		}
+		return r;
+#endif
+	}
+
+	// ensure_segment, 第 k 段不存在时分配，多个线程竞争时只保留一个
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::pointer concurrent_vector<T, Alloc>::ensure_segment(size_type k) {
+		THROW_LENGTH_ERROR_IF(k >= max_segments, "concurrent_vector<T> : size too big");
+		auto seg = segments_[k].load(std::memory_order_acquire);
+		if (seg != nullptr) {
+			return seg;
+		}
+		auto fresh = data_allocator::allocate(segment_size(k));
+		if (segments_[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return fresh;
+		}
+		data_allocator::deallocate(fresh, segment_size(k));
+		return seg;
+	}
+
+	// ensure_range, 确保 [first, last) 覆盖的段都已分配
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::ensure_range(size_type first, size_type last) {
+		const auto k_last = segment_index_of(last - 1);
+		for (auto k = segment_index_of(first); k <= k_last; ++k) {
+			ensure_segment(k);
+		}
+	}
+
+	// reserve_slots, 原子地预留 n 个下标，返回第一个下标
+	// 先检查长度、分配覆盖新下标的段，再用 CAS 推进 size_，抛出异常时 size_ 不变
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::reserve_slots(size_type n) {
+		auto first = size_.load(std::memory_order_relaxed);
+		if (n == 0) {
+			return first;
+		}
+		do {
+			THROW_LENGTH_ERROR_IF(n > max_size() - first, "concurrent_vector<T> : size too big");
+			ensure_range(first, first + n);
+		} while (!size_.compare_exchange_weak(first, first + n, std::memory_order_acq_rel, std::memory_order_relaxed));
+		return first;
+	}
+
+	// stage, 分配临时缓冲区并由 construct(buf) 构造 n 个元素，construct 失败时须已销毁自己构造的元素
+	template <class T, class Alloc>
+	template <class Construct>
+	typename concurrent_vector<T, Alloc>::pointer concurrent_vector<T, Alloc>::stage(size_type n, Construct construct) {
+		auto buf = data_allocator::allocate(n);
+		try {
+			construct(buf);
+		} catch (...) {
+			data_allocator::deallocate(buf, n);
+			throw;
+		}
+		return buf;
+	}
+
+	// unstage, 销毁临时缓冲区中的元素（包括已被移走的）并释放缓冲区
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::unstage(pointer buf, size_type n) noexcept {
+		data_allocator::destroy(buf, buf + n);
+		data_allocator::deallocate(buf, n);
+	}
+
+	// default_construct_n, 在 buf 上默认构造 n 个元素，失败时销毁已构造的部分
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::default_construct_n(pointer buf, size_type n) {
+		size_type i = 0;
+		try {
+			for (; i != n; ++i) {
+				data_allocator::construct(buf + i);
+			}
+		} catch (...) {
+			data_allocator::destroy(buf, buf + i);
+			throw;
+		}
+	}
+
+	// move_in, 把临时缓冲区中的 n 个元素移动构造到从 first 开始的已预留槽位
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::move_in(size_type first, pointer buf, size_type n) noexcept {
+		for (size_type i = 0; i != n; ++i) {
+			data_allocator::construct(slot(first + i), wstl::move(buf[i]));
+		}
+	}
+
+	// append_staged, 预留 n 个下标并移入临时缓冲区中的元素，预留失败时容器不变
+	template <class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::append_staged(pointer buf, size_type n) {
+		size_type first = 0;
+		try {
+			first = reserve_slots(n);
+		} catch (...) {
+			unstage(buf, n);
+			throw;
+		}
+		move_in(first, buf, n);
+		unstage(buf, n);
+		return iterator(this, first);
+	}
+
+	// free_segments, 释放第 first_segment 段及之后的所有段
+	template <class T, class Alloc>
+	void concurrent_vector<T, Alloc>::free_segments(size_type first_segment) noexcept {
+		for (auto k = first_segment; k < max_segments; ++k) {
+			auto seg = segments_[k].exchange(nullptr, std::memory_order_relaxed);
+			if (seg != nullptr) {
+				data_allocator::deallocate(seg, segment_size(k));
+			}
+		}
+	}
+
+	/******************************************************************************************************/
+	// 重载比较操作符
+
+	template <class T, class Alloc>
+	bool operator==(const concurrent_vector<T, Alloc> &lhs, const concurrent_vector<T, Alloc> &rhs) {
+		return lhs.size() == rhs.size() && wstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class T, class Alloc>
+	bool operator!=(const concurrent_vector<T, Alloc> &lhs, const concurrent_vector<T, Alloc> &rhs) {
+		return !(lhs == rhs);
+	}
+
+	// 重载 swap
+	template <class T, class Alloc>
+	void swap(concurrent_vector<T, Alloc> &lhs, concurrent_vector<T, Alloc> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_CONCURRENT_VECTOR_H
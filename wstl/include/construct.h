@@ -35,6 +35,9 @@ namespace wstl {
 
 	// destroy
 
+	template <class Ty>
+	void destroy(Ty *pointer);
+
 	template <class Ty>
 	void destroy_one(Ty *, std::true_type) {}
 
@@ -0,0 +1,374 @@
+#ifndef WSTL_EPOCH_H
+#define WSTL_EPOCH_H
+
+/*
+	该文件实现基于纪元的内存回收（epoch-based reclamation，EBR），供无锁容器延迟释放节点
+
+	进程内有一个全局纪元计数器。线程在访问共享节点前用 epoch_guard 进入临界区，
+	把自己观察到的全局纪元记录到线程私有的记录中；离开临界区时清除标记。
+	节点从数据结构中摘除后调用 retire，它被放进当前线程、当前纪元的待回收（limbo）列表。
+	当所有处于临界区的线程都已观察到全局纪元 e 时，全局纪元才能推进到 e + 1；
+	因此当全局纪元达到 e + 2 时，在纪元 e 退休的节点不可能再被任何线程持有，可以安全释放。
+
+	进入临界区的开销：一次 relaxed 读全局纪元，一次写线程记录（带一次全屏障，x86 上用 xchg 实现），
+	嵌套进入只是线程私有计数加一。离开临界区是一次 release 写。
+
+	线程退出时尚未回收的节点转交给全局的孤儿列表，由其他线程在 collect 时回收。
+	deleter 中不能再调用 retire。
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "vector.h"
+
+namespace wstl {
+
+	// epoch_domain, 全局纪元与线程记录的管理者，进程内唯一
+	class epoch_domain {
+	public:
+		typedef void (*deleter_type)(void *);
+
+		// 每个线程累计退休多少个节点后尝试推进纪元并回收
+		static constexpr unsigned collect_threshold = 64;
+
+	private:
+		// 待回收节点
+		struct retired {
+			void *ptr;
+			deleter_type deleter;
+		};
+
+		// 在同一纪元退休的节点
+		struct limbo_bucket {
+			uint64_t epoch;
+			wstl::vector<retired> items;
+		};
+
+		// 退出线程遗留的节点
+		struct orphan {
+			uint64_t epoch;
+			retired item;
+		};
+
+		// 线程记录，只追加不删除，线程退出后可被新线程复用
+		struct thread_record {
+			std::atomic<uint64_t> state; // (纪元 << 1) | 是否处于临界区
+			std::atomic<bool> in_use;
+			thread_record *next;
+			unsigned nesting;
+			unsigned retire_count;
+			limbo_bucket limbo[3];
+		};
+
+		// 线程退出时归还记录
+		struct thread_handle {
+			thread_record *record;
+
+			thread_handle() noexcept : record(nullptr) {}
+
+			~thread_handle() {
+				if (record != nullptr) {
+					epoch_domain::instance().release_record(record);
+				}
+			}
+		};
+
+		typedef wstl::allocator<thread_record> record_allocator;
+
+		std::atomic<uint64_t> global_epoch_;
+		std::atomic<thread_record *> records_;
+		std::mutex orphan_mutex_;
+		wstl::vector<orphan> orphans_;
+
+		epoch_domain() noexcept : global_epoch_(0), records_(nullptr) {}
+
+	public:
+		epoch_domain(const epoch_domain &) = delete;
+		epoch_domain &operator=(const epoch_domain &) = delete;
+
+		~epoch_domain();
+
+		static epoch_domain &instance() {
+			static epoch_domain domain;
+			return domain;
+		}
+
+		// 当前全局纪元
+		uint64_t epoch() const noexcept {
+			return global_epoch_.load(std::memory_order_relaxed);
+		}
+
+		// 进入 / 离开临界区，可以嵌套，通常通过 epoch_guard 调用
+		void enter();
+
+		void leave() noexcept;
+
+		// retire, 延迟调用 deleter(ptr)
+		void retire(void *ptr, deleter_type deleter);
+
+		// retire, 延迟调用 wstl::destroy(ptr) 与 Alloc::deallocate(ptr)
+		template <class T, class Alloc = wstl::allocator<T>>
+		void retire(T *ptr) {
+			retire(static_cast<void *>(ptr), &reclaim<T, Alloc>);
+		}
+
+		// collect, 尝试推进纪元，并回收当前线程及孤儿列表中已安全的节点
+		void collect();
+
+		// 当前线程尚未回收的节点数
+		size_t pending() const;
+
+	private:
+		// helper functions
+
+		template <class T, class Alloc>
+		static void reclaim(void *ptr) {
+			auto p = static_cast<T *>(ptr);
+			wstl::destroy(p);
+			Alloc::deallocate(p);
+		}
+
+		thread_record *local_record();
+
+		thread_record *acquire_record();
+
+		void release_record(thread_record *record);
+
+		bool try_advance() noexcept;
+
+		static void free_bucket(limbo_bucket &bucket) noexcept;
+
+		void collect_orphans(uint64_t epoch);
+	};
+
+	/******************************************************************************************************/
+
+	// 析构函数，此时不应再有线程处于临界区，释放所有剩余节点与线程记录
+	inline epoch_domain::~epoch_domain() {
+		auto record = records_.load(std::memory_order_acquire);
+		while (record != nullptr) {
+			auto next = record->next;
+			for (auto &bucket : record->limbo) {
+				free_bucket(bucket);
+			}
+			record_allocator::destroy(record);
+			record_allocator::deallocate(record);
+			record = next;
+		}
+		for (auto &o : orphans_) {
+			o.item.deleter(o.item.ptr);
+		}
+	}
+
+	// enter, 记录当前观察到的全局纪元
+	inline void epoch_domain::enter() {
+		auto record = local_record();
+		if (record->nesting++ != 0) {
+			return;
+		}
+		const auto state = (global_epoch_.load(std::memory_order_relaxed) << 1) | 1;
+		// 写记录之后、读共享指针之前需要全屏障，否则推进纪元的线程可能看不到本线程已进入临界区
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		record->state.exchange(state, std::memory_order_seq_cst);
+#else
+		record->state.store(state, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+	}
+
+	// leave, 最外层离开时清除标记
+	inline void epoch_domain::leave() noexcept {
+		auto record = local_record();
+		WSTL_DEBUG(record->nesting > 0);
+		if (--record->nesting == 0) {
+			record->state.store(0, std::memory_order_release);
+		}
+	}
+
+	// retire, 放入当前纪元对应的 limbo 列表
+	inline void epoch_domain::retire(void *ptr, deleter_type deleter) {
+		auto record = local_record();
+		const auto e = global_epoch_.load(std::memory_order_acquire);
+		auto &bucket = record->limbo[e % 3];
+		if (bucket.epoch != e) {
+			// 同一个桶上次使用的纪元不晚于 e - 3，早已安全
+			free_bucket(bucket);
+			bucket.epoch = e;
+		}
+		retired item = {ptr, deleter};
+		bucket.items.push_back(item);
+		if (++record->retire_count >= collect_threshold) {
+			record->retire_count = 0;
+			collect();
+		}
+	}
+
+	// collect, 推进纪元并回收
+	inline void epoch_domain::collect() {
+		try_advance();
+		const auto e = global_epoch_.load(std::memory_order_acquire);
+		auto record = local_record();
+		for (auto &bucket : record->limbo) {
+			if (!bucket.items.empty() && bucket.epoch + 2 <= e) {
+				free_bucket(bucket);
+			}
+		}
+		collect_orphans(e);
+	}
+
+	// pending, 当前线程尚未回收的节点数
+	inline size_t epoch_domain::pending() const {
+		auto record = const_cast<epoch_domain *>(this)->local_record();
+		size_t n = 0;
+		for (auto &bucket : record->limbo) {
+			n += bucket.items.size();
+		}
+		return n;
+	}
+
+	//******************************************************************** */
+	// helper function
+
+	// local_record, 当前线程的记录，首次调用时获取
+	inline epoch_domain::thread_record *epoch_domain::local_record() {
+		static thread_local thread_handle handle;
+		if (handle.record == nullptr) {
+			handle.record = acquire_record();
+		}
+		return handle.record;
+	}
+
+	// acquire_record, 复用空闲记录，没有时新建并挂到链表头部
+	inline epoch_domain::thread_record *epoch_domain::acquire_record() {
+		for (auto record = records_.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+			bool expected = false;
+			if (!record->in_use.load(std::memory_order_relaxed) &&
+				record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+				return record;
+			}
+		}
+		auto record = record_allocator::allocate();
+		try {
+			record_allocator::construct(record);
+		} catch (...) {
+			record_allocator::deallocate(record);
+			throw;
+		}
+		record->state.store(0, std::memory_order_relaxed);
+		record->in_use.store(true, std::memory_order_relaxed);
+		record->nesting = 0;
+		record->retire_count = 0;
+		for (auto &bucket : record->limbo) {
+			bucket.epoch = 0;
+		}
+		auto head = records_.load(std::memory_order_relaxed);
+		do {
+			record->next = head;
+		} while (!records_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+		return record;
+	}
+
+	// release_record, 线程退出：回收能回收的节点，其余转交孤儿列表
+	inline void epoch_domain::release_record(thread_record *record) {
+		try_advance();
+		const auto e = global_epoch_.load(std::memory_order_acquire);
+		{
+			std::lock_guard<std::mutex> lock(orphan_mutex_);
+			for (auto &bucket : record->limbo) {
+				if (bucket.epoch + 2 <= e) {
+					free_bucket(bucket);
+					continue;
+				}
+				for (auto &item : bucket.items) {
+					orphan o = {bucket.epoch, item};
+					orphans_.push_back(o);
+				}
+				bucket.items.clear();
+			}
+		}
+		record->state.store(0, std::memory_order_relaxed);
+		record->nesting = 0;
+		record->retire_count = 0;
+		record->in_use.store(false, std::memory_order_release);
+	}
+
+	// try_advance, 所有处于临界区的线程都已观察到当前纪元时推进一步
+	inline bool epoch_domain::try_advance() noexcept {
+		auto e = global_epoch_.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (auto record = records_.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+			const auto state = record->state.load(std::memory_order_relaxed);
+			if ((state & 1) != 0 && (state >> 1) != e) {
+				return false;
+			}
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return global_epoch_.compare_exchange_strong(e, e + 1, std::memory_order_release, std::memory_order_relaxed);
+	}
+
+	// free_bucket, 释放桶内所有节点
+	inline void epoch_domain::free_bucket(limbo_bucket &bucket) noexcept {
+		for (auto &item : bucket.items) {
+			item.deleter(item.ptr);
+		}
+		bucket.items.clear();
+	}
+
+	// collect_orphans, 回收孤儿列表中已安全的节点，其他线程正在回收时直接跳过
+	inline void epoch_domain::collect_orphans(uint64_t epoch) {
+		std::unique_lock<std::mutex> lock(orphan_mutex_, std::try_to_lock);
+		if (!lock.owns_lock() || orphans_.empty()) {
+			return;
+		}
+		auto keep = orphans_.begin();
+		for (auto it = orphans_.begin(); it != orphans_.end(); ++it) {
+			if (it->epoch + 2 <= epoch) {
+				it->item.deleter(it->item.ptr);
+			} else {
+				*keep++ = *it;
+			}
+		}
+		orphans_.erase(keep, orphans_.end());
+	}
+
+	/******************************************************************************************************/
+
+	// epoch_guard, 临界区 RAII 守卫，在其生命周期内读到的共享节点不会被回收
+	class epoch_guard {
+	public:
+		epoch_guard() : domain_(epoch_domain::instance()) {
+			domain_.enter();
+		}
+
+		explicit epoch_guard(epoch_domain &domain) : domain_(domain) {
+			domain_.enter();
+		}
+
+		epoch_guard(const epoch_guard &) = delete;
+		epoch_guard &operator=(const epoch_guard &) = delete;
+
+		~epoch_guard() {
+			domain_.leave();
+		}
+
+	private:
+		epoch_domain &domain_;
+	};
+
+	// retire, 在全局 epoch_domain 中延迟释放
+	inline void retire(void *ptr, epoch_domain::deleter_type deleter) {
+		epoch_domain::instance().retire(ptr, deleter);
+	}
+
+	template <class T, class Alloc = wstl::allocator<T>>
+	void retire(T *ptr) {
+		epoch_domain::instance().template retire<T, Alloc>(ptr);
+	}
+}
+
+#endif // WSTL_EPOCH_H
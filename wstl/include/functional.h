@@ -0,0 +1,81 @@
+#ifndef WSTL_FUNCTIONAL_H
+#define WSTL_FUNCTIONAL_H
+
+// 这个头文件包含常用的函数对象：比较运算
+
+namespace wstl {
+
+	// less, 小于
+	template <class T>
+	struct less {
+		typedef T first_argument_type;
+		typedef T second_argument_type;
+		typedef bool result_type;
+
+		bool operator()(const T &x, const T &y) const {
+			return x < y;
+		}
+	};
+
+	// greater, 大于
+	template <class T>
+	struct greater {
+		typedef T first_argument_type;
+		typedef T second_argument_type;
+		typedef bool result_type;
+
+		bool operator()(const T &x, const T &y) const {
+			return y < x;
+		}
+	};
+
+	// less_equal, 小于等于
+	template <class T>
+	struct less_equal {
+		typedef T first_argument_type;
+		typedef T second_argument_type;
+		typedef bool result_type;
+
+		bool operator()(const T &x, const T &y) const {
+			return !(y < x);
+		}
+	};
+
+	// greater_equal, 大于等于
+	template <class T>
+	struct greater_equal {
+		typedef T first_argument_type;
+		typedef T second_argument_type;
+		typedef bool result_type;
+
+		bool operator()(const T &x, const T &y) const {
+			return !(x < y);
+		}
+	};
+
+	// equal_to, 等于
+	template <class T>
+	struct equal_to {
+		typedef T first_argument_type;
+		typedef T second_argument_type;
+		typedef bool result_type;
+
+		bool operator()(const T &x, const T &y) const {
+			return x == y;
+		}
+	};
+
+	// not_equal_to, 不等于
+	template <class T>
+	struct not_equal_to {
+		typedef T first_argument_type;
+		typedef T second_argument_type;
+		typedef bool result_type;
+
+		bool operator()(const T &x, const T &y) const {
+			return !(x == y);
+		}
+	};
+}
+
+#endif // WSTL_FUNCTIONAL_H
@@ -0,0 +1,481 @@
+#ifndef WSTL_INTRUSIVE_HASH_SET_H
+#define WSTL_INTRUSIVE_HASH_SET_H
+
+/*
+	该文件实现侵入式哈希集合 intrusive_hash_set<T, Hook, Hash, KeyEqual>
+
+	与 intrusive_list 一样，链表节点（intrusive_hash_hook）是用户对象的成员，由成员指针 Hook 指定，
+	集合不拥有对象，插入、删除元素从不分配节点，对象在集合中时不能被销毁、移动或修改参与哈希的字段。
+
+		struct session {
+			uint64_t id;
+			wstl::intrusive_hash_hook by_id;
+			wstl::intrusive_list_hook lru;
+			bool operator==(const session &rhs) const { return id == rhs.id; }
+		};
+		wstl::intrusive_hash_set<session, &session::by_id, session_hash> sessions;
+
+	存储：
+		2 的幂个桶，每个桶是一条单链表，hook 中缓存了元素的哈希值，扩容时不再调用 Hash，
+		查找时先比较哈希值再调用 KeyEqual。元素个数超过桶数时桶数翻倍，这是唯一的内存分配，
+		预先 reserve 后插入不会分配内存。
+
+	查找可以使用与 T 不同的键类型 K，要求 Hash 可以接受 K，KeyEqual 可以比较 (T, K)。
+	迭代器是前向迭代器，按桶的顺序遍历。
+*/
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "intrusive_list.h"
+#include "iterator.h"
+#include "util.h"
+#include "vector.h"
+
+namespace wstl {
+
+	/*****************************************************************************************/
+	// 									intrusive_hash_hook
+	/*****************************************************************************************/
+
+	// 未链接时 next 指向自身，链中最后一个节点的 next 为空指针
+	struct intrusive_hash_hook {
+		intrusive_hash_hook *next;
+		size_t hash;
+
+		intrusive_hash_hook() noexcept : next(this), hash(0) {}
+
+		intrusive_hash_hook(const intrusive_hash_hook &) noexcept : next(this), hash(0) {}
+
+		intrusive_hash_hook &operator=(const intrusive_hash_hook &) noexcept {
+			return *this;
+		}
+
+		bool is_linked() const noexcept {
+			return next != this;
+		}
+	};
+
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	class intrusive_hash_set;
+
+	/*****************************************************************************************/
+	// 									intrusive_hash_set 的迭代器
+	/*****************************************************************************************/
+
+	// 记录当前节点与所在的桶，走到链尾时向后寻找下一个非空桶；尾后迭代器的节点为空指针
+	template <class T, intrusive_hash_hook T::*Hook, bool Const>
+	struct intrusive_hash_iterator
+		: public wstl::iterator<wstl::forward_iterator_tag, T, ptrdiff_t, typename std::conditional<Const, const T *, T *>::type,
+								typename std::conditional<Const, const T &, T &>::type> {
+		typedef typename std::conditional<Const, const T *, T *>::type pointer;
+		typedef typename std::conditional<Const, const T &, T &>::type reference;
+		typedef intrusive_hash_iterator<T, Hook, Const> self;
+
+		intrusive_hash_hook *node;
+		intrusive_hash_hook *const *bucket; // node 所在的桶
+		intrusive_hash_hook *const *buckets_end;
+
+		intrusive_hash_iterator() noexcept : node(nullptr), bucket(nullptr), buckets_end(nullptr) {}
+
+		intrusive_hash_iterator(intrusive_hash_hook *n, intrusive_hash_hook *const *b, intrusive_hash_hook *const *e) noexcept
+			: node(n), bucket(b), buckets_end(e) {}
+
+		// 非 const 迭代器可以转换为 const 迭代器
+		template <bool C, class = typename std::enable_if<Const && !C>::type>
+		intrusive_hash_iterator(const intrusive_hash_iterator<T, Hook, C> &rhs) noexcept
+			: node(rhs.node), bucket(rhs.bucket), buckets_end(rhs.buckets_end) {}
+
+		reference operator*() const noexcept {
+			return *intrusive_owner(node, Hook);
+		}
+
+		pointer operator->() const noexcept {
+			return intrusive_owner(node, Hook);
+		}
+
+		self &operator++() noexcept {
+			node = node->next;
+			while (node == nullptr && ++bucket != buckets_end) {
+				node = *bucket;
+			}
+			return *this;
+		}
+
+		self operator++(int) noexcept {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const self &rhs) const noexcept {
+			return node == rhs.node;
+		}
+
+		bool operator!=(const self &rhs) const noexcept {
+			return node != rhs.node;
+		}
+	};
+
+	/*****************************************************************************************/
+	// 									intrusive_hash_set
+	/*****************************************************************************************/
+
+	template <class T, intrusive_hash_hook T::*Hook, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>>
+	class intrusive_hash_set {
+	public:
+		// intrusive_hash_set 的嵌套型别定义
+		typedef T value_type;
+		typedef T key_type;
+		typedef Hash hasher;
+		typedef KeyEqual key_equal;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef intrusive_hash_iterator<T, Hook, false> iterator;
+		typedef intrusive_hash_iterator<T, Hook, true> const_iterator;
+
+	private:
+		vector<intrusive_hash_hook *> buckets_;
+		size_type size_;
+		hasher hash_;
+		key_equal equal_;
+
+	public:
+		// 构造、移动、析构函数，集合不拥有元素，不能复制
+
+		explicit intrusive_hash_set(size_type bucket_count = 16, const hasher &hash = hasher(),
+									const key_equal &equal = key_equal())
+			: buckets_(round_up_buckets(bucket_count), nullptr), size_(0), hash_(hash), equal_(equal) {}
+
+		intrusive_hash_set(const intrusive_hash_set &) = delete;
+		intrusive_hash_set &operator=(const intrusive_hash_set &) = delete;
+
+		intrusive_hash_set(intrusive_hash_set &&rhs) noexcept
+			: buckets_(wstl::move(rhs.buckets_)), size_(rhs.size_), hash_(rhs.hash_), equal_(rhs.equal_) {
+			rhs.size_ = 0;
+		}
+
+		intrusive_hash_set &operator=(intrusive_hash_set &&rhs) noexcept {
+			if (this != &rhs) {
+				clear();
+				swap(rhs);
+			}
+			return *this;
+		}
+
+		~intrusive_hash_set() {
+			clear();
+		}
+
+	public:
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return make_begin<iterator>();
+		}
+
+		const_iterator begin() const noexcept {
+			return make_begin<const_iterator>();
+		}
+
+		iterator end() noexcept {
+			return iterator();
+		}
+
+		const_iterator end() const noexcept {
+			return const_iterator();
+		}
+
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+
+		const_iterator cend() const noexcept {
+			return end();
+		}
+
+		// iterator_to, 集合中的对象对应的迭代器，O(1)
+		iterator iterator_to(reference value) noexcept {
+			return make_iterator<iterator>(&(value.*Hook));
+		}
+
+		const_iterator iterator_to(const_reference value) const noexcept {
+			return make_iterator<const_iterator>(const_cast<intrusive_hash_hook *>(&(value.*Hook)));
+		}
+
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		size_type bucket_count() const noexcept {
+			return buckets_.size();
+		}
+
+		float load_factor() const noexcept {
+			return buckets_.empty() ? 0.0f : static_cast<float>(size_) / static_cast<float>(buckets_.size());
+		}
+
+		// rehash, 桶数调整为不小于 n 且不小于 size() 的 2 的幂
+		void rehash(size_type n);
+
+		// reserve, 之后插入 n 个以内的元素不会分配内存
+		void reserve(size_type n) {
+			if (n > buckets_.size()) {
+				rehash(n);
+			}
+		}
+
+		// 查找
+
+		template <class K>
+		iterator find(const K &key) {
+			return make_iterator<iterator>(find_node(key));
+		}
+
+		template <class K>
+		const_iterator find(const K &key) const {
+			return make_iterator<const_iterator>(find_node(key));
+		}
+
+		template <class K>
+		bool contains(const K &key) const {
+			return find_node(key) != nullptr;
+		}
+
+		template <class K>
+		size_type count(const K &key) const {
+			return contains(key) ? 1 : 0;
+		}
+
+		// 修改容器相关操作
+
+		// insert, 插入未链接的 value；已有相等元素时不插入，返回该元素
+		pair<iterator, bool> insert(reference value);
+
+		// erase, 摘下 position 处的元素，返回下一个位置
+		iterator erase(const_iterator position) noexcept;
+
+		iterator erase(iterator position) noexcept {
+			return erase(const_iterator(position));
+		}
+
+		// remove, 摘下集合中的对象 value，不计算下一个位置
+		void remove(reference value) noexcept {
+			WSTL_DEBUG((value.*Hook).is_linked());
+			unlink_node(&(value.*Hook));
+		}
+
+		// erase, 摘下与 key 相等的元素，返回摘下的个数
+		template <class K>
+		size_type erase(const K &key);
+
+		// clear, 摘下所有元素，不释放桶
+		void clear() noexcept;
+
+		void swap(intrusive_hash_set &rhs) noexcept {
+			buckets_.swap(rhs.buckets_);
+			wstl::swap(size_, rhs.size_);
+			wstl::swap(hash_, rhs.hash_);
+			wstl::swap(equal_, rhs.equal_);
+		}
+
+	private:
+		// helper functions
+
+		static size_type round_up_buckets(size_type n) noexcept {
+			size_type cap = 16;
+			while (cap < n) {
+				cap <<= 1;
+			}
+			return cap;
+		}
+
+		// hash_of, 对用户哈希值再做一次乘法混合，避免 std::hash 恒等映射导致低位分布不均
+		template <class K>
+		size_type hash_of(const K &key) const {
+			uint64_t h = static_cast<uint64_t>(hash_(key));
+			h ^= h >> 33;
+			h *= 0xFF51AFD7ED558CCDULL;
+			h ^= h >> 33;
+			return static_cast<size_type>(h);
+		}
+
+		size_type bucket_of(size_type hash) const noexcept {
+			return hash & (buckets_.size() - 1);
+		}
+
+		template <class K>
+		intrusive_hash_hook *find_node(const K &key) const {
+			return find_node(key, hash_of(key));
+		}
+
+		template <class K>
+		intrusive_hash_hook *find_node(const K &key, size_type hash) const;
+
+		template <class Iterator>
+		Iterator make_iterator(intrusive_hash_hook *node) const noexcept {
+			if (node == nullptr) {
+				return Iterator();
+			}
+			return Iterator(node, buckets_.data() + bucket_of(node->hash), buckets_.data() + buckets_.size());
+		}
+
+		template <class Iterator>
+		Iterator make_begin() const noexcept;
+
+		void unlink_node(intrusive_hash_hook *node) noexcept;
+	};
+
+	/*****************************************************************************************/
+
+	// rehash, 按缓存的哈希值重新分桶，不调用 Hash
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	void intrusive_hash_set<T, Hook, Hash, KeyEqual>::rehash(size_type n) {
+		const auto count = round_up_buckets(n < size_ ? size_ : n);
+		if (count == buckets_.size()) {
+			return;
+		}
+		vector<intrusive_hash_hook *> buckets(count, nullptr);
+		const auto mask = count - 1;
+		for (auto it = buckets_.begin(); it != buckets_.end(); ++it) {
+			auto node = *it;
+			while (node != nullptr) {
+				auto next = node->next;
+				auto &head = buckets[node->hash & mask];
+				node->next = head;
+				head = node;
+				node = next;
+			}
+		}
+		buckets_.swap(buckets);
+	}
+
+	// insert
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	pair<typename intrusive_hash_set<T, Hook, Hash, KeyEqual>::iterator, bool>
+	intrusive_hash_set<T, Hook, Hash, KeyEqual>::insert(reference value) {
+		auto &hook = value.*Hook;
+		WSTL_DEBUG(!hook.is_linked());
+		const auto hash = hash_of(value);
+		if (auto node = find_node(value, hash)) {
+			return pair<iterator, bool>(make_iterator<iterator>(node), false);
+		}
+		// 先扩容再链接，扩容失败时集合不变；被移动后的集合没有桶，也在这里重新分配
+		if (size_ + 1 > buckets_.size()) {
+			rehash(buckets_.size() * 2);
+		}
+		auto &head = buckets_[bucket_of(hash)];
+		hook.hash = hash;
+		hook.next = head;
+		head = &hook;
+		++size_;
+		return pair<iterator, bool>(make_iterator<iterator>(&hook), true);
+	}
+
+	// erase
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	typename intrusive_hash_set<T, Hook, Hash, KeyEqual>::iterator
+	intrusive_hash_set<T, Hook, Hash, KeyEqual>::erase(const_iterator position) noexcept {
+		WSTL_DEBUG(position != end());
+		auto next = position;
+		++next;
+		unlink_node(position.node);
+		return iterator(next.node, next.bucket, next.buckets_end);
+	}
+
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	template <class K>
+	typename intrusive_hash_set<T, Hook, Hash, KeyEqual>::size_type
+	intrusive_hash_set<T, Hook, Hash, KeyEqual>::erase(const K &key) {
+		const auto node = find_node(key);
+		if (node == nullptr) {
+			return 0;
+		}
+		unlink_node(node);
+		return 1;
+	}
+
+	// clear
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	void intrusive_hash_set<T, Hook, Hash, KeyEqual>::clear() noexcept {
+		if (size_ == 0) {
+			return;
+		}
+		for (auto it = buckets_.begin(); it != buckets_.end(); ++it) {
+			auto node = *it;
+			while (node != nullptr) {
+				auto next = node->next;
+				node->next = node;
+				node = next;
+			}
+			*it = nullptr;
+		}
+		size_ = 0;
+	}
+
+	// helper function
+
+	// find_node, 找不到时返回空指针
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	template <class K>
+	intrusive_hash_hook *intrusive_hash_set<T, Hook, Hash, KeyEqual>::find_node(const K &key, size_type hash) const {
+		if (buckets_.empty()) {
+			return nullptr;
+		}
+		for (auto node = buckets_[bucket_of(hash)]; node != nullptr; node = node->next) {
+			if (node->hash == hash && equal_(*intrusive_owner(node, Hook), key)) {
+				return node;
+			}
+		}
+		return nullptr;
+	}
+
+	// unlink_node, 单链表，从桶头找到前驱后摘下
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	void intrusive_hash_set<T, Hook, Hash, KeyEqual>::unlink_node(intrusive_hash_hook *node) noexcept {
+		auto link = &buckets_[bucket_of(node->hash)];
+		while (*link != node) {
+			link = &(*link)->next;
+		}
+		*link = node->next;
+		node->next = node;
+		--size_;
+	}
+
+	// make_begin, 第一个非空桶的链头
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	template <class Iterator>
+	Iterator intrusive_hash_set<T, Hook, Hash, KeyEqual>::make_begin() const noexcept {
+		if (size_ == 0) {
+			return Iterator();
+		}
+		auto first = buckets_.data();
+		auto last = first + buckets_.size();
+		while (*first == nullptr) {
+			++first;
+		}
+		return Iterator(*first, first, last);
+	}
+
+	// 重载 swap
+	template <class T, intrusive_hash_hook T::*Hook, class Hash, class KeyEqual>
+	void swap(intrusive_hash_set<T, Hook, Hash, KeyEqual> &lhs, intrusive_hash_set<T, Hook, Hash, KeyEqual> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_INTRUSIVE_HASH_SET_H
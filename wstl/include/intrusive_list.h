@@ -0,0 +1,525 @@
+#ifndef WSTL_INTRUSIVE_LIST_H
+#define WSTL_INTRUSIVE_LIST_H
+
+/*
+	该文件实现侵入式双向链表 intrusive_list<T, Hook>
+
+	链表节点（intrusive_list_hook）是用户对象的一个成员，由成员指针 Hook 指定：
+
+		struct task {
+			int id;
+			wstl::intrusive_list_hook run_hook;
+			wstl::intrusive_list_hook timer_hook;
+		};
+		wstl::intrusive_list<task, &task::run_hook> run_queue;
+		wstl::intrusive_list<task, &task::timer_hook> timers;
+
+	一个对象有几个 hook 就可以同时位于几个链表中。插入、删除只修改指针，从不分配内存，
+	对象的生命周期由用户管理：链表不拥有对象，析构或 clear 时只把其中的 hook 置为未链接，
+	对象在链表中时不能被销毁或移动。
+
+	迭代器是双向迭代器，可以直接用于 wstl 的算法。
+*/
+
+#include <cstddef>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace wstl {
+
+	/*****************************************************************************************/
+	// 									成员指针 → 宿主对象
+	/*****************************************************************************************/
+
+	// intrusive_hook_offset, 成员 member 在 T 中的字节偏移
+	// 在一块对齐的静态存储上取成员地址，不构造对象，也不对空指针解引用
+	template <class T, class Hook>
+	std::ptrdiff_t intrusive_hook_offset(Hook T::*member) noexcept {
+		static typename std::aligned_storage<sizeof(T), alignof(T)>::type probe;
+		const auto *object = reinterpret_cast<const T *>(&probe);
+		return reinterpret_cast<const char *>(&(object->*member)) - reinterpret_cast<const char *>(object);
+	}
+
+	// intrusive_owner, 由 hook 的地址得到包含它的对象
+	template <class T, class Hook>
+	T *intrusive_owner(Hook *hook, Hook T::*member) noexcept {
+		return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - intrusive_hook_offset(member));
+	}
+
+	template <class T, class Hook>
+	const T *intrusive_owner(const Hook *hook, Hook T::*member) noexcept {
+		return reinterpret_cast<const T *>(reinterpret_cast<const char *>(hook) - intrusive_hook_offset(member));
+	}
+
+	/*****************************************************************************************/
+	// 									intrusive_list_hook
+	/*****************************************************************************************/
+
+	// 复制对象时不复制链接状态，新对象总是未链接的
+	struct intrusive_list_hook {
+		intrusive_list_hook *prev;
+		intrusive_list_hook *next;
+
+		intrusive_list_hook() noexcept : prev(nullptr), next(nullptr) {}
+
+		intrusive_list_hook(const intrusive_list_hook &) noexcept : prev(nullptr), next(nullptr) {}
+
+		intrusive_list_hook &operator=(const intrusive_list_hook &) noexcept {
+			return *this;
+		}
+
+		bool is_linked() const noexcept {
+			return next != nullptr;
+		}
+
+		// unlink, 直接从所在的链表中摘下，不会更新链表的 size()，一般应通过链表的 erase / remove 删除
+		void unlink() noexcept {
+			prev->next = next;
+			next->prev = prev;
+			prev = next = nullptr;
+		}
+
+		// link_before, 链接到 pos 之前
+		void link_before(intrusive_list_hook *pos) noexcept {
+			prev = pos->prev;
+			next = pos;
+			pos->prev->next = this;
+			pos->prev = this;
+		}
+	};
+
+	/*****************************************************************************************/
+	// 									intrusive_list 的迭代器
+	/*****************************************************************************************/
+
+	template <class T, intrusive_list_hook T::*Hook>
+	struct intrusive_list_const_iterator;
+
+	template <class T, intrusive_list_hook T::*Hook>
+	struct intrusive_list_iterator : public wstl::iterator<wstl::bidirectional_iterator_tag, T> {
+		typedef T value_type;
+		typedef T *pointer;
+		typedef T &reference;
+		typedef intrusive_list_iterator<T, Hook> self;
+
+		intrusive_list_hook *node;
+
+		intrusive_list_iterator() noexcept : node(nullptr) {}
+
+		explicit intrusive_list_iterator(intrusive_list_hook *n) noexcept : node(n) {}
+
+		reference operator*() const noexcept {
+			return *intrusive_owner(node, Hook);
+		}
+
+		pointer operator->() const noexcept {
+			return intrusive_owner(node, Hook);
+		}
+
+		self &operator++() noexcept {
+			node = node->next;
+			return *this;
+		}
+
+		self operator++(int) noexcept {
+			self tmp = *this;
+			node = node->next;
+			return tmp;
+		}
+
+		self &operator--() noexcept {
+			node = node->prev;
+			return *this;
+		}
+
+		self operator--(int) noexcept {
+			self tmp = *this;
+			node = node->prev;
+			return tmp;
+		}
+
+		bool operator==(const self &rhs) const noexcept {
+			return node == rhs.node;
+		}
+
+		bool operator!=(const self &rhs) const noexcept {
+			return node != rhs.node;
+		}
+	};
+
+	template <class T, intrusive_list_hook T::*Hook>
+	struct intrusive_list_const_iterator : public wstl::iterator<wstl::bidirectional_iterator_tag, T> {
+		typedef T value_type;
+		typedef const T *pointer;
+		typedef const T &reference;
+		typedef intrusive_list_const_iterator<T, Hook> self;
+
+		const intrusive_list_hook *node;
+
+		intrusive_list_const_iterator() noexcept : node(nullptr) {}
+
+		explicit intrusive_list_const_iterator(const intrusive_list_hook *n) noexcept : node(n) {}
+
+		intrusive_list_const_iterator(const intrusive_list_iterator<T, Hook> &rhs) noexcept : node(rhs.node) {}
+
+		reference operator*() const noexcept {
+			return *intrusive_owner(node, Hook);
+		}
+
+		pointer operator->() const noexcept {
+			return intrusive_owner(node, Hook);
+		}
+
+		self &operator++() noexcept {
+			node = node->next;
+			return *this;
+		}
+
+		self operator++(int) noexcept {
+			self tmp = *this;
+			node = node->next;
+			return tmp;
+		}
+
+		self &operator--() noexcept {
+			node = node->prev;
+			return *this;
+		}
+
+		self operator--(int) noexcept {
+			self tmp = *this;
+			node = node->prev;
+			return tmp;
+		}
+
+		bool operator==(const self &rhs) const noexcept {
+			return node == rhs.node;
+		}
+
+		bool operator!=(const self &rhs) const noexcept {
+			return node != rhs.node;
+		}
+	};
+
+	/*****************************************************************************************/
+	// 									intrusive_list
+	/*****************************************************************************************/
+
+	// 以 head_ 为哨兵的环形链表，end() 指向 head_
+	template <class T, intrusive_list_hook T::*Hook>
+	class intrusive_list {
+	public:
+		// intrusive_list 的嵌套型别定义
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef intrusive_list_iterator<T, Hook> iterator;
+		typedef intrusive_list_const_iterator<T, Hook> const_iterator;
+		typedef wstl::reverse_iterator<iterator> reverse_iterator;
+		typedef wstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		intrusive_list_hook head_;
+		size_type size_;
+
+	public:
+		// 构造、移动、析构函数，链表不拥有元素，不能复制
+
+		intrusive_list() noexcept : size_(0) {
+			head_.prev = head_.next = &head_;
+		}
+
+		intrusive_list(const intrusive_list &) = delete;
+		intrusive_list &operator=(const intrusive_list &) = delete;
+
+		intrusive_list(intrusive_list &&rhs) noexcept : intrusive_list() {
+			swap(rhs);
+		}
+
+		intrusive_list &operator=(intrusive_list &&rhs) noexcept {
+			if (this != &rhs) {
+				clear();
+				swap(rhs);
+			}
+			return *this;
+		}
+
+		~intrusive_list() {
+			clear();
+		}
+
+	public:
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return iterator(head_.next);
+		}
+
+		const_iterator begin() const noexcept {
+			return const_iterator(head_.next);
+		}
+
+		iterator end() noexcept {
+			return iterator(&head_);
+		}
+
+		const_iterator end() const noexcept {
+			return const_iterator(&head_);
+		}
+
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() noexcept {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+
+		const_iterator cend() const noexcept {
+			return end();
+		}
+
+		// iterator_to, 链表中的对象对应的迭代器，O(1)
+		iterator iterator_to(reference value) noexcept {
+			WSTL_DEBUG((value.*Hook).is_linked());
+			return iterator(&(value.*Hook));
+		}
+
+		const_iterator iterator_to(const_reference value) const noexcept {
+			WSTL_DEBUG((value.*Hook).is_linked());
+			return const_iterator(&(value.*Hook));
+		}
+
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return head_.next == &head_;
+		}
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		// 访问元素
+
+		reference front() {
+			WSTL_DEBUG(!empty());
+			return *begin();
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return *begin();
+		}
+
+		reference back() {
+			WSTL_DEBUG(!empty());
+			return *iterator(head_.prev);
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return *const_iterator(head_.prev);
+		}
+
+		// 修改容器相关操作，都不分配内存
+
+		// insert, 把未链接的 value 插入到 position 之前
+		iterator insert(const_iterator position, reference value) noexcept {
+			auto &hook = value.*Hook;
+			WSTL_DEBUG(!hook.is_linked());
+			hook.link_before(const_cast<intrusive_list_hook *>(position.node));
+			++size_;
+			return iterator(&hook);
+		}
+
+		void push_front(reference value) noexcept {
+			insert(begin(), value);
+		}
+
+		void push_back(reference value) noexcept {
+			insert(end(), value);
+		}
+
+		void pop_front() noexcept {
+			WSTL_DEBUG(!empty());
+			erase(begin());
+		}
+
+		void pop_back() noexcept {
+			WSTL_DEBUG(!empty());
+			erase(iterator(head_.prev));
+		}
+
+		// erase, 摘下 position 处的元素，返回下一个位置
+		iterator erase(const_iterator position) noexcept {
+			WSTL_DEBUG(position != end());
+			auto node = const_cast<intrusive_list_hook *>(position.node);
+			auto next = node->next;
+			node->unlink();
+			--size_;
+			return iterator(next);
+		}
+
+		iterator erase(const_iterator first, const_iterator last) noexcept {
+			while (first != last) {
+				first = erase(first);
+			}
+			return iterator(const_cast<intrusive_list_hook *>(last.node));
+		}
+
+		// remove, 摘下链表中的对象 value
+		void remove(reference value) noexcept {
+			erase(iterator_to(value));
+		}
+
+		template <class UnaryPredicate>
+		size_type remove_if(UnaryPredicate pred);
+
+		// clear, 摘下所有元素
+		void clear() noexcept;
+
+		// splice, 把 rhs 的全部元素移到 position 之前
+		void splice(const_iterator position, intrusive_list &rhs) noexcept;
+
+		// splice, 把 rhs 中 it 处的元素移到 position 之前
+		void splice(const_iterator position, intrusive_list &rhs, const_iterator it) noexcept;
+
+		void reverse() noexcept;
+
+		void swap(intrusive_list &rhs) noexcept;
+
+	private:
+		// helper functions
+
+		// 把哨兵 head_ 重新接到 [first, last] 两端
+		void adopt(intrusive_list_hook *first, intrusive_list_hook *last) noexcept {
+			head_.next = first;
+			head_.prev = last;
+			first->prev = &head_;
+			last->next = &head_;
+		}
+	};
+
+	/*****************************************************************************************/
+
+	// remove_if, 返回摘下的元素个数
+	template <class T, intrusive_list_hook T::*Hook>
+	template <class UnaryPredicate>
+	typename intrusive_list<T, Hook>::size_type intrusive_list<T, Hook>::remove_if(UnaryPredicate pred) {
+		const auto old_size = size_;
+		for (auto it = begin(); it != end();) {
+			if (pred(*it)) {
+				it = erase(it);
+			} else {
+				++it;
+			}
+		}
+		return old_size - size_;
+	}
+
+	// clear
+	template <class T, intrusive_list_hook T::*Hook>
+	void intrusive_list<T, Hook>::clear() noexcept {
+		auto node = head_.next;
+		while (node != &head_) {
+			auto next = node->next;
+			node->prev = node->next = nullptr;
+			node = next;
+		}
+		head_.prev = head_.next = &head_;
+		size_ = 0;
+	}
+
+	// splice
+	template <class T, intrusive_list_hook T::*Hook>
+	void intrusive_list<T, Hook>::splice(const_iterator position, intrusive_list &rhs) noexcept {
+		if (this == &rhs || rhs.empty()) {
+			return;
+		}
+		auto pos = const_cast<intrusive_list_hook *>(position.node);
+		auto first = rhs.head_.next;
+		auto last = rhs.head_.prev;
+		first->prev = pos->prev;
+		last->next = pos;
+		pos->prev->next = first;
+		pos->prev = last;
+		size_ += rhs.size_;
+		rhs.head_.prev = rhs.head_.next = &rhs.head_;
+		rhs.size_ = 0;
+	}
+
+	template <class T, intrusive_list_hook T::*Hook>
+	void intrusive_list<T, Hook>::splice(const_iterator position, intrusive_list &rhs, const_iterator it) noexcept {
+		WSTL_DEBUG(it != rhs.end());
+		if (position == it || position.node == it.node->next) {
+			return;
+		}
+		auto node = const_cast<intrusive_list_hook *>(it.node);
+		node->unlink();
+		node->link_before(const_cast<intrusive_list_hook *>(position.node));
+		--rhs.size_;
+		++size_;
+	}
+
+	// reverse, 交换每个节点（包括哨兵）的前后指针
+	template <class T, intrusive_list_hook T::*Hook>
+	void intrusive_list<T, Hook>::reverse() noexcept {
+		auto node = &head_;
+		do {
+			wstl::swap(node->prev, node->next);
+			node = node->prev;
+		} while (node != &head_);
+	}
+
+	// swap, 哨兵在对象内部，交换时要修正首尾元素指向哨兵的指针
+	template <class T, intrusive_list_hook T::*Hook>
+	void intrusive_list<T, Hook>::swap(intrusive_list &rhs) noexcept {
+		if (this == &rhs) {
+			return;
+		}
+		auto first = head_.next;
+		auto last = head_.prev;
+		const bool was_empty = empty();
+		if (rhs.empty()) {
+			head_.prev = head_.next = &head_;
+		} else {
+			adopt(rhs.head_.next, rhs.head_.prev);
+		}
+		if (was_empty) {
+			rhs.head_.prev = rhs.head_.next = &rhs.head_;
+		} else {
+			rhs.adopt(first, last);
+		}
+		wstl::swap(size_, rhs.size_);
+	}
+
+	// 重载 swap
+	template <class T, intrusive_list_hook T::*Hook>
+	void swap(intrusive_list<T, Hook> &lhs, intrusive_list<T, Hook> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_INTRUSIVE_LIST_H
@@ -197,6 +197,24 @@ namespace wstl {
 		__advance(i, n, iterator_category(i));
 	}
 
+	// 检查 [first, last) 是否为合法区间，供 WSTL_DEBUG 使用
+	// 只有随机访问迭代器能廉价地比较先后，其余迭代器（例如只能遍历一次的输入迭代器）视为合法
+
+	template <class InputIterator>
+	bool __valid_range(InputIterator, InputIterator, input_iterator_tag) {
+		return true;
+	}
+
+	template <class RandomAccessIterator>
+	bool __valid_range(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
+		return !(last < first);
+	}
+
+	template <class InputIterator>
+	bool valid_range(InputIterator first, InputIterator last) {
+		return __valid_range(first, last, iterator_category(first));
+	}
+
 	// -------------------reverse_iterator-------------------
 
 	// reverse_iterator 模板类， 逆向迭代器
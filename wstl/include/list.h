@@ -0,0 +1,1014 @@
+#ifndef WSTL_LIST_H
+#define WSTL_LIST_H
+
+/*
+	该文件实现 list 容器：带哨兵节点的双向环形链表
+
+	节点通过 Alloc::rebind<list_node<T>>::other 分配，每次只分配一个节点，
+	配合 pool_allocator（见 pool_allocator.h）时稳定状态下的插入、删除不调用 operator new：
+
+		wstl::list<entry, wstl::pool_allocator<entry>> lru;
+
+	哨兵节点是 list 对象的成员，空链表不分配内存；splice、merge、sort、reverse 只修改指针，
+	sort 是自底向上的归并排序，只使用栈上的 64 个链表头，不分配内存，并且是稳定的。
+
+	异常保证：
+	list<T> 满足基本异常保证，以下函数提供强异常安全保证：
+		emplace，emplace_front，emplace_back，push_front，push_back，insert
+	sort、merge 中比较操作抛出异常时，所有元素仍在链表中，顺序未指定。
+*/
+
+#include <initializer_list>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace wstl {
+
+	// list 的节点：前后指针放在与类型无关的基类中，哨兵节点只有基类部分
+	struct list_node_base {
+		list_node_base *prev;
+		list_node_base *next;
+
+		// link_before, 链接到 pos 之前
+		void link_before(list_node_base *pos) noexcept {
+			prev = pos->prev;
+			next = pos;
+			pos->prev->next = this;
+			pos->prev = this;
+		}
+
+		void unlink() noexcept {
+			prev->next = next;
+			next->prev = prev;
+		}
+
+		// transfer, 把 [first, last) 移到 pos 之前，pos 不能在 [first, last) 中
+		static void transfer(list_node_base *pos, list_node_base *first, list_node_base *last) noexcept {
+			if (pos == last || first == last) {
+				return;
+			}
+			auto tail = last->prev;
+			first->prev->next = last;
+			last->prev = first->prev;
+			first->prev = pos->prev;
+			tail->next = pos;
+			pos->prev->next = first;
+			pos->prev = tail;
+		}
+	};
+
+	template <class T>
+	struct list_node : public list_node_base {
+		T value;
+	};
+
+	/*****************************************************************************************/
+	// 									list 的迭代器
+	/*****************************************************************************************/
+
+	template <class T>
+	struct list_iterator : public wstl::iterator<wstl::bidirectional_iterator_tag, T> {
+		typedef T value_type;
+		typedef T *pointer;
+		typedef T &reference;
+		typedef list_iterator<T> self;
+
+		list_node_base *node;
+
+		list_iterator() noexcept : node(nullptr) {}
+
+		explicit list_iterator(list_node_base *n) noexcept : node(n) {}
+
+		reference operator*() const noexcept {
+			return static_cast<list_node<T> *>(node)->value;
+		}
+
+		pointer operator->() const noexcept {
+			return wstl::address_of(operator*());
+		}
+
+		self &operator++() noexcept {
+			node = node->next;
+			return *this;
+		}
+
+		self operator++(int) noexcept {
+			self tmp = *this;
+			node = node->next;
+			return tmp;
+		}
+
+		self &operator--() noexcept {
+			node = node->prev;
+			return *this;
+		}
+
+		self operator--(int) noexcept {
+			self tmp = *this;
+			node = node->prev;
+			return tmp;
+		}
+
+		bool operator==(const self &rhs) const noexcept {
+			return node == rhs.node;
+		}
+
+		bool operator!=(const self &rhs) const noexcept {
+			return node != rhs.node;
+		}
+	};
+
+	template <class T>
+	struct list_const_iterator : public wstl::iterator<wstl::bidirectional_iterator_tag, T> {
+		typedef T value_type;
+		typedef const T *pointer;
+		typedef const T &reference;
+		typedef list_const_iterator<T> self;
+
+		const list_node_base *node;
+
+		list_const_iterator() noexcept : node(nullptr) {}
+
+		explicit list_const_iterator(const list_node_base *n) noexcept : node(n) {}
+
+		list_const_iterator(const list_iterator<T> &rhs) noexcept : node(rhs.node) {}
+
+		reference operator*() const noexcept {
+			return static_cast<const list_node<T> *>(node)->value;
+		}
+
+		pointer operator->() const noexcept {
+			return wstl::address_of(operator*());
+		}
+
+		self &operator++() noexcept {
+			node = node->next;
+			return *this;
+		}
+
+		self operator++(int) noexcept {
+			self tmp = *this;
+			node = node->next;
+			return tmp;
+		}
+
+		self &operator--() noexcept {
+			node = node->prev;
+			return *this;
+		}
+
+		self operator--(int) noexcept {
+			self tmp = *this;
+			node = node->prev;
+			return tmp;
+		}
+
+		bool operator==(const self &rhs) const noexcept {
+			return node == rhs.node;
+		}
+
+		bool operator!=(const self &rhs) const noexcept {
+			return node != rhs.node;
+		}
+	};
+
+	/*****************************************************************************************/
+	// 									list
+	/*****************************************************************************************/
+
+	// list 类模板
+	template <class T, class Alloc = wstl::allocator<T>>
+	class list {
+	public:
+		// list 的嵌套型别定义
+		typedef Alloc allocator_type;
+		typedef Alloc data_allocator;
+		typedef typename Alloc::template rebind<list_node<T>>::other node_allocator;
+
+		typedef typename allocator_type::value_type value_type;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::size_type size_type;
+		typedef typename allocator_type::difference_type difference_type;
+
+		typedef list_iterator<T> iterator;
+		typedef list_const_iterator<T> const_iterator;
+		typedef wstl::reverse_iterator<iterator> reverse_iterator;
+		typedef wstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		allocator_type get_allocator() const {
+			return data_allocator();
+		}
+
+	private:
+		list_node_base head_; // 哨兵，end() 指向它
+		size_type size_;
+
+	public:
+		// 构造、复制、移动、析构函数
+		// 先委托默认构造函数建立空链表，之后的构造过程抛出异常时析构函数会释放已插入的节点
+
+		list() noexcept : size_(0) {
+			head_.prev = head_.next = &head_;
+		}
+
+		explicit list(size_type n) : list() {
+			resize(n);
+		}
+
+		list(size_type n, const value_type &value) : list() {
+			insert(end(), n, value);
+		}
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		list(InputIterator first, InputIterator last) : list() {
+			insert(end(), first, last);
+		}
+
+		list(std::initializer_list<value_type> il) : list() {
+			insert(end(), il.begin(), il.end());
+		}
+
+		list(const list &rhs) : list() {
+			insert(end(), rhs.begin(), rhs.end());
+		}
+
+		list(list &&rhs) noexcept : list() {
+			swap(rhs);
+		}
+
+		list &operator=(const list &rhs) {
+			if (this != &rhs) {
+				assign(rhs.begin(), rhs.end());
+			}
+			return *this;
+		}
+
+		list &operator=(list &&rhs) noexcept {
+			if (this != &rhs) {
+				clear();
+				swap(rhs);
+			}
+			return *this;
+		}
+
+		list &operator=(std::initializer_list<value_type> il) {
+			assign(il.begin(), il.end());
+			return *this;
+		}
+
+		~list() {
+			clear();
+		}
+
+	public:
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return iterator(head_.next);
+		}
+
+		const_iterator begin() const noexcept {
+			return const_iterator(head_.next);
+		}
+
+		iterator end() noexcept {
+			return iterator(&head_);
+		}
+
+		const_iterator end() const noexcept {
+			return const_iterator(&head_);
+		}
+
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() noexcept {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+
+		const_iterator cend() const noexcept {
+			return end();
+		}
+
+		const_reverse_iterator crbegin() const noexcept {
+			return rbegin();
+		}
+
+		const_reverse_iterator crend() const noexcept {
+			return rend();
+		}
+
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return head_.next == &head_;
+		}
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		size_type max_size() const noexcept {
+			return static_cast<size_type>(-1) / sizeof(list_node<T>);
+		}
+
+		// 访问元素相关操作
+
+		reference front() {
+			WSTL_DEBUG(!empty());
+			return *begin();
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return *begin();
+		}
+
+		reference back() {
+			WSTL_DEBUG(!empty());
+			return *iterator(head_.prev);
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return *const_iterator(head_.prev);
+		}
+
+		// 修改容器相关操作
+
+		// assign, 复用已有节点，多出的节点释放，不足时再分配
+
+		void assign(size_type n, const value_type &value);
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		void assign(InputIterator first, InputIterator last);
+
+		void assign(std::initializer_list<value_type> il) {
+			assign(il.begin(), il.end());
+		}
+
+		// emplace / emplace_front / emplace_back
+
+		template <class... Args>
+		iterator emplace(const_iterator position, Args &&...args);
+
+		template <class... Args>
+		reference emplace_front(Args &&...args) {
+			return *emplace(begin(), wstl::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		reference emplace_back(Args &&...args) {
+			return *emplace(end(), wstl::forward<Args>(args)...);
+		}
+
+		// push_front / push_back
+
+		void push_front(const value_type &value) {
+			emplace(begin(), value);
+		}
+
+		void push_front(value_type &&value) {
+			emplace(begin(), wstl::move(value));
+		}
+
+		void push_back(const value_type &value) {
+			emplace(end(), value);
+		}
+
+		void push_back(value_type &&value) {
+			emplace(end(), wstl::move(value));
+		}
+
+		// pop_front / pop_back
+
+		void pop_front() {
+			WSTL_DEBUG(!empty());
+			erase(begin());
+		}
+
+		void pop_back() {
+			WSTL_DEBUG(!empty());
+			erase(const_iterator(head_.prev));
+		}
+
+		// insert, 返回第一个插入的元素，没有插入时返回 position
+
+		iterator insert(const_iterator position, const value_type &value) {
+			return emplace(position, value);
+		}
+
+		iterator insert(const_iterator position, value_type &&value) {
+			return emplace(position, wstl::move(value));
+		}
+
+		iterator insert(const_iterator position, size_type n, const value_type &value);
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		iterator insert(const_iterator position, InputIterator first, InputIterator last);
+
+		iterator insert(const_iterator position, std::initializer_list<value_type> il) {
+			return insert(position, il.begin(), il.end());
+		}
+
+		// erase
+
+		iterator erase(const_iterator position);
+
+		iterator erase(const_iterator first, const_iterator last);
+
+		void clear() noexcept;
+
+		// resize
+
+		void resize(size_type n);
+
+		void resize(size_type n, const value_type &value);
+
+		void swap(list &rhs) noexcept;
+
+		// 链表操作，都不分配内存
+
+		// splice, 把 rhs 的全部元素移到 position 之前
+		void splice(const_iterator position, list &rhs) noexcept;
+
+		void splice(const_iterator position, list &&rhs) noexcept {
+			splice(position, rhs);
+		}
+
+		// splice, 把 rhs 中 it 处的元素移到 position 之前，rhs 可以是 *this
+		void splice(const_iterator position, list &rhs, const_iterator it) noexcept;
+
+		void splice(const_iterator position, list &&rhs, const_iterator it) noexcept {
+			splice(position, rhs, it);
+		}
+
+		// splice, 把 rhs 中 [first, last) 的元素移到 position 之前
+		// rhs 不是 *this 时需要 O(n) 计算元素个数，rhs 是 *this 时 position 不能在 [first, last) 中
+		void splice(const_iterator position, list &rhs, const_iterator first, const_iterator last) noexcept;
+
+		void splice(const_iterator position, list &&rhs, const_iterator first, const_iterator last) noexcept {
+			splice(position, rhs, first, last);
+		}
+
+		// remove / remove_if / unique, 返回删除的元素个数
+
+		size_type remove(const value_type &value);
+
+		template <class UnaryPredicate>
+		size_type remove_if(UnaryPredicate pred);
+
+		size_type unique() {
+			return unique(wstl::equal_to<T>());
+		}
+
+		template <class BinaryPredicate>
+		size_type unique(BinaryPredicate pred);
+
+		// merge, 把有序的 rhs 合并到有序的 *this 中，相等的元素 *this 中的在前
+
+		void merge(list &rhs) {
+			merge(rhs, wstl::less<T>());
+		}
+
+		void merge(list &&rhs) {
+			merge(rhs, wstl::less<T>());
+		}
+
+		template <class Compare>
+		void merge(list &rhs, Compare comp);
+
+		template <class Compare>
+		void merge(list &&rhs, Compare comp) {
+			merge(rhs, comp);
+		}
+
+		// sort, 稳定的归并排序
+
+		void sort() {
+			sort(wstl::less<T>());
+		}
+
+		template <class Compare>
+		void sort(Compare comp);
+
+		void reverse() noexcept;
+
+	private:
+		// helper functions
+
+		static reference value_of(list_node_base *node) noexcept {
+			return static_cast<list_node<T> *>(node)->value;
+		}
+
+		static list_node_base *mutable_node(const_iterator it) noexcept {
+			return const_cast<list_node_base *>(it.node);
+		}
+
+		// create / destroy node
+
+		template <class... Args>
+		static list_node<T> *create_node(Args &&...args);
+
+		static void destroy_node(list_node_base *node) noexcept;
+
+		// 链表头与一条非空的首尾相连的节点链
+		void adopt(list_node_base *first, list_node_base *last) noexcept {
+			head_.next = first;
+			head_.prev = last;
+			first->prev = &head_;
+			last->next = &head_;
+		}
+
+		// sort helper
+
+		template <class Compare>
+		static void merge_chains(list_node_base *&dst, list_node_base *src, Compare &comp);
+
+		static list_node_base *concat_chains(list_node_base *first, list_node_base *second) noexcept;
+
+		void relink_chain(list_node_base *chain) noexcept;
+	};
+
+	/*****************************************************************************************/
+
+	// assign
+	template <class T, class Alloc>
+	void list<T, Alloc>::assign(size_type n, const value_type &value) {
+		auto it = begin();
+		for (; it != end() && n > 0; ++it, --n) {
+			*it = value;
+		}
+		if (n > 0) {
+			insert(end(), n, value);
+		} else {
+			erase(it, end());
+		}
+	}
+
+	template <class T, class Alloc>
+	template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type>
+	void list<T, Alloc>::assign(InputIterator first, InputIterator last) {
+		auto it = begin();
+		for (; it != end() && first != last; ++it, ++first) {
+			*it = *first;
+		}
+		if (first != last) {
+			insert(end(), first, last);
+		} else {
+			erase(it, end());
+		}
+	}
+
+	// emplace, 在 position 之前构造元素
+	template <class T, class Alloc>
+	template <class... Args>
+	typename list<T, Alloc>::iterator list<T, Alloc>::emplace(const_iterator position, Args &&...args) {
+		THROW_LENGTH_ERROR_IF(size_ >= max_size(), "list<T>'s size too big");
+		auto node = create_node(wstl::forward<Args>(args)...);
+		node->link_before(mutable_node(position));
+		++size_;
+		return iterator(node);
+	}
+
+	// insert, 先在临时链表中构造全部元素再整体接入，构造失败时 *this 不变
+	template <class T, class Alloc>
+	typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator position, size_type n, const value_type &value) {
+		THROW_LENGTH_ERROR_IF(n > max_size() - size_, "list<T>'s size too big");
+		list tmp;
+		for (; n > 0; --n) {
+			tmp.emplace_back(value);
+		}
+		const auto first = tmp.begin();
+		splice(position, tmp);
+		return first == tmp.end() ? iterator(mutable_node(position)) : first;
+	}
+
+	template <class T, class Alloc>
+	template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type>
+	typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator position, InputIterator first,
+															 InputIterator last) {
+		list tmp;
+		for (; first != last; ++first) {
+			tmp.emplace_back(*first);
+		}
+		THROW_LENGTH_ERROR_IF(tmp.size_ > max_size() - size_, "list<T>'s size too big");
+		const auto result = tmp.begin();
+		splice(position, tmp);
+		return result == tmp.end() ? iterator(mutable_node(position)) : result;
+	}
+
+	// erase
+	template <class T, class Alloc>
+	typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator position) {
+		WSTL_DEBUG(position != end());
+		auto node = mutable_node(position);
+		auto next = node->next;
+		node->unlink();
+		destroy_node(node);
+		--size_;
+		return iterator(next);
+	}
+
+	template <class T, class Alloc>
+	typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator first, const_iterator last) {
+		while (first != last) {
+			first = erase(first);
+		}
+		return iterator(mutable_node(last));
+	}
+
+	// clear
+	template <class T, class Alloc>
+	void list<T, Alloc>::clear() noexcept {
+		auto node = head_.next;
+		while (node != &head_) {
+			auto next = node->next;
+			destroy_node(node);
+			node = next;
+		}
+		head_.prev = head_.next = &head_;
+		size_ = 0;
+	}
+
+	// resize
+	template <class T, class Alloc>
+	void list<T, Alloc>::resize(size_type n) {
+		if (n < size_) {
+			auto it = end();
+			for (auto k = size_ - n; k > 0; --k) {
+				--it;
+			}
+			erase(it, end());
+		} else {
+			list tmp;
+			for (auto k = n - size_; k > 0; --k) {
+				tmp.emplace_back();
+			}
+			splice(end(), tmp);
+		}
+	}
+
+	template <class T, class Alloc>
+	void list<T, Alloc>::resize(size_type n, const value_type &value) {
+		if (n < size_) {
+			auto it = end();
+			for (auto k = size_ - n; k > 0; --k) {
+				--it;
+			}
+			erase(it, end());
+		} else {
+			insert(end(), n - size_, value);
+		}
+	}
+
+	// swap, 哨兵在对象内部，交换时要修正首尾节点指向哨兵的指针
+	template <class T, class Alloc>
+	void list<T, Alloc>::swap(list &rhs) noexcept {
+		if (this == &rhs) {
+			return;
+		}
+		auto first = head_.next;
+		auto last = head_.prev;
+		const bool was_empty = empty();
+		if (rhs.empty()) {
+			head_.prev = head_.next = &head_;
+		} else {
+			adopt(rhs.head_.next, rhs.head_.prev);
+		}
+		if (was_empty) {
+			rhs.head_.prev = rhs.head_.next = &rhs.head_;
+		} else {
+			rhs.adopt(first, last);
+		}
+		wstl::swap(size_, rhs.size_);
+	}
+
+	// splice
+	template <class T, class Alloc>
+	void list<T, Alloc>::splice(const_iterator position, list &rhs) noexcept {
+		if (this == &rhs || rhs.empty()) {
+			return;
+		}
+		list_node_base::transfer(mutable_node(position), rhs.head_.next, &rhs.head_);
+		size_ += rhs.size_;
+		rhs.size_ = 0;
+	}
+
+	template <class T, class Alloc>
+	void list<T, Alloc>::splice(const_iterator position, list &rhs, const_iterator it) noexcept {
+		WSTL_DEBUG(it != rhs.end());
+		auto node = mutable_node(it);
+		auto pos = mutable_node(position);
+		if (pos == node || pos == node->next) {
+			return; // 移到自身或自身之后的位置，不需要移动
+		}
+		list_node_base::transfer(pos, node, node->next);
+		if (this != &rhs) {
+			--rhs.size_;
+			++size_;
+		}
+	}
+
+	template <class T, class Alloc>
+	void list<T, Alloc>::splice(const_iterator position, list &rhs, const_iterator first, const_iterator last) noexcept {
+		if (first == last) {
+			return;
+		}
+		if (this != &rhs) {
+			const auto n = static_cast<size_type>(wstl::distance(first, last));
+			rhs.size_ -= n;
+			size_ += n;
+		}
+		list_node_base::transfer(mutable_node(position), mutable_node(first), mutable_node(last));
+	}
+
+	// remove, value 可能引用链表中的元素，这样的节点最后删除
+	template <class T, class Alloc>
+	typename list<T, Alloc>::size_type list<T, Alloc>::remove(const value_type &value) {
+		const auto old_size = size_;
+		auto deferred = end();
+		for (auto it = begin(); it != end();) {
+			auto next = it;
+			++next;
+			if (*it == value) {
+				if (wstl::address_of(*it) != wstl::address_of(value)) {
+					erase(it);
+				} else {
+					deferred = it;
+				}
+			}
+			it = next;
+		}
+		if (deferred != end()) {
+			erase(deferred);
+		}
+		return old_size - size_;
+	}
+
+	// remove_if
+	template <class T, class Alloc>
+	template <class UnaryPredicate>
+	typename list<T, Alloc>::size_type list<T, Alloc>::remove_if(UnaryPredicate pred) {
+		const auto old_size = size_;
+		for (auto it = begin(); it != end();) {
+			if (pred(*it)) {
+				it = erase(it);
+			} else {
+				++it;
+			}
+		}
+		return old_size - size_;
+	}
+
+	// unique, 删除与前一个保留的元素满足 pred 的元素
+	template <class T, class Alloc>
+	template <class BinaryPredicate>
+	typename list<T, Alloc>::size_type list<T, Alloc>::unique(BinaryPredicate pred) {
+		const auto old_size = size_;
+		if (empty()) {
+			return 0;
+		}
+		auto it = begin();
+		auto next = it;
+		while (++next != end()) {
+			if (pred(*it, *next)) {
+				erase(next);
+				next = it;
+			} else {
+				it = next;
+			}
+		}
+		return old_size - size_;
+	}
+
+	// merge, 逐个把 rhs 的节点移到 *this 中的位置，每一步之后两个链表都是完整的
+	template <class T, class Alloc>
+	template <class Compare>
+	void list<T, Alloc>::merge(list &rhs, Compare comp) {
+		if (this == &rhs) {
+			return;
+		}
+		auto first1 = begin();
+		auto first2 = rhs.begin();
+		while (first1 != end() && first2 != rhs.end()) {
+			if (comp(*first2, *first1)) {
+				auto next = first2;
+				++next;
+				list_node_base::transfer(first1.node, first2.node, next.node);
+				--rhs.size_;
+				++size_;
+				first2 = next;
+			} else {
+				++first1;
+			}
+		}
+		splice(end(), rhs);
+	}
+
+	// sort
+	// 自底向上归并：bins[i] 为空或是一条长度为 2^i 的有序单链（以空指针结尾），
+	// 每取下一个节点就像二进制加一那样逐级合并。下标大的 bin 中的元素更早出现，合并时放在前面以保持稳定。
+	// 比较抛出异常时把所有链重新串成链表，再继续抛出
+	template <class T, class Alloc>
+	template <class Compare>
+	void list<T, Alloc>::sort(Compare comp) {
+		if (size_ < 2) {
+			return;
+		}
+		list_node_base *bins[64] = {};
+		size_type fill = 0;
+		auto rest = head_.next;
+		head_.prev->next = nullptr;
+		list_node_base *carry = nullptr;
+		try {
+			while (rest != nullptr) {
+				carry = rest;
+				rest = rest->next;
+				carry->next = nullptr;
+				size_type i = 0;
+				for (; i < fill && bins[i] != nullptr; ++i) {
+					auto later = carry;
+					carry = bins[i];
+					bins[i] = nullptr;
+					merge_chains(carry, later, comp);
+				}
+				bins[i] = carry;
+				carry = nullptr;
+				if (i == fill) {
+					++fill;
+				}
+			}
+			for (size_type i = 0; i < fill; ++i) {
+				if (bins[i] != nullptr) {
+					auto later = carry;
+					carry = bins[i];
+					bins[i] = nullptr;
+					if (later != nullptr) {
+						merge_chains(carry, later, comp);
+					}
+				}
+			}
+		} catch (...) {
+			for (size_type i = 0; i < fill; ++i) {
+				carry = concat_chains(carry, bins[i]);
+			}
+			relink_chain(concat_chains(carry, rest));
+			throw;
+		}
+		relink_chain(carry);
+	}
+
+	// reverse, 交换每个节点（包括哨兵）的前后指针
+	template <class T, class Alloc>
+	void list<T, Alloc>::reverse() noexcept {
+		list_node_base *node = &head_;
+		do {
+			wstl::swap(node->prev, node->next);
+			node = node->prev;
+		} while (node != &head_);
+	}
+
+	// helper function
+
+	// create_node, 构造失败时释放节点
+	template <class T, class Alloc>
+	template <class... Args>
+	list_node<T> *list<T, Alloc>::create_node(Args &&...args) {
+		auto node = node_allocator::allocate(1);
+		try {
+			data_allocator::construct(wstl::address_of(node->value), wstl::forward<Args>(args)...);
+		} catch (...) {
+			node_allocator::deallocate(node, 1);
+			throw;
+		}
+		return node;
+	}
+
+	template <class T, class Alloc>
+	void list<T, Alloc>::destroy_node(list_node_base *node) noexcept {
+		auto p = static_cast<list_node<T> *>(node);
+		data_allocator::destroy(wstl::address_of(p->value));
+		node_allocator::deallocate(p, 1);
+	}
+
+	// merge_chains, 把有序单链 src 合并到有序单链 dst 中，相等时 dst 的在前
+	// 比较抛出异常时 dst 仍包含两条链的全部节点
+	template <class T, class Alloc>
+	template <class Compare>
+	void list<T, Alloc>::merge_chains(list_node_base *&dst, list_node_base *src, Compare &comp) {
+		list_node_base head;
+		auto tail = &head;
+		auto a = dst;
+		auto b = src;
+		try {
+			while (a != nullptr && b != nullptr) {
+				if (comp(value_of(b), value_of(a))) {
+					tail->next = b;
+					b = b->next;
+				} else {
+					tail->next = a;
+					a = a->next;
+				}
+				tail = tail->next;
+			}
+		} catch (...) {
+			tail->next = concat_chains(a, b);
+			dst = head.next;
+			throw;
+		}
+		tail->next = a != nullptr ? a : b;
+		dst = head.next;
+	}
+
+	// concat_chains, 把单链 second 接在单链 first 之后
+	template <class T, class Alloc>
+	list_node_base *list<T, Alloc>::concat_chains(list_node_base *first, list_node_base *second) noexcept {
+		if (first == nullptr) {
+			return second;
+		}
+		auto tail = first;
+		while (tail->next != nullptr) {
+			tail = tail->next;
+		}
+		tail->next = second;
+		return first;
+	}
+
+	// relink_chain, 按单链 chain 的顺序重建 prev 指针并接回哨兵，节点数不变
+	template <class T, class Alloc>
+	void list<T, Alloc>::relink_chain(list_node_base *chain) noexcept {
+		list_node_base *prev = &head_;
+		for (auto node = chain; node != nullptr; node = node->next) {
+			node->prev = prev;
+			prev->next = node;
+			prev = node;
+		}
+		prev->next = &head_;
+		head_.prev = prev;
+	}
+
+	/******************************************************************************************************/
+	// 重载比较操作符
+
+	template <class T, class Alloc>
+	bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+		return lhs.size() == rhs.size() && wstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class T, class Alloc>
+	bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+		return !(lhs == rhs);
+	}
+
+	template <class T, class Alloc>
+	bool operator<(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+		return wstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class T, class Alloc>
+	bool operator<=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+		return !(rhs < lhs);
+	}
+
+	template <class T, class Alloc>
+	bool operator>(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+		return rhs < lhs;
+	}
+
+	template <class T, class Alloc>
+	bool operator>=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+		return !(lhs < rhs);
+	}
+
+	// 重载 swap
+	template <class T, class Alloc>
+	void swap(list<T, Alloc> &lhs, list<T, Alloc> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_LIST_H
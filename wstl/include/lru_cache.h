@@ -0,0 +1,605 @@
+#ifndef WSTL_LRU_CACHE_H
+#define WSTL_LRU_CACHE_H
+
+/*
+	该文件实现定容缓存：lru_cache<Key, T> 与 clock_cache<Key, T>
+
+	容量：
+		构造时给出条目数上限 max_entries，以及可选的权重上限 max_weight。
+		每个条目的权重由 Weigher(key, value) 给出，默认每个条目为 1（即只按条目数限制）；
+		按字节限制时提供返回字节数的 Weigher，max_entries 只作为条目数的上限。
+		插入新条目前先淘汰，直到条目数与总权重都不超过上限；权重本身超过 max_weight 的条目不会被缓存。
+
+	存储：
+		全部条目放在构造时一次分配的连续数组（slab）中，由侵入式哈希集合（见 intrusive_hash_set.h）索引，
+		哈希桶也在构造时按 max_entries 预留，因此 get / put / 淘汰在稳定状态下都不分配内存。
+		条目的地址在它被淘汰或删除之前保持不变，get 返回的指针在下一次 put / erase / clear 之前有效。
+
+	lru_cache:
+		条目同时链在一条侵入式链表（见 intrusive_list.h）上，表头是最近使用的条目，
+		命中时把条目移到表头，淘汰表尾，严格按最近最少使用的顺序淘汰。
+
+	clock_cache:
+		CLOCK（second chance）近似 LRU：条目没有链表指针，只在一个与 slab 平行的字节数组中记录访问位，
+		命中时只设置访问位（已设置时不写），淘汰时指针在数组上循环扫描，访问位为 1 的清零后跳过，为 0 的淘汰。
+		命中路径比 lru_cache 少一次链表移动，条目也少两个指针，适合读多写少的场景。
+
+	两者都不是线程安全的。
+*/
+
+#include <cstdint>
+#include <functional>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "intrusive_hash_set.h"
+#include "intrusive_list.h"
+#include "util.h"
+#include "vector.h"
+
+namespace wstl {
+
+	// cache_unit_weigher, 每个条目的权重都是 1
+	struct cache_unit_weigher {
+		template <class K, class V>
+		size_t operator()(const K &, const V &) const noexcept {
+			return 1;
+		}
+	};
+
+	// cache_slab, 固定容量的条目数组：按下标顺序切出未用过的槽位，释放的槽位串成空闲链表
+	// 槽位中的对象由使用者构造与析构
+	template <class Entry, class Alloc>
+	class cache_slab {
+		struct free_slot {
+			free_slot *next;
+		};
+
+		static_assert(sizeof(Entry) >= sizeof(free_slot), "cache_slab : entry smaller than a pointer");
+
+		Entry *slots_;
+		size_t capacity_;
+		size_t used_; // 曾经切出过的槽位数
+		free_slot *free_;
+
+	public:
+		explicit cache_slab(size_t capacity)
+			: slots_(Alloc::allocate(capacity)), capacity_(capacity), used_(0), free_(nullptr) {}
+
+		cache_slab(const cache_slab &) = delete;
+		cache_slab &operator=(const cache_slab &) = delete;
+
+		~cache_slab() {
+			Alloc::deallocate(slots_, capacity_);
+		}
+
+		Entry *data() const noexcept {
+			return slots_;
+		}
+
+		size_t capacity() const noexcept {
+			return capacity_;
+		}
+
+		size_t used() const noexcept {
+			return used_;
+		}
+
+		// acquire, 返回一个空槽位，没有时返回空指针
+		Entry *acquire() noexcept {
+			if (free_ != nullptr) {
+				auto slot = free_;
+				free_ = slot->next;
+				return reinterpret_cast<Entry *>(slot);
+			}
+			return used_ < capacity_ ? slots_ + used_++ : nullptr;
+		}
+
+		// release, 槽位中的对象必须已经析构
+		void release(Entry *p) noexcept {
+			free_ = ::new (static_cast<void *>(p)) free_slot{free_};
+		}
+	};
+
+	/*****************************************************************************************/
+	// 									lru_cache
+	/*****************************************************************************************/
+
+	template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+			  class Weigher = cache_unit_weigher, class Alloc = wstl::allocator<T>>
+	class lru_cache {
+	public:
+		// lru_cache 的嵌套型别定义
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef Hash hasher;
+		typedef KeyEqual key_equal;
+		typedef Weigher weigher_type;
+		typedef size_t size_type;
+
+	private:
+		struct entry {
+			intrusive_hash_hook hash_hook;
+			intrusive_list_hook lru_hook;
+			size_type weight;
+			Key key;
+			T value;
+
+			template <class K, class V>
+			entry(K &&k, V &&v, size_type w) : weight(w), key(wstl::forward<K>(k)), value(wstl::forward<V>(v)) {}
+		};
+
+		// 索引同时接受条目与键
+		struct entry_hash {
+			Hash hash;
+
+			size_t operator()(const entry &e) const {
+				return hash(e.key);
+			}
+
+			size_t operator()(const Key &key) const {
+				return hash(key);
+			}
+		};
+
+		struct entry_equal {
+			KeyEqual equal;
+
+			bool operator()(const entry &lhs, const entry &rhs) const {
+				return equal(lhs.key, rhs.key);
+			}
+
+			bool operator()(const entry &lhs, const Key &key) const {
+				return equal(lhs.key, key);
+			}
+		};
+
+		typedef typename Alloc::template rebind<entry>::other entry_allocator;
+		typedef intrusive_hash_set<entry, &entry::hash_hook, entry_hash, entry_equal> index_type;
+		typedef intrusive_list<entry, &entry::lru_hook> recency_list;
+
+		cache_slab<entry, entry_allocator> slab_;
+		index_type index_;
+		recency_list lru_; // 表头是最近使用的条目
+		size_type weight_;
+		size_type max_weight_;
+		weigher_type weigher_;
+
+	public:
+		// 构造、析构函数，缓存不能复制或移动
+
+		explicit lru_cache(size_type max_entries, size_type max_weight = static_cast<size_type>(-1),
+						   const hasher &hash = hasher(), const key_equal &equal = key_equal(),
+						   const weigher_type &weigher = weigher_type())
+			: slab_(max_entries), index_(max_entries, entry_hash{hash}, entry_equal{equal}), weight_(0),
+			  max_weight_(max_weight), weigher_(weigher) {}
+
+		lru_cache(const lru_cache &) = delete;
+		lru_cache &operator=(const lru_cache &) = delete;
+
+		~lru_cache() {
+			clear();
+		}
+
+	public:
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return index_.empty();
+		}
+
+		size_type size() const noexcept {
+			return index_.size();
+		}
+
+		size_type max_entries() const noexcept {
+			return slab_.capacity();
+		}
+
+		size_type weight() const noexcept {
+			return weight_;
+		}
+
+		size_type max_weight() const noexcept {
+			return max_weight_;
+		}
+
+		// 查找
+
+		// get, 命中时把条目移到表头并返回值的地址，未命中时返回空指针
+		T *get(const Key &key) {
+			auto it = index_.find(key);
+			if (it == index_.end()) {
+				return nullptr;
+			}
+			touch(*it);
+			return &it->value;
+		}
+
+		// peek, 与 get 相同但不改变淘汰顺序
+		const T *peek(const Key &key) const {
+			auto it = index_.find(key);
+			return it == index_.end() ? nullptr : &it->value;
+		}
+
+		bool contains(const Key &key) const {
+			return index_.contains(key);
+		}
+
+		// 修改缓存相关操作
+
+		// put, 插入或覆盖，必要时淘汰最久未使用的条目，返回缓存中值的地址
+		// 条目的权重超过 max_weight 时不缓存（已有的同键条目被删除），返回空指针
+		template <class K, class V>
+		T *put(K &&key, V &&value);
+
+		// erase, 键不存在时返回 false
+		bool erase(const Key &key);
+
+		void clear() noexcept;
+
+		// for_each, 从最近使用到最久未使用依次调用 f(key, value)
+		template <class Function>
+		void for_each(Function f) const {
+			for (auto it = lru_.begin(); it != lru_.end(); ++it) {
+				f(it->key, it->value);
+			}
+		}
+
+	private:
+		// helper functions
+
+		void touch(entry &e) noexcept {
+			lru_.splice(lru_.begin(), lru_, lru_.iterator_to(e));
+		}
+
+		void erase_entry(entry &e) noexcept;
+
+		void evict_back() noexcept {
+			erase_entry(lru_.back());
+		}
+	};
+
+	/*****************************************************************************************/
+
+	// put
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	template <class K, class V>
+	T *lru_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::put(K &&key, V &&value) {
+		const size_type w = weigher_(key, value);
+		auto it = index_.find(key);
+		if (it != index_.end()) {
+			auto &e = *it;
+			if (w > max_weight_) {
+				erase_entry(e);
+				return nullptr;
+			}
+			e.value = wstl::forward<V>(value);
+			weight_ = weight_ - e.weight + w;
+			e.weight = w;
+			touch(e);
+			// e 在表头，不会被淘汰
+			while (weight_ > max_weight_) {
+				evict_back();
+			}
+			return &e.value;
+		}
+		if (w > max_weight_ || slab_.capacity() == 0) {
+			return nullptr;
+		}
+		while (size() == slab_.capacity() || w > max_weight_ - weight_) {
+			evict_back();
+		}
+		auto p = slab_.acquire();
+		try {
+			::new (static_cast<void *>(p)) entry(wstl::forward<K>(key), wstl::forward<V>(value), w);
+		} catch (...) {
+			slab_.release(p);
+			throw;
+		}
+		index_.insert(*p);
+		lru_.push_front(*p);
+		weight_ += w;
+		return &p->value;
+	}
+
+	// erase
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	bool lru_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::erase(const Key &key) {
+		auto it = index_.find(key);
+		if (it == index_.end()) {
+			return false;
+		}
+		erase_entry(*it);
+		return true;
+	}
+
+	// clear
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	void lru_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::clear() noexcept {
+		while (!lru_.empty()) {
+			evict_back();
+		}
+	}
+
+	// helper function
+
+	// erase_entry, 从索引与链表中摘下，析构并归还槽位
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	void lru_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::erase_entry(entry &e) noexcept {
+		index_.remove(e);
+		lru_.remove(e);
+		weight_ -= e.weight;
+		wstl::destroy(&e);
+		slab_.release(&e);
+	}
+
+	/*****************************************************************************************/
+	// 									clock_cache
+	/*****************************************************************************************/
+
+	template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+			  class Weigher = cache_unit_weigher, class Alloc = wstl::allocator<T>>
+	class clock_cache {
+	public:
+		// clock_cache 的嵌套型别定义
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef Hash hasher;
+		typedef KeyEqual key_equal;
+		typedef Weigher weigher_type;
+		typedef size_t size_type;
+
+	private:
+		struct entry {
+			intrusive_hash_hook hash_hook;
+			size_type weight;
+			Key key;
+			T value;
+
+			template <class K, class V>
+			entry(K &&k, V &&v, size_type w) : weight(w), key(wstl::forward<K>(k)), value(wstl::forward<V>(v)) {}
+		};
+
+		struct entry_hash {
+			Hash hash;
+
+			size_t operator()(const entry &e) const {
+				return hash(e.key);
+			}
+
+			size_t operator()(const Key &key) const {
+				return hash(key);
+			}
+		};
+
+		struct entry_equal {
+			KeyEqual equal;
+
+			bool operator()(const entry &lhs, const entry &rhs) const {
+				return equal(lhs.key, rhs.key);
+			}
+
+			bool operator()(const entry &lhs, const Key &key) const {
+				return equal(lhs.key, key);
+			}
+		};
+
+		// 槽位状态
+		enum : uint8_t { slot_empty = 0, slot_resident = 1, slot_referenced = 2 };
+
+		typedef typename Alloc::template rebind<entry>::other entry_allocator;
+		typedef intrusive_hash_set<entry, &entry::hash_hook, entry_hash, entry_equal> index_type;
+
+		cache_slab<entry, entry_allocator> slab_;
+		index_type index_;
+		vector<uint8_t> state_; // 与 slab_ 平行的槽位状态
+		size_type hand_;		// 时钟指针，指向下一个检查的槽位
+		size_type weight_;
+		size_type max_weight_;
+		weigher_type weigher_;
+
+	public:
+		// 构造、析构函数，缓存不能复制或移动
+
+		explicit clock_cache(size_type max_entries, size_type max_weight = static_cast<size_type>(-1),
+							 const hasher &hash = hasher(), const key_equal &equal = key_equal(),
+							 const weigher_type &weigher = weigher_type())
+			: slab_(max_entries), index_(max_entries, entry_hash{hash}, entry_equal{equal}), state_(max_entries, slot_empty),
+			  hand_(0), weight_(0), max_weight_(max_weight), weigher_(weigher) {}
+
+		clock_cache(const clock_cache &) = delete;
+		clock_cache &operator=(const clock_cache &) = delete;
+
+		~clock_cache() {
+			clear();
+		}
+
+	public:
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return index_.empty();
+		}
+
+		size_type size() const noexcept {
+			return index_.size();
+		}
+
+		size_type max_entries() const noexcept {
+			return slab_.capacity();
+		}
+
+		size_type weight() const noexcept {
+			return weight_;
+		}
+
+		size_type max_weight() const noexcept {
+			return max_weight_;
+		}
+
+		// 查找
+
+		// get, 命中时设置访问位并返回值的地址，未命中时返回空指针
+		T *get(const Key &key) {
+			auto it = index_.find(key);
+			if (it == index_.end()) {
+				return nullptr;
+			}
+			auto &state = state_[slot_of(*it)];
+			if (state != slot_referenced) {
+				state = slot_referenced;
+			}
+			return &it->value;
+		}
+
+		// peek, 与 get 相同但不设置访问位
+		const T *peek(const Key &key) const {
+			auto it = index_.find(key);
+			return it == index_.end() ? nullptr : &it->value;
+		}
+
+		bool contains(const Key &key) const {
+			return index_.contains(key);
+		}
+
+		// 修改缓存相关操作
+
+		// put, 插入或覆盖，必要时按 CLOCK 顺序淘汰，返回缓存中值的地址
+		// 条目的权重超过 max_weight 时不缓存（已有的同键条目被删除），返回空指针
+		template <class K, class V>
+		T *put(K &&key, V &&value);
+
+		bool erase(const Key &key);
+
+		void clear() noexcept;
+
+		// for_each, 按槽位顺序调用 f(key, value)
+		template <class Function>
+		void for_each(Function f) const {
+			for (size_type i = 0; i < slab_.used(); ++i) {
+				if (state_[i] != slot_empty) {
+					const auto &e = slab_.data()[i];
+					f(e.key, e.value);
+				}
+			}
+		}
+
+	private:
+		// helper functions
+
+		size_type slot_of(const entry &e) const noexcept {
+			return static_cast<size_type>(&e - slab_.data());
+		}
+
+		void erase_slot(size_type i) noexcept;
+
+		void evict_one() noexcept;
+	};
+
+	/*****************************************************************************************/
+
+	// put
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	template <class K, class V>
+	T *clock_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::put(K &&key, V &&value) {
+		const size_type w = weigher_(key, value);
+		auto it = index_.find(key);
+		if (it != index_.end()) {
+			auto &e = *it;
+			const auto slot = slot_of(e);
+			if (w > max_weight_) {
+				erase_slot(slot);
+				return nullptr;
+			}
+			e.value = wstl::forward<V>(value);
+			weight_ = weight_ - e.weight + w;
+			e.weight = w;
+			// 淘汰时跳过自己：暂时标记为空槽位，只剩它一个条目时权重一定不超过上限
+			state_[slot] = slot_empty;
+			while (weight_ > max_weight_) {
+				evict_one();
+			}
+			state_[slot] = slot_referenced;
+			return &e.value;
+		}
+		if (w > max_weight_ || slab_.capacity() == 0) {
+			return nullptr;
+		}
+		while (size() == slab_.capacity() || w > max_weight_ - weight_) {
+			evict_one();
+		}
+		auto p = slab_.acquire();
+		try {
+			::new (static_cast<void *>(p)) entry(wstl::forward<K>(key), wstl::forward<V>(value), w);
+		} catch (...) {
+			slab_.release(p);
+			throw;
+		}
+		index_.insert(*p);
+		state_[slot_of(*p)] = slot_resident;
+		weight_ += w;
+		return &p->value;
+	}
+
+	// erase
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	bool clock_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::erase(const Key &key) {
+		auto it = index_.find(key);
+		if (it == index_.end()) {
+			return false;
+		}
+		erase_slot(slot_of(*it));
+		return true;
+	}
+
+	// clear
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	void clock_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::clear() noexcept {
+		for (size_type i = 0; i < slab_.used(); ++i) {
+			if (state_[i] != slot_empty) {
+				erase_slot(i);
+			}
+		}
+		hand_ = 0;
+	}
+
+	// helper function
+
+	// erase_slot, 从索引中摘下，析构并归还槽位
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	void clock_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::erase_slot(size_type i) noexcept {
+		auto &e = slab_.data()[i];
+		index_.remove(e);
+		weight_ -= e.weight;
+		state_[i] = slot_empty;
+		wstl::destroy(&e);
+		slab_.release(&e);
+	}
+
+	// evict_one, 淘汰一个条目，调用时缓存不能为空
+	// 访问位为 1 的条目清零后跳过，因此最多扫描两圈
+	template <class Key, class T, class Hash, class KeyEqual, class Weigher, class Alloc>
+	void clock_cache<Key, T, Hash, KeyEqual, Weigher, Alloc>::evict_one() noexcept {
+		WSTL_DEBUG(!empty());
+		const auto used = slab_.used();
+		for (;;) {
+			if (hand_ >= used) {
+				hand_ = 0;
+			}
+			const auto i = hand_++;
+			auto &state = state_[i];
+			if (state == slot_referenced) {
+				state = slot_resident;
+			} else if (state == slot_resident) {
+				erase_slot(i);
+				return;
+			}
+		}
+	}
+
+} // namespace wstl
+
+#endif // WSTL_LRU_CACHE_H
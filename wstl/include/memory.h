@@ -3,14 +3,48 @@
 
 // 这个头文件负责更高级的动态内存管理， 包括基本函数，空间配置器，未初始化的储存空间管理，以及各种智能指针
 
+/*
+	智能指针：
+
+	unique_ptr<T, Deleter> / unique_ptr<T[], Deleter>
+		独占所有权。删除器为空类（默认的 default_delete 即是）时作为基类存放，不占空间，unique_ptr 只有一个指针大小。
+		unique_ptr 不保存指向自身的指针，移动就是复制指针再把源置空，移动构造与移动赋值都是 noexcept，
+		vector<unique_ptr<T>> 扩容时走移动路径，不会拷贝也不会回退。
+
+	shared_ptr<T> / weak_ptr<T>
+		共享所有权，计数保存在控制块中，计数的增减是原子操作，同一对象的不同 shared_ptr 可以在不同线程中拷贝与析构。
+		make_shared / allocate_shared 把控制块与对象放在同一次分配中：少一次分配，计数紧挨着对象，
+		代价是只要还有 weak_ptr，这块内存就不会释放（对象本身在最后一个 shared_ptr 析构时就已析构）。
+		由指针构造的 shared_ptr 另外分配一个保存指针与删除器的控制块。
+
+	local_shared_ptr<T> / local_weak_ptr<T>
+		接口与 shared_ptr / weak_ptr 相同，但计数是普通整数，拷贝与析构不需要原子的读-改-写，
+		同一对象的所有 local_shared_ptr / local_weak_ptr 只能在一个线程中使用。
+		由 make_local_shared / allocate_local_shared 创建，与 shared_ptr 的控制块不同，两者不能相互转换。
+
+	临时缓冲区：
+
+	get_temporary_buffer<T>(len) / return_temporary_buffer(p) / temporary_buffer<T>
+		为 stable_sort、inplace_merge 一类算法提供未初始化的临时空间，返回的长度可能小于请求的长度（内存不足时逐次减半）。
+		每个线程保留一块可重复使用的缓冲区（temporary_arena），请求不超过 temporary_arena_max_bytes 时优先使用它，
+		循环中反复申请时只在请求变大时重新分配；这块缓冲区同时只能借出一次，已经借出时（嵌套使用）以及请求更大时
+		直接向 operator new 申请。线程结束时释放。
+*/
+
+#include <atomic>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <new>
+#include <type_traits>
 
 #include "algobase.h"
 #include "allocator.h"
 #include "construct.h"
+#include "exceptdef.h"
 #include "uninitialized.h"
+#include "util.h"
 
 namespace wstl {
 
@@ -20,7 +54,1069 @@ namespace wstl {
 		return &value;
 	}
 
+	/*****************************************************************************************/
 	// 获取 / 释放临时缓冲区
-}
+	/*****************************************************************************************/
+
+	// 超过这个大小的请求不使用 temporary_arena，arena 也不会扩大到超过它
+	constexpr size_t temporary_arena_max_bytes = 1 << 20;
+
+	// temporary_arena, 每个线程一块可重复使用的临时缓冲区
+	class temporary_arena {
+	public:
+		// 缓冲区空闲且能容纳（或扩大到能容纳）bytes 时借出，否则返回 nullptr
+		static void *acquire(size_t bytes) noexcept;
+
+		// ptr 是借出的缓冲区时归还并返回 true
+		static bool release(void *ptr) noexcept;
+
+		// 当前线程缓冲区的大小
+		static size_t capacity() noexcept;
+
+	private:
+		struct local_state {
+			void *data;
+			size_t capacity;
+			bool in_use;
+
+			~local_state() {
+				::operator delete(data);
+			}
+		};
+
+		static local_state &local() noexcept {
+			static thread_local local_state state{nullptr, 0, false};
+			return state;
+		}
+	};
+
+	// acquire, 不够大时按两倍扩大（不超过 temporary_arena_max_bytes），先释放旧的缓冲区以免两块同时存在
+	inline void *temporary_arena::acquire(size_t bytes) noexcept {
+		auto &s = local();
+		if (s.in_use || bytes > temporary_arena_max_bytes) {
+			return nullptr;
+		}
+		if (bytes > s.capacity) {
+			size_t capacity = s.capacity * 2 > bytes ? s.capacity * 2 : bytes;
+			if (capacity > temporary_arena_max_bytes) {
+				capacity = temporary_arena_max_bytes;
+			}
+			::operator delete(s.data);
+			s.capacity = 0;
+			s.data = ::operator new(capacity, std::nothrow);
+			if (s.data == nullptr) {
+				return nullptr;
+			}
+			s.capacity = capacity;
+		}
+		s.in_use = true;
+		return s.data;
+	}
+
+	inline bool temporary_arena::release(void *ptr) noexcept {
+		auto &s = local();
+		if (!s.in_use || ptr != s.data) {
+			return false;
+		}
+		s.in_use = false;
+		return true;
+	}
+
+	inline size_t temporary_arena::capacity() noexcept {
+		return local().capacity;
+	}
+
+	// get_temporary_buffer, 获取最多 len 个 T 的未初始化空间，返回空间的起始地址与实际长度，失败时返回 {nullptr, 0}
+	template <class T>
+	pair<T *, ptrdiff_t> get_temporary_buffer(ptrdiff_t len) noexcept {
+		static_assert(alignof(T) <= alignof(std::max_align_t), "get_temporary_buffer : over-aligned types are not supported");
+		const ptrdiff_t max_len = PTRDIFF_MAX / static_cast<ptrdiff_t>(sizeof(T));
+		if (len > max_len) {
+			len = max_len;
+		}
+		if (len <= 0) {
+			return pair<T *, ptrdiff_t>(nullptr, 0);
+		}
+		void *arena = temporary_arena::acquire(static_cast<size_t>(len) * sizeof(T));
+		if (arena != nullptr) {
+			return pair<T *, ptrdiff_t>(static_cast<T *>(arena), len);
+		}
+		while (len > 0) {
+			void *ptr = ::operator new(static_cast<size_t>(len) * sizeof(T), std::nothrow);
+			if (ptr != nullptr) {
+				return pair<T *, ptrdiff_t>(static_cast<T *>(ptr), len);
+			}
+			len /= 2;
+		}
+		return pair<T *, ptrdiff_t>(nullptr, 0);
+	}
+
+	// return_temporary_buffer, 归还 get_temporary_buffer 获取的空间，空间中的对象须已析构
+	template <class T>
+	void return_temporary_buffer(T *ptr) noexcept {
+		if (ptr != nullptr && !temporary_arena::release(ptr)) {
+			::operator delete(ptr);
+		}
+	}
+
+	// 模版类 temporary_buffer，在作用域内持有 get_temporary_buffer 获取的未初始化空间
+	// 元素由使用者构造，并须在 temporary_buffer 析构前析构
+	template <class T>
+	class temporary_buffer {
+		T *buffer_;
+		ptrdiff_t len_;
+		ptrdiff_t requested_len_;
+
+	public:
+		explicit temporary_buffer(ptrdiff_t requested_len) : buffer_(nullptr), len_(0), requested_len_(requested_len) {
+			auto result = wstl::get_temporary_buffer<T>(requested_len);
+			buffer_ = result.first;
+			len_ = result.second;
+		}
+
+		temporary_buffer(const temporary_buffer &) = delete;
+		temporary_buffer &operator=(const temporary_buffer &) = delete;
+
+		~temporary_buffer() {
+			wstl::return_temporary_buffer(buffer_);
+		}
+
+		T *begin() const noexcept {
+			return buffer_;
+		}
+
+		T *end() const noexcept {
+			return buffer_ + len_;
+		}
+
+		T *data() const noexcept {
+			return buffer_;
+		}
+
+		// 实际得到的长度，可能小于 requested_size()
+		ptrdiff_t size() const noexcept {
+			return len_;
+		}
+
+		ptrdiff_t requested_size() const noexcept {
+			return requested_len_;
+		}
+	};
+
+	/*****************************************************************************************/
+	// unique_ptr
+	/*****************************************************************************************/
+
+	// default_delete, unique_ptr 的默认删除器
+	template <class T>
+	struct default_delete {
+		constexpr default_delete() noexcept = default;
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		default_delete(const default_delete<U> &) noexcept {}
+
+		void operator()(T *ptr) const {
+			static_assert(sizeof(T) > 0, "default_delete : can't delete an incomplete type");
+			delete ptr;
+		}
+	};
+
+	template <class T>
+	struct default_delete<T[]> {
+		constexpr default_delete() noexcept = default;
+
+		void operator()(T *ptr) const {
+			static_assert(sizeof(T) > 0, "default_delete : can't delete an incomplete type");
+			delete[] ptr;
+		}
+	};
+
+	// unique_ptr_storage, 保存指针与删除器，删除器是空类时作为私有基类存放（空基类优化）
+	template <class T, class Deleter, bool = std::is_empty<Deleter>::value>
+	class unique_ptr_storage : private Deleter {
+		T *ptr_;
+
+	public:
+		unique_ptr_storage() noexcept : Deleter(), ptr_(nullptr) {}
+
+		template <class D>
+		unique_ptr_storage(T *ptr, D &&deleter) noexcept : Deleter(wstl::forward<D>(deleter)), ptr_(ptr) {}
+
+		T *&ptr() noexcept {
+			return ptr_;
+		}
+
+		T *ptr() const noexcept {
+			return ptr_;
+		}
+
+		Deleter &deleter() noexcept {
+			return *this;
+		}
+
+		const Deleter &deleter() const noexcept {
+			return *this;
+		}
+	};
+
+	template <class T, class Deleter>
+	class unique_ptr_storage<T, Deleter, false> {
+		T *ptr_;
+		Deleter deleter_;
+
+	public:
+		unique_ptr_storage() noexcept : ptr_(nullptr), deleter_() {}
+
+		template <class D>
+		unique_ptr_storage(T *ptr, D &&deleter) noexcept : ptr_(ptr), deleter_(wstl::forward<D>(deleter)) {}
+
+		T *&ptr() noexcept {
+			return ptr_;
+		}
+
+		T *ptr() const noexcept {
+			return ptr_;
+		}
+
+		Deleter &deleter() noexcept {
+			return deleter_;
+		}
+
+		const Deleter &deleter() const noexcept {
+			return deleter_;
+		}
+	};
+
+	// 模版类 unique_ptr
+	template <class T, class Deleter = default_delete<T>>
+	class unique_ptr {
+		static_assert(!std::is_reference<Deleter>::value, "unique_ptr : reference deleters are not supported in wstl");
+
+	public:
+		typedef T *pointer;
+		typedef T element_type;
+		typedef Deleter deleter_type;
+
+	private:
+		template <class U, class E>
+		friend class unique_ptr;
+
+		unique_ptr_storage<T, Deleter> storage_;
+
+	public:
+		// 构造、复制、移动、析构函数
+		unique_ptr() noexcept : storage_() {}
+
+		unique_ptr(std::nullptr_t) noexcept : storage_() {}
+
+		explicit unique_ptr(pointer ptr) noexcept : storage_(ptr, Deleter()) {}
+
+		unique_ptr(pointer ptr, const Deleter &deleter) noexcept : storage_(ptr, deleter) {}
+
+		unique_ptr(pointer ptr, Deleter &&deleter) noexcept : storage_(ptr, wstl::move(deleter)) {}
+
+		unique_ptr(unique_ptr &&rhs) noexcept : storage_(rhs.release(), wstl::move(rhs.get_deleter())) {}
+
+		template <class U, class E,
+				  typename std::enable_if<!std::is_array<U>::value && std::is_convertible<U *, T *>::value &&
+											  std::is_convertible<E, Deleter>::value,
+										  int>::type = 0>
+		unique_ptr(unique_ptr<U, E> &&rhs) noexcept : storage_(rhs.release(), wstl::forward<E>(rhs.get_deleter())) {}
+
+		unique_ptr(const unique_ptr &) = delete;
+		unique_ptr &operator=(const unique_ptr &) = delete;
+
+		unique_ptr &operator=(unique_ptr &&rhs) noexcept {
+			reset(rhs.release());
+			get_deleter() = wstl::move(rhs.get_deleter());
+			return *this;
+		}
+
+		template <class U, class E,
+				  typename std::enable_if<!std::is_array<U>::value && std::is_convertible<U *, T *>::value &&
+											  std::is_assignable<Deleter &, E &&>::value,
+										  int>::type = 0>
+		unique_ptr &operator=(unique_ptr<U, E> &&rhs) noexcept {
+			reset(rhs.release());
+			get_deleter() = wstl::forward<E>(rhs.get_deleter());
+			return *this;
+		}
+
+		unique_ptr &operator=(std::nullptr_t) noexcept {
+			reset();
+			return *this;
+		}
+
+		~unique_ptr() {
+			if (storage_.ptr() != nullptr) {
+				get_deleter()(storage_.ptr());
+			}
+		}
+
+	public:
+		// 观察器
+		typename std::add_lvalue_reference<T>::type operator*() const {
+			return *storage_.ptr();
+		}
+
+		pointer operator->() const noexcept {
+			return storage_.ptr();
+		}
+
+		pointer get() const noexcept {
+			return storage_.ptr();
+		}
+
+		Deleter &get_deleter() noexcept {
+			return storage_.deleter();
+		}
+
+		const Deleter &get_deleter() const noexcept {
+			return storage_.deleter();
+		}
+
+		explicit operator bool() const noexcept {
+			return storage_.ptr() != nullptr;
+		}
+
+		// 修改器
+		pointer release() noexcept {
+			pointer ptr = storage_.ptr();
+			storage_.ptr() = nullptr;
+			return ptr;
+		}
+
+		void reset(pointer ptr = pointer()) noexcept {
+			pointer old = storage_.ptr();
+			storage_.ptr() = ptr;
+			if (old != nullptr) {
+				get_deleter()(old);
+			}
+		}
+
+		void swap(unique_ptr &rhs) noexcept {
+			wstl::swap(storage_.ptr(), rhs.storage_.ptr());
+			wstl::swap(get_deleter(), rhs.get_deleter());
+		}
+	};
+
+	// unique_ptr 管理数组的偏特化，不支持派生类指针的转换
+	template <class T, class Deleter>
+	class unique_ptr<T[], Deleter> {
+		static_assert(!std::is_reference<Deleter>::value, "unique_ptr : reference deleters are not supported in wstl");
+
+	public:
+		typedef T *pointer;
+		typedef T element_type;
+		typedef Deleter deleter_type;
+
+	private:
+		unique_ptr_storage<T, Deleter> storage_;
+
+	public:
+		// 构造、复制、移动、析构函数
+		unique_ptr() noexcept : storage_() {}
+
+		unique_ptr(std::nullptr_t) noexcept : storage_() {}
+
+		explicit unique_ptr(pointer ptr) noexcept : storage_(ptr, Deleter()) {}
+
+		unique_ptr(pointer ptr, const Deleter &deleter) noexcept : storage_(ptr, deleter) {}
+
+		unique_ptr(pointer ptr, Deleter &&deleter) noexcept : storage_(ptr, wstl::move(deleter)) {}
+
+		unique_ptr(unique_ptr &&rhs) noexcept : storage_(rhs.release(), wstl::move(rhs.get_deleter())) {}
+
+		unique_ptr(const unique_ptr &) = delete;
+		unique_ptr &operator=(const unique_ptr &) = delete;
+
+		unique_ptr &operator=(unique_ptr &&rhs) noexcept {
+			reset(rhs.release());
+			get_deleter() = wstl::move(rhs.get_deleter());
+			return *this;
+		}
+
+		unique_ptr &operator=(std::nullptr_t) noexcept {
+			reset();
+			return *this;
+		}
+
+		~unique_ptr() {
+			if (storage_.ptr() != nullptr) {
+				get_deleter()(storage_.ptr());
+			}
+		}
+
+	public:
+		// 观察器
+		T &operator[](size_t n) const {
+			return storage_.ptr()[n];
+		}
+
+		pointer get() const noexcept {
+			return storage_.ptr();
+		}
+
+		Deleter &get_deleter() noexcept {
+			return storage_.deleter();
+		}
+
+		const Deleter &get_deleter() const noexcept {
+			return storage_.deleter();
+		}
+
+		explicit operator bool() const noexcept {
+			return storage_.ptr() != nullptr;
+		}
+
+		// 修改器
+		pointer release() noexcept {
+			pointer ptr = storage_.ptr();
+			storage_.ptr() = nullptr;
+			return ptr;
+		}
+
+		void reset(pointer ptr = pointer()) noexcept {
+			pointer old = storage_.ptr();
+			storage_.ptr() = ptr;
+			if (old != nullptr) {
+				get_deleter()(old);
+			}
+		}
+
+		void swap(unique_ptr &rhs) noexcept {
+			wstl::swap(storage_.ptr(), rhs.storage_.ptr());
+			wstl::swap(get_deleter(), rhs.get_deleter());
+		}
+	};
+
+	static_assert(sizeof(unique_ptr<int>) == sizeof(int *), "unique_ptr : default deleter must not take space");
+	static_assert(sizeof(unique_ptr<int[]>) == sizeof(int *), "unique_ptr : default deleter must not take space");
+
+	// make_unique, 构造对象并交给 unique_ptr 管理
+
+	template <class T, class... Args>
+	typename std::enable_if<!std::is_array<T>::value, unique_ptr<T>>::type make_unique(Args &&...args) {
+		return unique_ptr<T>(new T(wstl::forward<Args>(args)...));
+	}
+
+	// 数组元素值初始化
+	template <class T>
+	typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, unique_ptr<T>>::type
+	make_unique(size_t n) {
+		return unique_ptr<T>(new typename std::remove_extent<T>::type[n]());
+	}
+
+	// 重载比较操作符
+
+	template <class T1, class D1, class T2, class D2>
+	bool operator==(const unique_ptr<T1, D1> &lhs, const unique_ptr<T2, D2> &rhs) noexcept {
+		return lhs.get() == rhs.get();
+	}
+
+	template <class T1, class D1, class T2, class D2>
+	bool operator!=(const unique_ptr<T1, D1> &lhs, const unique_ptr<T2, D2> &rhs) noexcept {
+		return lhs.get() != rhs.get();
+	}
+
+	template <class T1, class D1, class T2, class D2>
+	bool operator<(const unique_ptr<T1, D1> &lhs, const unique_ptr<T2, D2> &rhs) noexcept {
+		return lhs.get() < rhs.get();
+	}
+
+	template <class T, class D>
+	bool operator==(const unique_ptr<T, D> &lhs, std::nullptr_t) noexcept {
+		return !lhs;
+	}
+
+	template <class T, class D>
+	bool operator==(std::nullptr_t, const unique_ptr<T, D> &rhs) noexcept {
+		return !rhs;
+	}
+
+	template <class T, class D>
+	bool operator!=(const unique_ptr<T, D> &lhs, std::nullptr_t) noexcept {
+		return static_cast<bool>(lhs);
+	}
+
+	template <class T, class D>
+	bool operator!=(std::nullptr_t, const unique_ptr<T, D> &rhs) noexcept {
+		return static_cast<bool>(rhs);
+	}
+
+	// 重载 wstl 的 swap
+	template <class T, class D>
+	void swap(unique_ptr<T, D> &lhs, unique_ptr<T, D> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+	/*****************************************************************************************/
+	// shared_ptr / weak_ptr
+	/*****************************************************************************************/
+
+	// 引用计数策略：shared_atomic_count 用于 shared_ptr，shared_local_count 用于 local_shared_ptr
+
+	struct shared_atomic_count {
+		typedef std::atomic<int> count_type;
+
+		static void increment(count_type &count) noexcept {
+			count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// 返回减一后的值。acq_rel：计数降为 0 的线程析构对象之前，能看到其他所有者在释放前对对象的写入
+		static int decrement(count_type &count) noexcept {
+			return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		}
+
+		// 计数不为 0 时加一，用于 weak_ptr::lock
+		static bool increment_if_nonzero(count_type &count) noexcept {
+			int n = count.load(std::memory_order_relaxed);
+			while (n != 0) {
+				if (count.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static int load(const count_type &count) noexcept {
+			return count.load(std::memory_order_acquire);
+		}
+	};
+
+	struct shared_local_count {
+		typedef int count_type;
+
+		static void increment(count_type &count) noexcept {
+			++count;
+		}
+
+		static int decrement(count_type &count) noexcept {
+			return --count;
+		}
+
+		static bool increment_if_nonzero(count_type &count) noexcept {
+			if (count == 0) {
+				return false;
+			}
+			++count;
+			return true;
+		}
+
+		static int load(const count_type &count) noexcept {
+			return count;
+		}
+	};
+
+	// shared_control_block, 控制块基类
+	// use_ 是 shared_ptr 的数量，weak_ 是 weak_ptr 的数量加一（全部 shared_ptr 共同持有一个弱引用），
+	// use_ 降为 0 时析构对象，weak_ 降为 0 时释放控制块
+	template <class Count>
+	class shared_control_block {
+		typename Count::count_type use_;
+		typename Count::count_type weak_;
+
+	public:
+		shared_control_block() noexcept : use_(1), weak_(1) {}
+
+		shared_control_block(const shared_control_block &) = delete;
+		shared_control_block &operator=(const shared_control_block &) = delete;
+
+		void add_ref() noexcept {
+			Count::increment(use_);
+		}
+
+		bool add_ref_if_alive() noexcept {
+			return Count::increment_if_nonzero(use_);
+		}
+
+		void release() noexcept {
+			if (Count::decrement(use_) == 0) {
+				dispose();
+				// 弱引用只剩 shared_ptr 共同持有的一个时，不会再有别人访问控制块，省去一次读-改-写
+				if (Count::load(weak_) == 1) {
+					destroy();
+				} else {
+					release_weak();
+				}
+			}
+		}
+
+		void add_weak() noexcept {
+			Count::increment(weak_);
+		}
+
+		void release_weak() noexcept {
+			if (Count::decrement(weak_) == 0) {
+				destroy();
+			}
+		}
+
+		long use_count() const noexcept {
+			return Count::load(use_);
+		}
+
+	protected:
+		virtual ~shared_control_block() = default;
+
+	private:
+		virtual void dispose() noexcept = 0; // 析构对象
+		virtual void destroy() noexcept = 0; // 释放控制块
+	};
+
+	// shared_pointer_block, 由指针构造 shared_ptr 时使用的控制块，保存指针与删除器
+	template <class T, class Deleter, class Count>
+	class shared_pointer_block : public shared_control_block<Count> {
+		T *ptr_;
+		Deleter deleter_;
+
+	public:
+		shared_pointer_block(T *ptr, Deleter deleter) : ptr_(ptr), deleter_(wstl::move(deleter)) {}
+
+	private:
+		void dispose() noexcept override {
+			deleter_(ptr_);
+		}
+
+		void destroy() noexcept override {
+			delete this;
+		}
+	};
+
+	// shared_inplace_block, make_shared / allocate_shared 使用的控制块，对象就存放在计数之后
+	// 控制块通过 Alloc 重绑定后的分配器分配
+	template <class T, class Alloc, class Count>
+	class shared_inplace_block : public shared_control_block<Count> {
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+
+	public:
+		typedef typename Alloc::template rebind<shared_inplace_block>::other block_allocator;
+
+		template <class... Args>
+		explicit shared_inplace_block(Args &&...args) {
+			::new (static_cast<void *>(&storage_)) T(wstl::forward<Args>(args)...);
+		}
+
+		T *value() noexcept {
+			return reinterpret_cast<T *>(&storage_);
+		}
+
+	private:
+		void dispose() noexcept override {
+			wstl::destroy(value());
+		}
+
+		void destroy() noexcept override {
+			this->~shared_inplace_block();
+			block_allocator::deallocate(this, 1);
+		}
+	};
+
+	template <class T, class Count>
+	class basic_weak_ptr;
+
+	// 模版类 basic_shared_ptr，shared_ptr 与 local_shared_ptr 的共同实现，Count 为引用计数策略
+	template <class T, class Count>
+	class basic_shared_ptr {
+	public:
+		typedef T element_type;
+		typedef basic_weak_ptr<T, Count> weak_type;
+
+	private:
+		typedef shared_control_block<Count> block_type;
+
+		template <class U, class C>
+		friend class basic_shared_ptr;
+		template <class U, class C>
+		friend class basic_weak_ptr;
+		friend struct shared_ptr_access;
+
+		T *ptr_;
+		block_type *block_;
+
+		// 接管 block 上已经计入的一个引用
+		basic_shared_ptr(T *ptr, block_type *block) noexcept : ptr_(ptr), block_(block) {}
+
+	public:
+		// 构造、复制、移动、析构函数
+		basic_shared_ptr() noexcept : ptr_(nullptr), block_(nullptr) {}
+
+		basic_shared_ptr(std::nullptr_t) noexcept : ptr_(nullptr), block_(nullptr) {}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		explicit basic_shared_ptr(U *ptr) : basic_shared_ptr(ptr, default_delete<U>()) {}
+
+		// 分配控制块失败时用 deleter 释放 ptr
+		template <class U, class Deleter, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr(U *ptr, Deleter deleter) : ptr_(ptr), block_(nullptr) {
+			try {
+				block_ = new shared_pointer_block<U, Deleter, Count>(ptr, deleter);
+			} catch (...) {
+				deleter(ptr);
+				throw;
+			}
+		}
+
+		basic_shared_ptr(const basic_shared_ptr &rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			if (block_ != nullptr) {
+				block_->add_ref();
+			}
+		}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr(const basic_shared_ptr<U, Count> &rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			if (block_ != nullptr) {
+				block_->add_ref();
+			}
+		}
+
+		basic_shared_ptr(basic_shared_ptr &&rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			rhs.ptr_ = nullptr;
+			rhs.block_ = nullptr;
+		}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr(basic_shared_ptr<U, Count> &&rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			rhs.ptr_ = nullptr;
+			rhs.block_ = nullptr;
+		}
+
+		// 别名构造：与 rhs 共享所有权，但指向 ptr（通常是 rhs 所指对象的成员）
+		template <class U>
+		basic_shared_ptr(const basic_shared_ptr<U, Count> &rhs, T *ptr) noexcept : ptr_(ptr), block_(rhs.block_) {
+			if (block_ != nullptr) {
+				block_->add_ref();
+			}
+		}
+
+		// 对象已经析构时抛出 runtime_error
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		explicit basic_shared_ptr(const basic_weak_ptr<U, Count> &rhs) : ptr_(rhs.ptr_), block_(rhs.block_) {
+			THROW_RUNTIME_ERROR_IF(block_ == nullptr || !block_->add_ref_if_alive(), "shared_ptr : expired weak_ptr");
+		}
+
+		// 接管 rhs 的对象与删除器，分配控制块失败时 rhs 不变
+		template <class U, class Deleter, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr(unique_ptr<U, Deleter> &&rhs) : ptr_(rhs.get()), block_(nullptr) {
+			if (ptr_ != nullptr) {
+				block_ = new shared_pointer_block<U, Deleter, Count>(rhs.get(), wstl::move(rhs.get_deleter()));
+				rhs.release();
+			}
+		}
+
+		basic_shared_ptr &operator=(const basic_shared_ptr &rhs) noexcept {
+			basic_shared_ptr(rhs).swap(*this);
+			return *this;
+		}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr &operator=(const basic_shared_ptr<U, Count> &rhs) noexcept {
+			basic_shared_ptr(rhs).swap(*this);
+			return *this;
+		}
+
+		basic_shared_ptr &operator=(basic_shared_ptr &&rhs) noexcept {
+			basic_shared_ptr(wstl::move(rhs)).swap(*this);
+			return *this;
+		}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr &operator=(basic_shared_ptr<U, Count> &&rhs) noexcept {
+			basic_shared_ptr(wstl::move(rhs)).swap(*this);
+			return *this;
+		}
+
+		template <class U, class Deleter, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_shared_ptr &operator=(unique_ptr<U, Deleter> &&rhs) {
+			basic_shared_ptr(wstl::move(rhs)).swap(*this);
+			return *this;
+		}
+
+		~basic_shared_ptr() {
+			if (block_ != nullptr) {
+				block_->release();
+			}
+		}
+
+	public:
+		// 观察器
+		typename std::add_lvalue_reference<T>::type operator*() const noexcept {
+			return *ptr_;
+		}
+
+		T *operator->() const noexcept {
+			return ptr_;
+		}
+
+		T *get() const noexcept {
+			return ptr_;
+		}
+
+		long use_count() const noexcept {
+			return block_ == nullptr ? 0 : block_->use_count();
+		}
+
+		explicit operator bool() const noexcept {
+			return ptr_ != nullptr;
+		}
+
+		// 按控制块排序，同一对象的别名指针视为相等
+		template <class U>
+		bool owner_before(const basic_shared_ptr<U, Count> &rhs) const noexcept {
+			return block_ < rhs.block_;
+		}
+
+		template <class U>
+		bool owner_before(const basic_weak_ptr<U, Count> &rhs) const noexcept {
+			return block_ < rhs.block_;
+		}
+
+		// 修改器
+		void reset() noexcept {
+			basic_shared_ptr().swap(*this);
+		}
+
+		template <class U>
+		void reset(U *ptr) {
+			basic_shared_ptr(ptr).swap(*this);
+		}
+
+		template <class U, class Deleter>
+		void reset(U *ptr, Deleter deleter) {
+			basic_shared_ptr(ptr, deleter).swap(*this);
+		}
+
+		void swap(basic_shared_ptr &rhs) noexcept {
+			wstl::swap(ptr_, rhs.ptr_);
+			wstl::swap(block_, rhs.block_);
+		}
+	};
+
+	// 模版类 basic_weak_ptr，weak_ptr 与 local_weak_ptr 的共同实现
+	template <class T, class Count>
+	class basic_weak_ptr {
+	public:
+		typedef T element_type;
+
+	private:
+		typedef shared_control_block<Count> block_type;
+
+		template <class U, class C>
+		friend class basic_shared_ptr;
+		template <class U, class C>
+		friend class basic_weak_ptr;
+
+		T *ptr_;
+		block_type *block_;
+
+	public:
+		// 构造、复制、移动、析构函数
+		basic_weak_ptr() noexcept : ptr_(nullptr), block_(nullptr) {}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_weak_ptr(const basic_shared_ptr<U, Count> &rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			if (block_ != nullptr) {
+				block_->add_weak();
+			}
+		}
+
+		basic_weak_ptr(const basic_weak_ptr &rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			if (block_ != nullptr) {
+				block_->add_weak();
+			}
+		}
+
+		basic_weak_ptr(basic_weak_ptr &&rhs) noexcept : ptr_(rhs.ptr_), block_(rhs.block_) {
+			rhs.ptr_ = nullptr;
+			rhs.block_ = nullptr;
+		}
+
+		basic_weak_ptr &operator=(const basic_weak_ptr &rhs) noexcept {
+			basic_weak_ptr(rhs).swap(*this);
+			return *this;
+		}
+
+		basic_weak_ptr &operator=(basic_weak_ptr &&rhs) noexcept {
+			basic_weak_ptr(wstl::move(rhs)).swap(*this);
+			return *this;
+		}
+
+		template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+		basic_weak_ptr &operator=(const basic_shared_ptr<U, Count> &rhs) noexcept {
+			basic_weak_ptr(rhs).swap(*this);
+			return *this;
+		}
+
+		~basic_weak_ptr() {
+			if (block_ != nullptr) {
+				block_->release_weak();
+			}
+		}
+
+	public:
+		// 观察器
+		long use_count() const noexcept {
+			return block_ == nullptr ? 0 : block_->use_count();
+		}
+
+		bool expired() const noexcept {
+			return use_count() == 0;
+		}
+
+		// 对象仍然存在时返回共享它的 shared_ptr，否则返回空指针
+		basic_shared_ptr<T, Count> lock() const noexcept {
+			if (block_ != nullptr && block_->add_ref_if_alive()) {
+				return basic_shared_ptr<T, Count>(ptr_, block_);
+			}
+			return basic_shared_ptr<T, Count>();
+		}
+
+		template <class U>
+		bool owner_before(const basic_shared_ptr<U, Count> &rhs) const noexcept {
+			return block_ < rhs.block_;
+		}
+
+		template <class U>
+		bool owner_before(const basic_weak_ptr<U, Count> &rhs) const noexcept {
+			return block_ < rhs.block_;
+		}
+
+		// 修改器
+		void reset() noexcept {
+			basic_weak_ptr().swap(*this);
+		}
+
+		void swap(basic_weak_ptr &rhs) noexcept {
+			wstl::swap(ptr_, rhs.ptr_);
+			wstl::swap(block_, rhs.block_);
+		}
+	};
+
+	template <class T>
+	using shared_ptr = basic_shared_ptr<T, shared_atomic_count>;
+
+	template <class T>
+	using weak_ptr = basic_weak_ptr<T, shared_atomic_count>;
+
+	template <class T>
+	using local_shared_ptr = basic_shared_ptr<T, shared_local_count>;
+
+	template <class T>
+	using local_weak_ptr = basic_weak_ptr<T, shared_local_count>;
+
+	// shared_ptr_access, 用已经构造好的控制块创建 basic_shared_ptr
+	struct shared_ptr_access {
+		template <class T, class Count>
+		static basic_shared_ptr<T, Count> adopt(T *ptr, shared_control_block<Count> *block) noexcept {
+			return basic_shared_ptr<T, Count>(ptr, block);
+		}
+	};
+
+	// allocate_shared_block, 一次分配控制块与对象，对象的构造函数抛出异常时释放内存后重新抛出
+	template <class T, class Count, class Alloc, class... Args>
+	basic_shared_ptr<T, Count> allocate_shared_block(Args &&...args) {
+		typedef shared_inplace_block<T, Alloc, Count> block_type;
+		typedef typename block_type::block_allocator block_allocator;
+
+		block_type *block = block_allocator::allocate(1);
+		try {
+			::new (static_cast<void *>(block)) block_type(wstl::forward<Args>(args)...);
+		} catch (...) {
+			block_allocator::deallocate(block, 1);
+			throw;
+		}
+		return shared_ptr_access::adopt<T, Count>(block->value(), block);
+	}
+
+	// make_shared / allocate_shared
+
+	template <class T, class... Args>
+	shared_ptr<T> make_shared(Args &&...args) {
+		return allocate_shared_block<T, shared_atomic_count, wstl::allocator<T>>(wstl::forward<Args>(args)...);
+	}
+
+	// wstl 的分配器都是无状态的，alloc 只用来推导分配器类型
+	template <class T, class Alloc, class... Args>
+	shared_ptr<T> allocate_shared(const Alloc &, Args &&...args) {
+		return allocate_shared_block<T, shared_atomic_count, Alloc>(wstl::forward<Args>(args)...);
+	}
+
+	template <class T, class... Args>
+	local_shared_ptr<T> make_local_shared(Args &&...args) {
+		return allocate_shared_block<T, shared_local_count, wstl::allocator<T>>(wstl::forward<Args>(args)...);
+	}
+
+	template <class T, class Alloc, class... Args>
+	local_shared_ptr<T> allocate_local_shared(const Alloc &, Args &&...args) {
+		return allocate_shared_block<T, shared_local_count, Alloc>(wstl::forward<Args>(args)...);
+	}
+
+	// 指针转换
+
+	template <class T, class U, class Count>
+	basic_shared_ptr<T, Count> static_pointer_cast(const basic_shared_ptr<U, Count> &rhs) noexcept {
+		return basic_shared_ptr<T, Count>(rhs, static_cast<T *>(rhs.get()));
+	}
+
+	template <class T, class U, class Count>
+	basic_shared_ptr<T, Count> const_pointer_cast(const basic_shared_ptr<U, Count> &rhs) noexcept {
+		return basic_shared_ptr<T, Count>(rhs, const_cast<T *>(rhs.get()));
+	}
+
+	template <class T, class U, class Count>
+	basic_shared_ptr<T, Count> dynamic_pointer_cast(const basic_shared_ptr<U, Count> &rhs) noexcept {
+		T *ptr = dynamic_cast<T *>(rhs.get());
+		return ptr == nullptr ? basic_shared_ptr<T, Count>() : basic_shared_ptr<T, Count>(rhs, ptr);
+	}
+
+	// 重载比较操作符
+
+	template <class T, class U, class Count>
+	bool operator==(const basic_shared_ptr<T, Count> &lhs, const basic_shared_ptr<U, Count> &rhs) noexcept {
+		return lhs.get() == rhs.get();
+	}
+
+	template <class T, class U, class Count>
+	bool operator!=(const basic_shared_ptr<T, Count> &lhs, const basic_shared_ptr<U, Count> &rhs) noexcept {
+		return lhs.get() != rhs.get();
+	}
+
+	template <class T, class U, class Count>
+	bool operator<(const basic_shared_ptr<T, Count> &lhs, const basic_shared_ptr<U, Count> &rhs) noexcept {
+		return lhs.get() < rhs.get();
+	}
+
+	template <class T, class Count>
+	bool operator==(const basic_shared_ptr<T, Count> &lhs, std::nullptr_t) noexcept {
+		return !lhs;
+	}
+
+	template <class T, class Count>
+	bool operator==(std::nullptr_t, const basic_shared_ptr<T, Count> &rhs) noexcept {
+		return !rhs;
+	}
+
+	template <class T, class Count>
+	bool operator!=(const basic_shared_ptr<T, Count> &lhs, std::nullptr_t) noexcept {
+		return static_cast<bool>(lhs);
+	}
+
+	template <class T, class Count>
+	bool operator!=(std::nullptr_t, const basic_shared_ptr<T, Count> &rhs) noexcept {
+		return static_cast<bool>(rhs);
+	}
+
+	// 重载 wstl 的 swap
+
+	template <class T, class Count>
+	void swap(basic_shared_ptr<T, Count> &lhs, basic_shared_ptr<T, Count> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+	template <class T, class Count>
+	void swap(basic_weak_ptr<T, Count> &lhs, basic_weak_ptr<T, Count> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+} // namespace wstl
 
-#endif // WSTL_MEMORY_H
\ No newline at end of file
+#endif // WSTL_MEMORY_H
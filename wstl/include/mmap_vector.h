@@ -0,0 +1,492 @@
+#ifndef WSTL_MMAP_VECTOR_H
+#define WSTL_MMAP_VECTOR_H
+
+/*
+	该文件实现以内存映射文件为存储的 mmap_vector<T>（仅 POSIX）
+
+	mmap_vector 把整个文件映射为连续的 T 数组，打开时不读取内容，页面在第一次访问时才由内核调入，
+	因此打开数 GB 的记录文件只需一次 mmap 系统调用。接口与 vector 相同：data()、指针迭代器、operator[] 等。
+
+	打开模式：
+		read_only  : 只读映射，修改容器的操作抛出 std::runtime_error，通过指针写入元素会触发 SIGSEGV
+		read_write : 读写映射，文件不存在时创建，修改直接写回文件（MAP_SHARED）
+		truncate   : 同 read_write，但打开时清空文件
+
+	增长：
+		容量不足时按 1.5 倍（按页对齐）扩大，先 ftruncate 扩展文件，再用 mremap 扩大映射（非 Linux 平台重新 mmap）。
+		映射期间文件长度等于容量，close / 析构时把文件截断为实际长度。
+		扩容可能移动映射地址，此前的指针、迭代器全部失效。
+
+	T 必须是可平凡复制的类型，文件中的字节按本机字节序与对齐方式解释。
+
+	Windows 上不提供 mmap_vector，包含本文件不会定义任何内容。
+*/
+
+#if !defined(_WIN32)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace wstl {
+
+	// 打开模式
+	enum class mmap_mode {
+		read_only,
+		read_write,
+		truncate
+	};
+
+	// 访问模式提示，对应 madvise
+	enum class mmap_advice {
+		normal,
+		sequential,
+		random,
+		willneed
+	};
+
+	// mmap_vector 类模板
+	template <class T>
+	class mmap_vector {
+		static_assert(std::is_trivially_copyable<T>::value, "mmap_vector requires a trivially copyable type");
+
+	public:
+		// mmap_vector 的嵌套型别定义
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef pointer iterator;
+		typedef const_pointer const_iterator;
+		typedef wstl::reverse_iterator<iterator> reverse_iterator;
+		typedef wstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		int fd_;
+		pointer begin_;
+		size_type size_;
+		size_type cap_; // 映射的元素个数，也是映射期间文件的长度
+		mmap_mode mode_;
+
+	public:
+		// 构造、移动、析构函数
+
+		mmap_vector() noexcept : fd_(-1), begin_(nullptr), size_(0), cap_(0), mode_(mmap_mode::read_only) {}
+
+		explicit mmap_vector(const char *path, mmap_mode mode = mmap_mode::read_only) : mmap_vector() {
+			open(path, mode);
+		}
+
+		mmap_vector(const mmap_vector &) = delete;
+		mmap_vector &operator=(const mmap_vector &) = delete;
+
+		mmap_vector(mmap_vector &&rhs) noexcept
+			: fd_(rhs.fd_), begin_(rhs.begin_), size_(rhs.size_), cap_(rhs.cap_), mode_(rhs.mode_) {
+			rhs.fd_ = -1;
+			rhs.begin_ = nullptr;
+			rhs.size_ = rhs.cap_ = 0;
+		}
+
+		mmap_vector &operator=(mmap_vector &&rhs) noexcept {
+			if (this != &rhs) {
+				close();
+				swap(rhs);
+			}
+			return *this;
+		}
+
+		~mmap_vector() {
+			close();
+		}
+
+	public:
+		// 文件相关操作
+
+		// open, 打开并映射文件，文件长度必须是 sizeof(T) 的整数倍
+		void open(const char *path, mmap_mode mode = mmap_mode::read_only);
+
+		// close, 解除映射并关闭文件，可写模式下把文件截断为实际长度
+		void close() noexcept;
+
+		bool is_open() const noexcept {
+			return fd_ >= 0;
+		}
+
+		bool writable() const noexcept {
+			return is_open() && mode_ != mmap_mode::read_only;
+		}
+
+		// flush, 把已修改的页同步写回磁盘
+		void flush();
+
+		// advise, 向内核提示访问模式，例如顺序扫描前使用 sequential 或 willneed 触发预读
+		void advise(mmap_advice advice) noexcept;
+
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return begin_;
+		}
+
+		const_iterator begin() const noexcept {
+			return begin_;
+		}
+
+		iterator end() noexcept {
+			return begin_ + size_;
+		}
+
+		const_iterator end() const noexcept {
+			return begin_ + size_;
+		}
+
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() noexcept {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+
+		const_iterator cend() const noexcept {
+			return end();
+		}
+
+		// 容量相关操作
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		size_type capacity() const noexcept {
+			return cap_;
+		}
+
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		size_type max_size() const noexcept {
+			return static_cast<size_type>(-1) / sizeof(T);
+		}
+
+		void reserve(size_type n);
+
+		void shrink_to_fit();
+
+		// 访问元素相关操作
+
+		reference operator[](size_type n) {
+			WSTL_DEBUG(n < size_);
+			return begin_[n];
+		}
+
+		const_reference operator[](size_type n) const {
+			WSTL_DEBUG(n < size_);
+			return begin_[n];
+		}
+
+		reference at(size_type n) {
+			THROW_OUT_OF_RANGE_IF(n >= size_, "mmap_vector<T> : out of range");
+			return begin_[n];
+		}
+
+		const_reference at(size_type n) const {
+			THROW_OUT_OF_RANGE_IF(n >= size_, "mmap_vector<T> : out of range");
+			return begin_[n];
+		}
+
+		reference front() {
+			WSTL_DEBUG(!empty());
+			return begin_[0];
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return begin_[0];
+		}
+
+		reference back() {
+			WSTL_DEBUG(!empty());
+			return begin_[size_ - 1];
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return begin_[size_ - 1];
+		}
+
+		pointer data() noexcept {
+			return begin_;
+		}
+
+		const_pointer data() const noexcept {
+			return begin_;
+		}
+
+		// 修改容器相关操作，只读模式下抛出 std::runtime_error
+
+		template <class... Args>
+		void emplace_back(Args &&...args);
+
+		void push_back(const value_type &value) {
+			emplace_back(value);
+		}
+
+		void pop_back() {
+			WSTL_DEBUG(!empty());
+			check_writable();
+			--size_;
+		}
+
+		void resize(size_type new_size, const value_type &value);
+
+		void resize(size_type new_size) {
+			resize(new_size, value_type());
+		}
+
+		void clear() {
+			check_writable();
+			size_ = 0;
+		}
+
+		void swap(mmap_vector &rhs) noexcept {
+			wstl::swap(fd_, rhs.fd_);
+			wstl::swap(begin_, rhs.begin_);
+			wstl::swap(size_, rhs.size_);
+			wstl::swap(cap_, rhs.cap_);
+			wstl::swap(mode_, rhs.mode_);
+		}
+
+	private:
+		// helper functions
+
+		void check_writable() const {
+			THROW_RUNTIME_ERROR_IF(!writable(), "mmap_vector<T> : mapping is not writable");
+		}
+
+		static size_type page_size() noexcept {
+			static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+			return page;
+		}
+
+		// calculate the growth size, 与 vector 相同的 1.5 倍增长，字节数按页对齐
+		size_type get_new_cap(size_type add_size) const;
+
+		// remap, 把文件与映射调整为 new_cap 个元素
+		void remap(size_type new_cap);
+	};
+
+	/******************************************************************************************************/
+
+	// open
+	template <class T>
+	void mmap_vector<T>::open(const char *path, mmap_mode mode) {
+		close();
+		const int flags = mode == mmap_mode::read_only ? O_RDONLY
+													   : (O_RDWR | O_CREAT | (mode == mmap_mode::truncate ? O_TRUNC : 0));
+		fd_ = ::open(path, flags | O_CLOEXEC, 0644);
+		THROW_RUNTIME_ERROR_IF(fd_ < 0, "mmap_vector<T> : cannot open file");
+		mode_ = mode;
+		struct stat st;
+		if (::fstat(fd_, &st) != 0 || static_cast<size_type>(st.st_size) % sizeof(T) != 0) {
+			close();
+			throw std::runtime_error("mmap_vector<T> : file size is not a multiple of sizeof(T)");
+		}
+		const auto n = static_cast<size_type>(st.st_size) / sizeof(T);
+		if (n != 0) {
+			const int prot = mode == mmap_mode::read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+			void *p = ::mmap(nullptr, n * sizeof(T), prot, MAP_SHARED, fd_, 0);
+			if (p == MAP_FAILED) {
+				close();
+				throw std::runtime_error("mmap_vector<T> : mmap failed");
+			}
+			begin_ = static_cast<pointer>(p);
+		}
+		size_ = cap_ = n;
+	}
+
+	// close
+	template <class T>
+	void mmap_vector<T>::close() noexcept {
+		if (begin_ != nullptr) {
+			::munmap(begin_, cap_ * sizeof(T));
+		}
+		if (fd_ >= 0) {
+			if (mode_ != mmap_mode::read_only && size_ != cap_) {
+				const auto ret = ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T)));
+				(void)ret;
+			}
+			::close(fd_);
+		}
+		fd_ = -1;
+		begin_ = nullptr;
+		size_ = cap_ = 0;
+	}
+
+	// flush
+	template <class T>
+	void mmap_vector<T>::flush() {
+		if (begin_ != nullptr && writable()) {
+			THROW_RUNTIME_ERROR_IF(::msync(begin_, cap_ * sizeof(T), MS_SYNC) != 0, "mmap_vector<T> : msync failed");
+		}
+	}
+
+	// advise
+	template <class T>
+	void mmap_vector<T>::advise(mmap_advice advice) noexcept {
+		if (begin_ == nullptr) {
+			return;
+		}
+		int flag = MADV_NORMAL;
+		switch (advice) {
+		case mmap_advice::sequential:
+			flag = MADV_SEQUENTIAL;
+			break;
+		case mmap_advice::random:
+			flag = MADV_RANDOM;
+			break;
+		case mmap_advice::willneed:
+			flag = MADV_WILLNEED;
+			break;
+		default:
+			break;
+		}
+		::madvise(begin_, cap_ * sizeof(T), flag);
+	}
+
+	// reserve
+	template <class T>
+	void mmap_vector<T>::reserve(size_type n) {
+		check_writable();
+		if (cap_ < n) {
+			THROW_LENGTH_ERROR_IF(n > max_size(), "mmap_vector<T> : exceed max_size() in mmap_vector::reserve");
+			remap(n);
+		}
+	}
+
+	// shrink_to_fit, 文件与映射缩小到实际长度
+	template <class T>
+	void mmap_vector<T>::shrink_to_fit() {
+		check_writable();
+		if (size_ < cap_) {
+			remap(size_);
+		}
+	}
+
+	// emplace_back
+	template <class T>
+	template <class... Args>
+	void mmap_vector<T>::emplace_back(Args &&...args) {
+		check_writable();
+		if (size_ == cap_) {
+			// 参数可能引用映射内的元素，扩容前先构造出值
+			value_type value(wstl::forward<Args>(args)...);
+			remap(get_new_cap(1));
+			begin_[size_++] = value;
+		} else {
+			::new (static_cast<void *>(begin_ + size_)) value_type(wstl::forward<Args>(args)...);
+			++size_;
+		}
+	}
+
+	// resize
+	template <class T>
+	void mmap_vector<T>::resize(size_type new_size, const value_type &value) {
+		check_writable();
+		if (new_size > cap_) {
+			const value_type tmp = value;
+			remap(get_new_cap(new_size - size_));
+			wstl::fill(begin_ + size_, begin_ + new_size, tmp);
+		} else if (new_size > size_) {
+			wstl::fill(begin_ + size_, begin_ + new_size, value);
+		}
+		size_ = new_size;
+	}
+
+	//******************************************************************** */
+	// helper function
+
+	// get_new_cap
+	template <class T>
+	typename mmap_vector<T>::size_type mmap_vector<T>::get_new_cap(size_type add_size) const {
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - add_size, "mmap_vector<T> : size too big in mmap_vector::get_new_cap");
+		const auto grown = cap_ > max_size() - cap_ / 2 ? max_size() : cap_ + cap_ / 2;
+		const auto new_cap = wstl::max(grown, size_ + add_size);
+		const auto page = page_size();
+		const auto bytes = (new_cap * sizeof(T) + page - 1) / page * page;
+		return bytes / sizeof(T);
+	}
+
+	// remap
+	template <class T>
+	void mmap_vector<T>::remap(size_type new_cap) {
+		const auto old_bytes = cap_ * sizeof(T);
+		const auto new_bytes = new_cap * sizeof(T);
+		THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0, "mmap_vector<T> : ftruncate failed");
+		if (new_bytes == 0) {
+			if (begin_ != nullptr) {
+				::munmap(begin_, old_bytes);
+			}
+			begin_ = nullptr;
+			cap_ = 0;
+			return;
+		}
+		void *p = MAP_FAILED;
+		if (begin_ == nullptr) {
+			p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+		} else {
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+			p = ::mremap(begin_, old_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+			p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+			if (p != MAP_FAILED) {
+				::munmap(begin_, old_bytes);
+			}
+#endif
+		}
+		if (p == MAP_FAILED) {
+			const auto ret = ::ftruncate(fd_, static_cast<off_t>(old_bytes));
+			(void)ret;
+			throw std::runtime_error("mmap_vector<T> : remapping failed");
+		}
+		begin_ = static_cast<pointer>(p);
+		cap_ = new_cap;
+	}
+
+	// 重载 swap
+	template <class T>
+	void swap(mmap_vector<T> &lhs, mmap_vector<T> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+} // namespace wstl
+
+#endif // !_WIN32
+
+#endif // WSTL_MMAP_VECTOR_H
@@ -0,0 +1,338 @@
+#ifndef WSTL_MPMC_QUEUE_H
+#define WSTL_MPMC_QUEUE_H
+
+/*
+	该文件实现有界多生产者多消费者队列 mpmc_queue（Vyukov 序号槽算法）
+
+	每个槽位带有一个序号 sequence：
+		sequence == pos       槽位空闲，生产者可以在 pos 处写入
+		sequence == pos + 1   槽位已写入，消费者可以在 pos 处读出
+	生产者 / 消费者各自只竞争一个位置计数器（CAS），不使用互斥锁。
+
+	阻塞接口 push / pop 先指数退避自旋，仍失败时才挂起在条件变量上；
+	互斥锁只在存在挂起线程时才会被唤醒方获取，非阻塞路径上没有锁。
+
+	异常保证：
+	要求 T 的移动构造、移动赋值与析构不抛出异常：出队时槽位已被领取，移动赋值给 out 失败将无法恢复。若拷贝 / 就地构造可能抛出异常，
+	会先在队列外构造临时对象再移动入队，因此入队失败时队列状态不变。
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "sync.h"
+#include "util.h"
+
+namespace wstl {
+
+	// mpmc_queue 类模板
+	template <class T>
+	class mpmc_queue {
+		static_assert(std::is_nothrow_move_constructible<T>::value, "mpmc_queue<T> requires nothrow move constructible T");
+		static_assert(std::is_nothrow_move_assignable<T>::value, "mpmc_queue<T> requires nothrow move assignable T");
+		static_assert(std::is_nothrow_destructible<T>::value, "mpmc_queue<T> requires nothrow destructible T");
+
+	public:
+		typedef T value_type;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+
+	private:
+		// 槽位：序号 + 未初始化的元素存储
+		struct cell {
+			std::atomic<size_type> sequence;
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		};
+
+		typedef wstl::allocator<cell> cell_allocator;
+
+		cell *cells_;
+		size_type mask_;
+
+		// 生产者与消费者的位置计数器分别独占缓存行
+		char pad0_[cache_line_size];
+		std::atomic<size_type> enqueue_pos_;
+		char pad1_[cache_line_size - sizeof(std::atomic<size_type>)];
+		std::atomic<size_type> dequeue_pos_;
+		char pad2_[cache_line_size - sizeof(std::atomic<size_type>)];
+
+		// 挂起相关，仅在自旋失败后使用
+		std::atomic<unsigned> push_waiters_;
+		std::atomic<unsigned> pop_waiters_;
+		std::mutex park_mutex_;
+		std::condition_variable not_full_;
+		std::condition_variable not_empty_;
+
+	public:
+		// 构造、析构函数
+
+		explicit mpmc_queue(size_type capacity);
+
+		mpmc_queue(const mpmc_queue &) = delete;
+		mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+		~mpmc_queue();
+
+	public:
+		// 容量相关操作
+
+		size_type capacity() const noexcept {
+			return mask_ + 1;
+		}
+
+		// 并发修改时只是一个近似值
+		size_type size() const noexcept {
+			const auto head = dequeue_pos_.load(std::memory_order_relaxed);
+			const auto tail = enqueue_pos_.load(std::memory_order_relaxed);
+			return tail > head ? tail - head : 0;
+		}
+
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		// 非阻塞操作，队列满 / 空时立即返回 false
+
+		bool try_push(const value_type &value) {
+			return try_push_cat(value, std::is_nothrow_copy_constructible<T>());
+		}
+
+		bool try_push(value_type &&value) noexcept {
+			return try_emplace_unchecked(wstl::move(value));
+		}
+
+		template <class... Args>
+		bool try_emplace(Args &&...args) {
+			return try_emplace_cat(std::is_nothrow_constructible<T, Args...>(), wstl::forward<Args>(args)...);
+		}
+
+		bool try_pop(value_type &out);
+
+		// 阻塞操作，自旋退避后挂起等待
+
+		void push(const value_type &value);
+
+		void push(value_type &&value);
+
+		template <class... Args>
+		void emplace(Args &&...args) {
+			value_type tmp(wstl::forward<Args>(args)...);
+			push(wstl::move(tmp));
+		}
+
+		void pop(value_type &out);
+
+	private:
+		// helper functions
+
+		static value_type *cell_value(cell *c) noexcept {
+			return reinterpret_cast<value_type *>(&c->storage);
+		}
+
+		bool try_push_cat(const value_type &value, std::true_type) noexcept {
+			return try_emplace_unchecked(value);
+		}
+
+		bool try_push_cat(const value_type &value, std::false_type) {
+			value_type tmp(value);
+			return try_emplace_unchecked(wstl::move(tmp));
+		}
+
+		template <class... Args>
+		bool try_emplace_cat(std::true_type, Args &&...args) noexcept {
+			return try_emplace_unchecked(wstl::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		bool try_emplace_cat(std::false_type, Args &&...args) {
+			value_type tmp(wstl::forward<Args>(args)...);
+			return try_emplace_unchecked(wstl::move(tmp));
+		}
+
+		// 占用槽位后就地构造，调用者保证构造不抛出异常
+		template <class... Args>
+		bool try_emplace_unchecked(Args &&...args) noexcept;
+
+		bool can_push() const noexcept;
+
+		bool can_pop() const noexcept;
+
+		void wake(std::atomic<unsigned> &waiters, std::condition_variable &cv);
+
+		template <class Predicate>
+		void park(std::atomic<unsigned> &waiters, std::condition_variable &cv, Predicate ready);
+	};
+
+	/******************************************************************************************************/
+
+	// 构造函数，容量向上取整为 2 的幂
+	template <class T>
+	mpmc_queue<T>::mpmc_queue(size_type capacity)
+		: cells_(nullptr), mask_(0), enqueue_pos_(0), dequeue_pos_(0), push_waiters_(0), pop_waiters_(0) {
+		THROW_LENGTH_ERROR_IF(capacity == 0, "mpmc_queue<T> : capacity must be positive");
+		THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 2) / sizeof(cell),
+							  "mpmc_queue<T> : capacity too big");
+		size_type n = 2;
+		while (n < capacity) {
+			n <<= 1;
+		}
+		cells_ = cell_allocator::allocate(n);
+		for (size_type i = 0; i < n; ++i) {
+			wstl::construct(cells_ + i);
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		mask_ = n - 1;
+	}
+
+	// 析构函数，销毁队列中剩余的元素
+	template <class T>
+	mpmc_queue<T>::~mpmc_queue() {
+		const auto tail = enqueue_pos_.load(std::memory_order_relaxed);
+		for (auto pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+			wstl::destroy(cell_value(cells_ + (pos & mask_)));
+		}
+		wstl::destroy(cells_, cells_ + capacity());
+		cell_allocator::deallocate(cells_, capacity());
+	}
+
+	// try_emplace_unchecked, 竞争 enqueue_pos_ 并在占到的槽位上构造元素
+	template <class T>
+	template <class... Args>
+	bool mpmc_queue<T>::try_emplace_unchecked(Args &&...args) noexcept {
+		cell *c;
+		auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+		for (;;) {
+			c = cells_ + (pos & mask_);
+			const auto seq = c->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<ptrdiff_t>(seq - pos);
+			if (diff == 0) {
+				if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // 队列已满
+			} else {
+				pos = enqueue_pos_.load(std::memory_order_relaxed);
+			}
+		}
+		wstl::construct(cell_value(c), wstl::forward<Args>(args)...);
+		c->sequence.store(pos + 1, std::memory_order_release);
+		wake(pop_waiters_, not_empty_);
+		return true;
+	}
+
+	// try_pop, 竞争 dequeue_pos_ 并把元素移动到 out 中
+	template <class T>
+	bool mpmc_queue<T>::try_pop(value_type &out) {
+		cell *c;
+		auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+		for (;;) {
+			c = cells_ + (pos & mask_);
+			const auto seq = c->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+			if (diff == 0) {
+				if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // 队列为空
+			} else {
+				pos = dequeue_pos_.load(std::memory_order_relaxed);
+			}
+		}
+		auto ptr = cell_value(c);
+		out = wstl::move(*ptr);
+		wstl::destroy(ptr);
+		c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+		wake(push_waiters_, not_full_);
+		return true;
+	}
+
+	// push, 阻塞入队
+	template <class T>
+	void mpmc_queue<T>::push(const value_type &value) {
+		if (!std::is_nothrow_copy_constructible<T>::value) {
+			value_type tmp(value);
+			push(wstl::move(tmp));
+			return;
+		}
+		spin_backoff backoff;
+		while (!try_emplace_unchecked(value)) {
+			if (!backoff.pause()) {
+				park(push_waiters_, not_full_, [this] { return can_push(); });
+				backoff.reset();
+			}
+		}
+	}
+
+	template <class T>
+	void mpmc_queue<T>::push(value_type &&value) {
+		spin_backoff backoff;
+		while (!try_emplace_unchecked(wstl::move(value))) {
+			if (!backoff.pause()) {
+				park(push_waiters_, not_full_, [this] { return can_push(); });
+				backoff.reset();
+			}
+		}
+	}
+
+	// pop, 阻塞出队
+	template <class T>
+	void mpmc_queue<T>::pop(value_type &out) {
+		spin_backoff backoff;
+		while (!try_pop(out)) {
+			if (!backoff.pause()) {
+				park(pop_waiters_, not_empty_, [this] { return can_pop(); });
+				backoff.reset();
+			}
+		}
+	}
+
+	/******************************************************************************************************/
+	// helper function
+
+	// can_push, 队尾槽位是否已被消费者释放
+	template <class T>
+	bool mpmc_queue<T>::can_push() const noexcept {
+		const auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+		const auto seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+		return static_cast<ptrdiff_t>(seq - pos) >= 0;
+	}
+
+	// can_pop, 队头槽位是否已被生产者写入
+	template <class T>
+	bool mpmc_queue<T>::can_pop() const noexcept {
+		const auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+		const auto seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+		return static_cast<ptrdiff_t>(seq - (pos + 1)) >= 0;
+	}
+
+	// wake, 有线程挂起时才加锁通知
+	// 与 park 中的栅栏配对：要么等待方能看到最新的槽位序号，要么通知方能看到等待计数
+	template <class T>
+	void mpmc_queue<T>::wake(std::atomic<unsigned> &waiters, std::condition_variable &cv) {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiters.load(std::memory_order_relaxed) != 0) {
+			std::lock_guard<std::mutex> lock(park_mutex_);
+			cv.notify_one();
+		}
+	}
+
+	// park, 挂起直到 ready() 为真
+	template <class T>
+	template <class Predicate>
+	void mpmc_queue<T>::park(std::atomic<unsigned> &waiters, std::condition_variable &cv, Predicate ready) {
+		std::unique_lock<std::mutex> lock(park_mutex_);
+		waiters.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		cv.wait(lock, ready);
+		waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+#endif // WSTL_MPMC_QUEUE_H
@@ -0,0 +1,249 @@
+#ifndef WSTL_NUMA_ALLOCATOR_H
+#define WSTL_NUMA_ALLOCATOR_H
+
+/*
+	该文件实现 NUMA 感知的分配器 numa_allocator<T, Policy, Threshold>（策略只在 Linux 上生效）
+
+	接口与 wstl::allocator 相同（全部是静态成员函数），可以直接作为 vector 等容器的 Alloc 参数。
+
+	请求的字节数不小于 Threshold（默认 1 MiB）时改用匿名 mmap，并在页面被访问之前用 mbind 设置内存策略：
+		numa_policy::local      : MPOL_LOCAL，页面分配在第一次访问它的线程所在的节点（first-touch），
+		                          配合 vector(n, value, parallel_init) 让每个线程初始化、随后也只读写自己那一段
+		numa_policy::interleave : MPOL_INTERLEAVE，页面轮流分配到所有在线节点，适合被所有线程随机访问的共享数组
+
+	mbind 通过 syscall 直接调用，不依赖 libnuma。只有一个节点、内核不支持（ENOSYS）、容器禁止（EPERM）
+	或者不在 Linux 上时跳过 mbind，退化为内核默认的 first-touch 策略，分配本身不受影响。
+	小于 Threshold 的请求不足以按页划分节点，直接使用 ::operator new。
+	Windows 上没有 mmap 路径，所有请求都使用 ::operator new。
+
+	释放时按相同的字节数判断走哪条路径，所以 deallocate 必须传入与 allocate 相同的 n（wstl 容器都是如此）。
+*/
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include <cstdio>
+#include <new>
+
+#include "construct.h"
+#include "util.h"
+
+namespace wstl {
+
+	enum class numa_policy {
+		local,
+		interleave
+	};
+
+	// numa_online_mask, 在线节点的位掩码（最多 64 个节点），读取失败时视为只有节点 0
+	inline unsigned long long numa_online_mask() noexcept {
+		static const unsigned long long mask = [] {
+			unsigned long long result = 0;
+			auto f = std::fopen("/sys/devices/system/node/online", "r");
+			if (f != nullptr) {
+				// 格式形如 "0-1,3"
+				unsigned lo = 0, hi = 0;
+				int sep = 0;
+				while (std::fscanf(f, "%u", &lo) == 1) {
+					hi = lo;
+					sep = std::fgetc(f);
+					if (sep == '-') {
+						if (std::fscanf(f, "%u", &hi) != 1) {
+							break;
+						}
+						sep = std::fgetc(f);
+					}
+					for (auto node = lo; node <= hi && node < 64; ++node) {
+						result |= 1ULL << node;
+					}
+					if (sep != ',') {
+						break;
+					}
+				}
+				std::fclose(f);
+			}
+			return result != 0 ? result : 1ULL;
+		}();
+		return mask;
+	}
+
+	// numa_node_count, 在线节点数
+	inline size_t numa_node_count() noexcept {
+		size_t count = 0;
+		for (auto mask = numa_online_mask(); mask != 0; mask &= mask - 1) {
+			++count;
+		}
+		return count;
+	}
+
+	// numa_bind, 为 [p, p + bytes) 设置内存策略，失败时保持默认策略并返回 false
+	inline bool numa_bind(void *p, size_t bytes, numa_policy policy) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+		if (numa_node_count() < 2) {
+			return false;
+		}
+		const unsigned long mpol_interleave = 3;
+		const unsigned long mpol_local = 4;
+		if (policy == numa_policy::interleave) {
+			unsigned long mask = static_cast<unsigned long>(numa_online_mask());
+			return ::syscall(SYS_mbind, p, bytes, mpol_interleave, &mask, sizeof(mask) * 8 + 1, 0UL) == 0;
+		}
+		return ::syscall(SYS_mbind, p, bytes, mpol_local, nullptr, 0UL, 0UL) == 0;
+#else
+		(void)p;
+		(void)bytes;
+		(void)policy;
+		return false;
+#endif
+	}
+
+#if !defined(_WIN32)
+	constexpr bool numa_mmap_available = true;
+
+	// numa_page_bytes, mmap 路径实际映射的字节数
+	inline size_t numa_page_bytes(size_t bytes) noexcept {
+		static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+		return (bytes + page - 1) / page * page;
+	}
+#else
+	constexpr bool numa_mmap_available = false;
+#endif
+
+	// 模版类 numa_allocator
+	template <class T, numa_policy Policy = numa_policy::interleave, size_t Threshold = size_t(1) << 20>
+	class numa_allocator {
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		static constexpr numa_policy policy = Policy;
+
+		// rebind, 策略与阈值不变
+		template <class U>
+		struct rebind {
+			typedef numa_allocator<U, Policy, Threshold> other;
+		};
+
+	public:
+		static T *allocate();
+		static T *allocate(size_type n);
+
+		static void deallocate(T *ptr);
+		static void deallocate(T *ptr, size_type n);
+
+		static void construct(T *ptr);
+		static void construct(T *ptr, const T &value);
+		static void construct(T *ptr, T &&value);
+
+		template <class... Args>
+		static void construct(T *ptr, Args &&...args);
+
+		static void destroy(T *ptr);
+		static void destroy(T *first, T *last);
+
+		// uses_mmap, n 个元素的分配是否按页映射并设置内存策略
+		static bool uses_mmap(size_type n) noexcept {
+			return numa_mmap_available && n * sizeof(T) >= Threshold;
+		}
+	};
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	constexpr numa_policy numa_allocator<T, Policy, Threshold>::policy;
+
+	// allocate 分配内存
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	T *numa_allocator<T, Policy, Threshold>::allocate() {
+		return allocate(1);
+	}
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	T *numa_allocator<T, Policy, Threshold>::allocate(size_type n) {
+		if (n == 0) {
+			return nullptr;
+		}
+		if (n > static_cast<size_type>(-1) / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+#if !defined(_WIN32)
+		if (uses_mmap(n)) {
+			const auto bytes = numa_page_bytes(n * sizeof(T));
+			void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED) {
+				throw std::bad_alloc();
+			}
+			numa_bind(p, bytes, Policy);
+			return static_cast<T *>(p);
+		}
+#endif
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+
+	// deallocate 释放内存
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::deallocate(T *ptr) {
+		deallocate(ptr, 1);
+	}
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::deallocate(T *ptr, size_type n) {
+		if (ptr == nullptr) {
+			return;
+		}
+#if !defined(_WIN32)
+		if (uses_mmap(n)) {
+			::munmap(ptr, numa_page_bytes(n * sizeof(T)));
+			return;
+		}
+#endif
+		::operator delete(ptr);
+	}
+
+	// construct 构造对象
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::construct(T *ptr) {
+		wstl::construct(ptr);
+	}
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::construct(T *ptr, const T &value) {
+		wstl::construct(ptr, value);
+	}
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::construct(T *ptr, T &&value) {
+		wstl::construct(ptr, wstl::move(value));
+	}
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	template <class... Args>
+	void numa_allocator<T, Policy, Threshold>::construct(T *ptr, Args &&...args) {
+		wstl::construct(ptr, wstl::forward<Args>(args)...);
+	}
+
+	// destroy 析构对象
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::destroy(T *ptr) {
+		wstl::destroy(ptr);
+	}
+
+	template <class T, numa_policy Policy, size_t Threshold>
+	void numa_allocator<T, Policy, Threshold>::destroy(T *first, T *last) {
+		wstl::destroy(first, last);
+	}
+} // namespace wstl
+
+#endif // WSTL_NUMA_ALLOCATOR_H
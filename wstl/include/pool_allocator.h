@@ -0,0 +1,302 @@
+#ifndef WSTL_POOL_ALLOCATOR_H
+#define WSTL_POOL_ALLOCATOR_H
+
+/*
+	该文件实现节点池分配器 pool_allocator<T, BlockSize>
+
+	用于 list 等每次只分配一个节点的容器，接口与 wstl::allocator 相同：
+
+		wstl::list<int, wstl::pool_allocator<int>> lru;
+
+	容器通过 rebind 得到 pool_allocator<list_node<int>>，单个对象的分配与释放在线程局部的空闲链表上完成，
+	稳定状态下（释放与分配的数量大致相当）不再调用 operator new，也不需要加锁。
+
+	node_pool<Size, Align, BlockSize>：
+		大小、对齐相同的类型共用一个池。每个线程有自己的空闲链表与当前内存块，
+		分配时先取空闲链表，再取共享空闲链表，再从当前块中切出，都没有时向 operator new 申请一块 BlockSize 字节的新块。
+		节点可以在其他线程中释放，释放后进入执行释放的线程的空闲链表；
+		线程的空闲节点超过两块的容量时，把一块的量交给加锁保护的共享空闲链表，供其他线程复用，
+		因此一个线程分配、另一个线程释放时池的大小仍由同时存在的节点数决定。
+		线程结束时，它的空闲节点与当前块中未切出的部分也交还共享空闲链表。
+		所有块都挂在共享状态上，共享状态从不析构，块在进程结束前不归还系统但始终可达。
+
+	allocate(n) / deallocate(p, n) 中 n != 1 的请求直接转交 wstl::allocator，
+	allocate() / deallocate(p) 总是使用节点池，必须成对使用。
+*/
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace wstl {
+
+	// node_pool, 大小为 Size、对齐为 Align 的节点池
+	template <size_t Size, size_t Align, size_t BlockSize>
+	class node_pool {
+		static_assert(Align <= alignof(std::max_align_t), "node_pool : over-aligned types are not supported");
+
+		struct free_node {
+			free_node *next;
+		};
+
+		struct block_header {
+			block_header *prev;
+		};
+
+		static constexpr size_t round_up(size_t n, size_t align) noexcept {
+			return (n + align - 1) / align * align;
+		}
+
+		static constexpr size_t node_align = Align > alignof(free_node) ? Align : alignof(free_node);
+
+	public:
+		static constexpr size_t node_size = round_up(Size > sizeof(free_node) ? Size : sizeof(free_node), node_align);
+
+	private:
+		static constexpr size_t header_size = round_up(sizeof(block_header), node_align);
+
+		static_assert(BlockSize >= header_size + node_size, "node_pool : block too small for one node");
+
+		static constexpr size_t block_nodes = (BlockSize - header_size) / node_size;
+
+		// 线程空闲链表超过 release_limit 个节点时，把 block_nodes 个交给共享空闲链表
+		static constexpr size_t release_limit = 2 * block_nodes;
+
+		// 所有线程共享的状态
+		struct shared_state {
+			std::mutex mutex;
+			free_node *free;	  // 其他线程交还的空闲节点
+			size_t count;
+			block_header *blocks; // 已申请的全部块
+
+			shared_state() noexcept : free(nullptr), count(0), blocks(nullptr) {}
+		};
+
+		// 线程局部状态，线程结束时把空闲节点交还共享状态
+		struct local_state {
+			free_node *free; // 空闲链表
+			size_t count;
+			char *cur;		 // 当前块中尚未切出的部分
+			char *end;
+
+			local_state() noexcept : free(nullptr), count(0), cur(nullptr), end(nullptr) {}
+
+			~local_state() {
+				for (; cur != end; cur += node_size) {
+					auto node = reinterpret_cast<free_node *>(cur);
+					node->next = free;
+					free = node;
+					++count;
+				}
+				if (free != nullptr) {
+					auto last = free;
+					while (last->next != nullptr) {
+						last = last->next;
+					}
+					release(free, last, count);
+				}
+				free = nullptr;
+				count = 0;
+			}
+		};
+
+		// 共享状态从不析构：进程退出时其他线程的 local_state 析构仍可能访问它
+		static shared_state &shared() {
+			static shared_state *state = new shared_state;
+			return *state;
+		}
+
+		static local_state &local() noexcept {
+			static thread_local local_state state;
+			return state;
+		}
+
+	public:
+		static void *allocate() {
+			auto &s = local();
+			if (s.free == nullptr && s.cur == s.end) {
+				refill(s);
+			}
+			if (s.free != nullptr) {
+				auto node = s.free;
+				s.free = node->next;
+				--s.count;
+				return node;
+			}
+			auto p = s.cur;
+			s.cur += node_size;
+			return p;
+		}
+
+		static void deallocate(void *p) noexcept {
+			auto &s = local();
+			auto node = static_cast<free_node *>(p);
+			node->next = s.free;
+			s.free = node;
+			if (++s.count > release_limit) {
+				// 空闲链表的前 block_nodes 个节点交给共享空闲链表
+				auto last = s.free;
+				for (size_t i = 1; i < block_nodes; ++i) {
+					last = last->next;
+				}
+				auto first = s.free;
+				s.free = last->next;
+				s.count -= block_nodes;
+				last->next = nullptr;
+				release(first, last, block_nodes);
+			}
+		}
+
+	private:
+		// release, 把 [first, last] 共 n 个节点的链表交给共享空闲链表
+		static void release(free_node *first, free_node *last, size_t n) noexcept {
+			auto &g = shared();
+			std::lock_guard<std::mutex> lock(g.mutex);
+			last->next = g.free;
+			g.free = first;
+			g.count += n;
+		}
+
+		// refill, 本线程没有空闲节点时取走整个共享空闲链表，共享空闲链表为空时申请一个新块
+		static void refill(local_state &s) {
+			auto &g = shared();
+			{
+				std::lock_guard<std::mutex> lock(g.mutex);
+				if (g.free != nullptr) {
+					s.free = g.free;
+					s.count = g.count;
+					g.free = nullptr;
+					g.count = 0;
+					return;
+				}
+			}
+			auto block = static_cast<char *>(::operator new(BlockSize));
+			auto header = reinterpret_cast<block_header *>(block);
+			s.cur = block + header_size;
+			s.end = s.cur + block_nodes * node_size;
+			std::lock_guard<std::mutex> lock(g.mutex);
+			header->prev = g.blocks;
+			g.blocks = header;
+		}
+	};
+
+	template <size_t Size, size_t Align, size_t BlockSize>
+	constexpr size_t node_pool<Size, Align, BlockSize>::node_size;
+
+	template <size_t Size, size_t Align, size_t BlockSize>
+	constexpr size_t node_pool<Size, Align, BlockSize>::block_nodes;
+
+	template <size_t Size, size_t Align, size_t BlockSize>
+	constexpr size_t node_pool<Size, Align, BlockSize>::release_limit;
+
+	// 模版类 pool_allocator
+	template <class T, size_t BlockSize = 4096>
+	class pool_allocator {
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef node_pool<sizeof(T), alignof(T), BlockSize> pool_type;
+
+		template <class U>
+		struct rebind {
+			typedef pool_allocator<U, BlockSize> other;
+		};
+
+	public:
+		static T *allocate();
+		static T *allocate(size_type n);
+
+		static void deallocate(T *ptr);
+		static void deallocate(T *ptr, size_type n);
+
+		static void construct(T *ptr);
+		static void construct(T *ptr, const T &value);
+		static void construct(T *ptr, T &&value);
+
+		template <class... Args>
+		static void construct(T *ptr, Args &&...args);
+
+		static void destroy(T *ptr);
+		static void destroy(T *first, T *last);
+	};
+
+	// allocate 分配内存
+
+	template <class T, size_t BlockSize>
+	T *pool_allocator<T, BlockSize>::allocate() {
+		return static_cast<T *>(pool_type::allocate());
+	}
+
+	template <class T, size_t BlockSize>
+	T *pool_allocator<T, BlockSize>::allocate(size_type n) {
+		if (n == 1) {
+			return allocate();
+		}
+		return wstl::allocator<T>::allocate(n);
+	}
+
+	// deallocate 释放内存
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::deallocate(T *ptr) {
+		if (ptr != nullptr) {
+			pool_type::deallocate(ptr);
+		}
+	}
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::deallocate(T *ptr, size_type n) {
+		if (n == 1) {
+			deallocate(ptr);
+		} else {
+			wstl::allocator<T>::deallocate(ptr, n);
+		}
+	}
+
+	// construct 构造对象
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::construct(T *ptr) {
+		wstl::construct(ptr);
+	}
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::construct(T *ptr, const T &value) {
+		wstl::construct(ptr, value);
+	}
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::construct(T *ptr, T &&value) {
+		wstl::construct(ptr, wstl::move(value));
+	}
+
+	template <class T, size_t BlockSize>
+	template <class... Args>
+	void pool_allocator<T, BlockSize>::construct(T *ptr, Args &&...args) {
+		wstl::construct(ptr, wstl::forward<Args>(args)...);
+	}
+
+	// destroy 析构对象
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::destroy(T *ptr) {
+		wstl::destroy(ptr);
+	}
+
+	template <class T, size_t BlockSize>
+	void pool_allocator<T, BlockSize>::destroy(T *first, T *last) {
+		wstl::destroy(first, last);
+	}
+} // namespace wstl
+
+#endif // WSTL_POOL_ALLOCATOR_H
@@ -0,0 +1,415 @@
+#ifndef WSTL_QUEUE_H
+#define WSTL_QUEUE_H
+
+/*
+	该文件实现优先队列适配器 priority_queue 以及支持修改优先级的 indexed_priority_queue
+
+	priority_queue<T, Container, Compare, Arity>：
+		在底层容器上维护 Arity 叉堆，Arity 默认为 2，大堆推荐使用 4（quaternary_priority_queue）
+	indexed_priority_queue<T, Compare, Arity>：
+		每个元素关联一个用户指定的整数 id，可以按 id 修改优先级（decrease_key / update）或删除
+*/
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "util.h"
+#include "vector.h"
+
+namespace wstl {
+
+	// priority_queue 类模板，comp(a, b) 为 true 表示 a 的优先级低于 b，默认大顶堆
+	template <class T, class Container = wstl::vector<T>, class Compare = wstl::less<typename Container::value_type>,
+			  size_t Arity = 2>
+	class priority_queue {
+		static_assert(Arity >= 2, "priority_queue arity must be at least 2");
+
+	public:
+		typedef Container container_type;
+		typedef Compare value_compare;
+
+		typedef typename Container::value_type value_type;
+		typedef typename Container::size_type size_type;
+		typedef typename Container::reference reference;
+		typedef typename Container::const_reference const_reference;
+
+		static constexpr size_t arity = Arity;
+
+	private:
+		container_type c_;
+		value_compare comp_;
+
+	public:
+		// 构造、复制、移动函数
+
+		priority_queue() = default;
+
+		explicit priority_queue(const value_compare &comp) : c_(), comp_(comp) {}
+
+		priority_queue(const value_compare &comp, const container_type &c) : c_(c), comp_(comp) {
+			wstl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		priority_queue(const value_compare &comp, container_type &&c) : c_(wstl::move(c)), comp_(comp) {
+			wstl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		priority_queue(InputIterator first, InputIterator last, const value_compare &comp = value_compare())
+			: c_(first, last), comp_(comp) {
+			wstl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		priority_queue(std::initializer_list<value_type> il, const value_compare &comp = value_compare())
+			: c_(il), comp_(comp) {
+			wstl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		priority_queue(const priority_queue &rhs) = default;
+
+		priority_queue(priority_queue &&rhs) = default;
+
+		priority_queue &operator=(const priority_queue &rhs) = default;
+
+		priority_queue &operator=(priority_queue &&rhs) = default;
+
+		priority_queue &operator=(std::initializer_list<value_type> il) {
+			c_ = il;
+			wstl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+			return *this;
+		}
+
+	public:
+		// 访问元素相关操作
+
+		const_reference top() const {
+			WSTL_DEBUG(!empty());
+			return c_.front();
+		}
+
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return c_.empty();
+		}
+
+		size_type size() const noexcept {
+			return c_.size();
+		}
+
+		// 修改容器相关操作
+
+		template <class... Args>
+		void emplace(Args &&...args) {
+			c_.emplace_back(wstl::forward<Args>(args)...);
+			wstl::dary_push_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		void push(const value_type &value) {
+			c_.push_back(value);
+			wstl::dary_push_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		void push(value_type &&value) {
+			c_.push_back(wstl::move(value));
+			wstl::dary_push_heap<Arity>(c_.begin(), c_.end(), comp_);
+		}
+
+		// push_range, 批量插入：新元素较多时整体重新建堆（O(n)），否则逐个上浮
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		void push_range(InputIterator first, InputIterator last);
+
+		void pop() {
+			WSTL_DEBUG(!empty());
+			wstl::dary_pop_heap<Arity>(c_.begin(), c_.end(), comp_);
+			c_.pop_back();
+		}
+
+		void clear() {
+			c_.clear();
+		}
+
+		void swap(priority_queue &rhs) noexcept {
+			wstl::swap(c_, rhs.c_);
+			wstl::swap(comp_, rhs.comp_);
+		}
+	};
+
+	template <class T, class Container, class Compare, size_t Arity>
+	constexpr size_t priority_queue<T, Container, Compare, Arity>::arity;
+
+	// push_range, 批量插入
+	template <class T, class Container, class Compare, size_t Arity>
+	template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type>
+	void priority_queue<T, Container, Compare, Arity>::push_range(InputIterator first, InputIterator last) {
+		const auto old_size = c_.size();
+		for (; first != last; ++first) {
+			c_.push_back(*first);
+		}
+		const auto added = c_.size() - old_size;
+		if (added > old_size / 4) {
+			wstl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+		} else {
+			for (auto i = old_size + 1; i <= c_.size(); ++i) {
+				wstl::dary_push_heap<Arity>(c_.begin(), c_.begin() + i, comp_);
+			}
+		}
+	}
+
+	// 重载 swap
+	template <class T, class Container, class Compare, size_t Arity>
+	void swap(priority_queue<T, Container, Compare, Arity> &lhs, priority_queue<T, Container, Compare, Arity> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+	// 四叉堆优先队列
+	template <class T, class Container = wstl::vector<T>, class Compare = wstl::less<typename Container::value_type>>
+	using quaternary_priority_queue = priority_queue<T, Container, Compare, 4>;
+
+	/******************************************************************************************************/
+
+	// indexed_priority_queue 类模板，元素以 [0, n) 内的整数 id 标识
+	// comp(a, b) 为 true 表示 a 的优先级低于 b；使用 wstl::greater<T> 即为小顶堆（Dijkstra 等场景）
+	template <class T, class Compare = wstl::less<T>, size_t Arity = 2>
+	class indexed_priority_queue {
+		static_assert(Arity >= 2, "indexed_priority_queue arity must be at least 2");
+
+	public:
+		typedef T value_type;
+		typedef Compare value_compare;
+		typedef size_t size_type;
+		typedef size_t id_type;
+		typedef const T &const_reference;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+	private:
+		struct entry {
+			id_type id;
+			value_type value;
+
+			entry(id_type i, const value_type &v) : id(i), value(v) {}
+
+			entry(id_type i, value_type &&v) : id(i), value(wstl::move(v)) {}
+		};
+
+		wstl::vector<entry> heap_;	  // 堆数组，元素与 id 一起存放，比较时不必间接寻址
+		wstl::vector<size_type> pos_; // id -> 在 heap_ 中的下标，不在队列中为 npos
+		value_compare comp_;
+
+	public:
+		indexed_priority_queue() = default;
+
+		explicit indexed_priority_queue(const value_compare &comp) : heap_(), pos_(), comp_(comp) {}
+
+		// 预留 id 范围 [0, n)
+		explicit indexed_priority_queue(size_type n, const value_compare &comp = value_compare())
+			: heap_(), pos_(n, npos), comp_(comp) {
+			heap_.reserve(n);
+		}
+
+	public:
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return heap_.empty();
+		}
+
+		size_type size() const noexcept {
+			return heap_.size();
+		}
+
+		bool contains(id_type id) const noexcept {
+			return id < pos_.size() && pos_[id] != npos;
+		}
+
+		// 访问元素相关操作
+
+		const_reference top() const {
+			WSTL_DEBUG(!empty());
+			return heap_.front().value;
+		}
+
+		id_type top_id() const {
+			WSTL_DEBUG(!empty());
+			return heap_.front().id;
+		}
+
+		const_reference value(id_type id) const {
+			THROW_OUT_OF_RANGE_IF(!contains(id), "indexed_priority_queue : id not in queue");
+			return heap_[pos_[id]].value;
+		}
+
+		// 修改容器相关操作
+
+		// push, 插入新 id，id 已存在时抛出异常
+		void push(id_type id, const value_type &value) {
+			emplace_entry(id, value);
+		}
+
+		void push(id_type id, value_type &&value) {
+			emplace_entry(id, wstl::move(value));
+		}
+
+		void pop() {
+			WSTL_DEBUG(!empty());
+			erase_at(0);
+		}
+
+		// erase, 删除 id，返回是否存在
+		bool erase(id_type id) {
+			if (!contains(id)) {
+				return false;
+			}
+			erase_at(pos_[id]);
+			return true;
+		}
+
+		// decrease_key, 把 id 的值改为优先级不低于原值的 value，只需上浮
+		void decrease_key(id_type id, const value_type &value) {
+			THROW_OUT_OF_RANGE_IF(!contains(id), "indexed_priority_queue : id not in queue");
+			const auto hole = pos_[id];
+			WSTL_DEBUG(!comp_(value, heap_[hole].value));
+			heap_[hole].value = value;
+			sift_up(hole);
+		}
+
+		// update, 任意修改 id 的值，不存在时插入
+		void update(id_type id, const value_type &value);
+
+		void clear() {
+			for (auto &e : heap_) {
+				pos_[e.id] = npos;
+			}
+			heap_.clear();
+		}
+
+		void swap(indexed_priority_queue &rhs) noexcept {
+			heap_.swap(rhs.heap_);
+			pos_.swap(rhs.pos_);
+			wstl::swap(comp_, rhs.comp_);
+		}
+
+	private:
+		// helper functions
+
+		template <class V>
+		void emplace_entry(id_type id, V &&value);
+
+		void erase_at(size_type index);
+
+		void sift_up(size_type hole);
+
+		void sift_down(size_type hole);
+
+		void place(size_type index, entry &&e) {
+			pos_[e.id] = index;
+			heap_[index] = wstl::move(e);
+		}
+	};
+
+	template <class T, class Compare, size_t Arity>
+	constexpr typename indexed_priority_queue<T, Compare, Arity>::size_type indexed_priority_queue<T, Compare, Arity>::npos;
+
+	// update, 按新值的方向上浮或下沉
+	template <class T, class Compare, size_t Arity>
+	void indexed_priority_queue<T, Compare, Arity>::update(id_type id, const value_type &value) {
+		if (!contains(id)) {
+			push(id, value);
+			return;
+		}
+		const auto hole = pos_[id];
+		const bool up = comp_(heap_[hole].value, value);
+		heap_[hole].value = value;
+		if (up) {
+			sift_up(hole);
+		} else {
+			sift_down(hole);
+		}
+	}
+
+	// emplace_entry, 追加到堆尾并上浮
+	template <class T, class Compare, size_t Arity>
+	template <class V>
+	void indexed_priority_queue<T, Compare, Arity>::emplace_entry(id_type id, V &&value) {
+		THROW_LENGTH_ERROR_IF(id == npos, "indexed_priority_queue : invalid id");
+		THROW_RUNTIME_ERROR_IF(contains(id), "indexed_priority_queue : id already in queue");
+		if (id >= pos_.size()) {
+			pos_.resize(id + 1, npos);
+		}
+		heap_.emplace_back(id, wstl::forward<V>(value));
+		pos_[id] = heap_.size() - 1;
+		sift_up(heap_.size() - 1);
+	}
+
+	// erase_at, 用堆尾元素填补 index，再根据其与原值的关系上浮或下沉
+	template <class T, class Compare, size_t Arity>
+	void indexed_priority_queue<T, Compare, Arity>::erase_at(size_type index) {
+		pos_[heap_[index].id] = npos;
+		const auto last = heap_.size() - 1;
+		if (index != last) {
+			const bool up = comp_(heap_[index].value, heap_[last].value);
+			place(index, wstl::move(heap_[last]));
+			heap_.pop_back();
+			if (up) {
+				sift_up(index);
+			} else {
+				sift_down(index);
+			}
+		} else {
+			heap_.pop_back();
+		}
+	}
+
+	// sift_up, 上浮 hole 处的元素
+	template <class T, class Compare, size_t Arity>
+	void indexed_priority_queue<T, Compare, Arity>::sift_up(size_type hole) {
+		entry e = wstl::move(heap_[hole]);
+		while (hole > 0) {
+			const auto parent = (hole - 1) / Arity;
+			if (!comp_(heap_[parent].value, e.value)) {
+				break;
+			}
+			place(hole, wstl::move(heap_[parent]));
+			hole = parent;
+		}
+		place(hole, wstl::move(e));
+	}
+
+	// sift_down, 下沉 hole 处的元素
+	template <class T, class Compare, size_t Arity>
+	void indexed_priority_queue<T, Compare, Arity>::sift_down(size_type hole) {
+		const auto len = heap_.size();
+		entry e = wstl::move(heap_[hole]);
+		for (;;) {
+			const auto child = Arity * hole + 1;
+			if (child >= len) {
+				break;
+			}
+			auto best = child;
+			const auto last = wstl::min(child + Arity, len);
+			for (auto c = child + 1; c < last; ++c) {
+				if (comp_(heap_[best].value, heap_[c].value)) {
+					best = c;
+				}
+			}
+			if (!comp_(e.value, heap_[best].value)) {
+				break;
+			}
+			place(hole, wstl::move(heap_[best]));
+			hole = best;
+		}
+		place(hole, wstl::move(e));
+	}
+
+	// 重载 swap
+	template <class T, class Compare, size_t Arity>
+	void swap(indexed_priority_queue<T, Compare, Arity> &lhs, indexed_priority_queue<T, Compare, Arity> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_QUEUE_H
@@ -0,0 +1,550 @@
+#ifndef WSTL_SERIALIZE_H
+#define WSTL_SERIALIZE_H
+
+/*
+	该文件实现 wstl 容器的二进制序列化
+
+	格式：
+		可平凡复制的值，以及成员都可按位读写且没有填充字节的 pair，直接写入其对象表示，不带头部；
+		容器（vector、basic_string）以及包含容器的 pair 写成一条记录：32 字节的 serial_header 后接负载。
+		元素可按位读写时（如 vector<pair<int, int>>），负载就是连续的元素数组，只需一次 fwrite 写出、一次 fread 读入，
+		头部记录元素大小、个数以及负载的校验和（xxHash64 算法）；
+		元素不可平凡复制时（例如 vector<string>），负载由各个元素依次序列化而成，头部的 elem_size 为 0，
+		校验由各个叶子记录自行完成。
+
+	零拷贝读取：
+		mapped_array<T> 用 mmap 映射由 save 写出的 vector<T> 文件，直接把负载当作 const T 数组访问，
+		负载紧跟在 32 字节头部之后，alignof(T) 不超过 32 时天然对齐。Windows 上不提供 mapped_array。
+
+	文件按本机字节序写出，读入时通过 magic 检测字节序不一致的文件。读写失败抛出 std::runtime_error。
+
+	头部中的元素个数来自文件，分配内存前会加以限制：负载超过 serial_chunk_bytes 时，
+	可定位的流要求剩余长度容得下负载，不可定位的流（管道等）分段扩容读入，
+	因此损坏或恶意的文件不会引起远超文件实际大小的分配。
+*/
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "basic_string.h"
+#include "exceptdef.h"
+#include "span.h"
+#include "util.h"
+#include "vector.h"
+
+namespace wstl {
+
+	/*****************************************************************************************/
+	// 										校验和
+	/*****************************************************************************************/
+
+	// checksum64, xxHash64 算法，每轮处理 32 字节，吞吐量接近内存带宽
+
+	constexpr uint64_t checksum_prime1 = 11400714785074694791ULL;
+	constexpr uint64_t checksum_prime2 = 14029467366897019727ULL;
+	constexpr uint64_t checksum_prime3 = 1609587929392839161ULL;
+	constexpr uint64_t checksum_prime4 = 9650029242287828579ULL;
+	constexpr uint64_t checksum_prime5 = 2870177450012600261ULL;
+
+	inline uint64_t checksum_rotl(uint64_t x, int r) noexcept {
+		return (x << r) | (x >> (64 - r));
+	}
+
+	inline uint64_t checksum_load64(const unsigned char *p) noexcept {
+		uint64_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline uint32_t checksum_load32(const unsigned char *p) noexcept {
+		uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline uint64_t checksum_round(uint64_t acc, uint64_t input) noexcept {
+		acc += input * checksum_prime2;
+		return checksum_rotl(acc, 31) * checksum_prime1;
+	}
+
+	inline uint64_t checksum_merge(uint64_t h, uint64_t v) noexcept {
+		h ^= checksum_round(0, v);
+		return h * checksum_prime1 + checksum_prime4;
+	}
+
+	inline uint64_t checksum64(const void *data, size_t n, uint64_t seed = 0) noexcept {
+		auto p = static_cast<const unsigned char *>(data);
+		const auto end = p + n;
+		uint64_t h;
+		if (n >= 32) {
+			uint64_t v1 = seed + checksum_prime1 + checksum_prime2;
+			uint64_t v2 = seed + checksum_prime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - checksum_prime1;
+			const auto limit = end - 32;
+			do {
+				v1 = checksum_round(v1, checksum_load64(p));
+				v2 = checksum_round(v2, checksum_load64(p + 8));
+				v3 = checksum_round(v3, checksum_load64(p + 16));
+				v4 = checksum_round(v4, checksum_load64(p + 24));
+				p += 32;
+			} while (p <= limit);
+			h = checksum_rotl(v1, 1) + checksum_rotl(v2, 7) + checksum_rotl(v3, 12) + checksum_rotl(v4, 18);
+			h = checksum_merge(h, v1);
+			h = checksum_merge(h, v2);
+			h = checksum_merge(h, v3);
+			h = checksum_merge(h, v4);
+		} else {
+			h = seed + checksum_prime5;
+		}
+		h += static_cast<uint64_t>(n);
+		for (; p + 8 <= end; p += 8) {
+			h ^= checksum_round(0, checksum_load64(p));
+			h = checksum_rotl(h, 27) * checksum_prime1 + checksum_prime4;
+		}
+		if (p + 4 <= end) {
+			h ^= static_cast<uint64_t>(checksum_load32(p)) * checksum_prime1;
+			h = checksum_rotl(h, 23) * checksum_prime2 + checksum_prime3;
+			p += 4;
+		}
+		for (; p < end; ++p) {
+			h ^= (*p) * checksum_prime5;
+			h = checksum_rotl(h, 11) * checksum_prime1;
+		}
+		h ^= h >> 33;
+		h *= checksum_prime2;
+		h ^= h >> 29;
+		h *= checksum_prime3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	/*****************************************************************************************/
+	// 										记录头部
+	/*****************************************************************************************/
+
+	// 记录类型，新增容器时在末尾追加
+	enum class serial_tag : uint16_t {
+		vector = 1,
+		pair = 2,
+		string = 3
+	};
+
+	constexpr uint32_t serial_magic = 0x4C545357; // 按小端读出为 "WSTL"
+	constexpr uint16_t serial_version = 1;
+	constexpr uint32_t serial_flag_checksum = 1; // checksum 字段有效
+
+	struct serial_header {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t tag;
+		uint32_t elem_size; // 元素大小，负载不是连续元素数组时为 0
+		uint32_t flags;
+		uint64_t count; // 元素个数
+		uint64_t checksum;
+	};
+
+	static_assert(sizeof(serial_header) == 32, "serial_header must be 32 bytes");
+
+	// 可平凡复制的类型按对象表示整体读写
+	template <class T>
+	struct is_bitwise_serializable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+	// wstl::pair 定义了赋值运算符，不是可平凡复制的，但两个成员都可按位读写且没有填充字节时，
+	// 对象表示就是两个成员依次排列，同样按对象表示整体读写
+	template <class T1, class T2>
+	struct is_bitwise_serializable<wstl::pair<T1, T2>>
+		: std::integral_constant<bool, is_bitwise_serializable<T1>::value && is_bitwise_serializable<T2>::value &&
+										   std::is_trivially_destructible<wstl::pair<T1, T2>>::value &&
+										   sizeof(wstl::pair<T1, T2>) == sizeof(T1) + sizeof(T2)> {};
+
+	/*****************************************************************************************/
+	// 										写出
+	/*****************************************************************************************/
+
+	// serial_write, 写出 n 字节
+	inline void serial_write(std::FILE *out, const void *data, size_t n) {
+		THROW_RUNTIME_ERROR_IF(n != 0 && std::fwrite(data, 1, n, out) != n, "serialize : write failed");
+	}
+
+	// serial_write_header
+	inline void serial_write_header(std::FILE *out, serial_tag tag, uint32_t elem_size, uint64_t count,
+									const void *payload) {
+		serial_header header;
+		header.magic = serial_magic;
+		header.version = serial_version;
+		header.tag = static_cast<uint16_t>(tag);
+		header.elem_size = elem_size;
+		header.flags = elem_size != 0 ? serial_flag_checksum : 0;
+		header.count = count;
+		header.checksum = elem_size != 0 ? checksum64(payload, static_cast<size_t>(count) * elem_size) : 0;
+		serial_write(out, &header, sizeof(header));
+	}
+
+	// 可平凡复制的值：直接写出对象表示
+	template <class T, typename std::enable_if<is_bitwise_serializable<T>::value, int>::type = 0>
+	void serialize(std::FILE *out, const T &value) {
+		serial_write(out, &value, sizeof(T));
+	}
+
+	template <class T1, class T2,
+			  typename std::enable_if<!is_bitwise_serializable<wstl::pair<T1, T2>>::value, int>::type = 0>
+	void serialize(std::FILE *out, const wstl::pair<T1, T2> &value);
+
+	template <class T, class Alloc>
+	void serialize(std::FILE *out, const wstl::vector<T, Alloc> &vec);
+
+	template <class CharT, class Traits, class Alloc>
+	void serialize(std::FILE *out, const wstl::basic_string<CharT, Traits, Alloc> &str);
+
+	// pair：包含容器时写成一条记录，依次写出 first、second
+	template <class T1, class T2,
+			  typename std::enable_if<!is_bitwise_serializable<wstl::pair<T1, T2>>::value, int>::type>
+	void serialize(std::FILE *out, const wstl::pair<T1, T2> &value) {
+		serial_write_header(out, serial_tag::pair, 0, 1, nullptr);
+		serialize(out, value.first);
+		serialize(out, value.second);
+	}
+
+	// vector：元素可平凡复制时一次写出整个数组
+	template <class T, class Alloc>
+	void serialize_elements(std::FILE *out, const wstl::vector<T, Alloc> &vec, std::true_type) {
+		serial_write_header(out, serial_tag::vector, sizeof(T), vec.size(), vec.data());
+		serial_write(out, vec.data(), vec.size() * sizeof(T));
+	}
+
+	template <class T, class Alloc>
+	void serialize_elements(std::FILE *out, const wstl::vector<T, Alloc> &vec, std::false_type) {
+		serial_write_header(out, serial_tag::vector, 0, vec.size(), nullptr);
+		for (const auto &value : vec) {
+			serialize(out, value);
+		}
+	}
+
+	template <class T, class Alloc>
+	void serialize(std::FILE *out, const wstl::vector<T, Alloc> &vec) {
+		serialize_elements(out, vec, is_bitwise_serializable<T>());
+	}
+
+	// basic_string
+	template <class CharT, class Traits, class Alloc>
+	void serialize(std::FILE *out, const wstl::basic_string<CharT, Traits, Alloc> &str) {
+		serial_write_header(out, serial_tag::string, sizeof(CharT), str.size(), str.data());
+		serial_write(out, str.data(), str.size() * sizeof(CharT));
+	}
+
+	/*****************************************************************************************/
+	// 										读入
+	/*****************************************************************************************/
+
+	// serial_read, 读入 n 字节
+	inline void serial_read(std::FILE *in, void *data, size_t n) {
+		THROW_RUNTIME_ERROR_IF(n != 0 && std::fread(data, 1, n, in) != n, "deserialize : unexpected end of file");
+	}
+
+	// serial_check_header, 检查头部的格式、类型与元素大小
+	inline void serial_check_header(const serial_header &header, serial_tag tag, uint32_t elem_size) {
+		THROW_RUNTIME_ERROR_IF(header.magic != serial_magic, "deserialize : bad magic or byte order");
+		THROW_RUNTIME_ERROR_IF(header.version != serial_version, "deserialize : unsupported version");
+		THROW_RUNTIME_ERROR_IF(header.tag != static_cast<uint16_t>(tag), "deserialize : record type mismatch");
+		THROW_RUNTIME_ERROR_IF(header.elem_size != elem_size, "deserialize : element size mismatch");
+		THROW_RUNTIME_ERROR_IF(elem_size != 0 && header.count > static_cast<uint64_t>(-1) / elem_size,
+							   "deserialize : record too large");
+	}
+
+	inline serial_header serial_read_header(std::FILE *in, serial_tag tag, uint32_t elem_size) {
+		serial_header header;
+		serial_read(in, &header, sizeof(header));
+		serial_check_header(header, tag, elem_size);
+		return header;
+	}
+
+	// 一次分配的负载上限，超过时先核对流的剩余长度或分段读入
+	constexpr size_t serial_chunk_bytes = size_t(1) << 20;
+
+	// serial_remaining, 流中剩余的字节数，流不可定位时返回 -1
+	inline int64_t serial_remaining(std::FILE *in) {
+		const long pos = std::ftell(in);
+		if (pos < 0 || std::fseek(in, 0, SEEK_END) != 0) {
+			return -1;
+		}
+		const long end = std::ftell(in);
+		THROW_RUNTIME_ERROR_IF(std::fseek(in, pos, SEEK_SET) != 0, "deserialize : seek failed");
+		return end < pos ? 0 : static_cast<int64_t>(end - pos);
+	}
+
+	// serial_read_array, 把 count 个可按位读写的元素读入 vector 或 basic_string
+	// 不可定位的流每段最多读入与已读部分同样多的元素，分配量不超过实际数据的两倍
+	template <class T, class Container>
+	void serial_read_array(std::FILE *in, Container &c, uint64_t count) {
+		THROW_RUNTIME_ERROR_IF(count > c.max_size(), "deserialize : record too large");
+		const auto n = static_cast<size_t>(count);
+		const size_t chunk_elems = serial_chunk_bytes / sizeof(T) == 0 ? 1 : serial_chunk_bytes / sizeof(T);
+		auto chunk = n;
+		if (n > chunk_elems) {
+			const auto remaining = serial_remaining(in);
+			if (remaining >= 0) {
+				THROW_RUNTIME_ERROR_IF(count > static_cast<uint64_t>(remaining) / sizeof(T),
+									   "deserialize : unexpected end of file");
+			} else {
+				chunk = chunk_elems;
+			}
+		}
+		c.clear();
+		size_t done = 0;
+		while (done < n) {
+			const auto len = done + wstl::min(n - done, wstl::max(chunk, done));
+			c.resize_and_overwrite(len, [in, done](T *p, size_t m) {
+				serial_read(in, p + done, (m - done) * sizeof(T));
+				return m;
+			});
+			done = len;
+		}
+	}
+
+	inline void serial_verify(const serial_header &header, const void *payload) {
+		THROW_RUNTIME_ERROR_IF((header.flags & serial_flag_checksum) != 0 &&
+								   checksum64(payload, static_cast<size_t>(header.count) * header.elem_size) != header.checksum,
+							   "deserialize : checksum mismatch");
+	}
+
+	template <class T, typename std::enable_if<is_bitwise_serializable<T>::value, int>::type = 0>
+	void deserialize(std::FILE *in, T &value) {
+		serial_read(in, &value, sizeof(T));
+	}
+
+	template <class T1, class T2,
+			  typename std::enable_if<!is_bitwise_serializable<wstl::pair<T1, T2>>::value, int>::type = 0>
+	void deserialize(std::FILE *in, wstl::pair<T1, T2> &value);
+
+	template <class T, class Alloc>
+	void deserialize(std::FILE *in, wstl::vector<T, Alloc> &vec);
+
+	template <class CharT, class Traits, class Alloc>
+	void deserialize(std::FILE *in, wstl::basic_string<CharT, Traits, Alloc> &str);
+
+	template <class T1, class T2,
+			  typename std::enable_if<!is_bitwise_serializable<wstl::pair<T1, T2>>::value, int>::type>
+	void deserialize(std::FILE *in, wstl::pair<T1, T2> &value) {
+		serial_read_header(in, serial_tag::pair, 0);
+		deserialize(in, value.first);
+		deserialize(in, value.second);
+	}
+
+	// vector：元素可按位读写时扩容但不初始化，再直接读入数组
+	template <class T, class Alloc>
+	void deserialize_elements(std::FILE *in, wstl::vector<T, Alloc> &vec, std::true_type) {
+		const auto header = serial_read_header(in, serial_tag::vector, sizeof(T));
+		serial_read_array<T>(in, vec, header.count);
+		serial_verify(header, vec.data());
+	}
+
+	// 元素逐个追加，预留量不超过 serial_chunk_bytes，其余随读入的数据增长
+	template <class T, class Alloc>
+	void deserialize_elements(std::FILE *in, wstl::vector<T, Alloc> &vec, std::false_type) {
+		const auto header = serial_read_header(in, serial_tag::vector, 0);
+		THROW_RUNTIME_ERROR_IF(header.count > vec.max_size(), "deserialize : record too large");
+		const auto n = static_cast<size_t>(header.count);
+		vec.clear();
+		vec.reserve(wstl::min(n, serial_chunk_bytes / sizeof(T) + 1));
+		for (size_t i = 0; i != n; ++i) {
+			vec.emplace_back();
+			deserialize(in, vec.back());
+		}
+	}
+
+	template <class T, class Alloc>
+	void deserialize(std::FILE *in, wstl::vector<T, Alloc> &vec) {
+		deserialize_elements(in, vec, is_bitwise_serializable<T>());
+	}
+
+	// basic_string：resize_and_overwrite 避免先初始化再覆盖
+	template <class CharT, class Traits, class Alloc>
+	void deserialize(std::FILE *in, wstl::basic_string<CharT, Traits, Alloc> &str) {
+		const auto header = serial_read_header(in, serial_tag::string, sizeof(CharT));
+		serial_read_array<CharT>(in, str, header.count);
+		serial_verify(header, str.data());
+	}
+
+	/*****************************************************************************************/
+	// 										文件
+	/*****************************************************************************************/
+
+	// save, 把 value 写入文件 path（覆盖）
+	template <class T>
+	void save(const char *path, const T &value) {
+		auto out = std::fopen(path, "wb");
+		THROW_RUNTIME_ERROR_IF(out == nullptr, "serialize : cannot open file");
+		try {
+			serialize(out, value);
+		} catch (...) {
+			std::fclose(out);
+			throw;
+		}
+		THROW_RUNTIME_ERROR_IF(std::fclose(out) != 0, "serialize : write failed");
+	}
+
+	// load, 从文件 path 读入 value
+	template <class T>
+	void load(const char *path, T &value) {
+		auto in = std::fopen(path, "rb");
+		THROW_RUNTIME_ERROR_IF(in == nullptr, "deserialize : cannot open file");
+		try {
+			deserialize(in, value);
+		} catch (...) {
+			std::fclose(in);
+			throw;
+		}
+		std::fclose(in);
+	}
+
+#if !defined(_WIN32)
+	/*****************************************************************************************/
+	// 										零拷贝读取
+	/*****************************************************************************************/
+
+	// mapped_array, 只读映射 save 写出的 vector<T> 文件，元素在首次访问时才由内核调入
+	template <class T>
+	class mapped_array {
+		static_assert(is_bitwise_serializable<T>::value, "mapped_array requires a bitwise serializable type");
+		static_assert(alignof(T) <= sizeof(serial_header), "payload is only aligned to the header size");
+
+	public:
+		typedef T value_type;
+		typedef const T *const_pointer;
+		typedef const T &const_reference;
+		typedef const T *const_iterator;
+		typedef size_t size_type;
+
+	private:
+		void *map_;
+		size_type map_bytes_;
+		size_type size_;
+
+	public:
+		mapped_array() noexcept : map_(nullptr), map_bytes_(0), size_(0) {}
+
+		// verify 为 true 时打开即校验整个负载（会读入所有页面）
+		explicit mapped_array(const char *path, bool verify = false) : mapped_array() {
+			open(path, verify);
+		}
+
+		mapped_array(const mapped_array &) = delete;
+		mapped_array &operator=(const mapped_array &) = delete;
+
+		mapped_array(mapped_array &&rhs) noexcept : map_(rhs.map_), map_bytes_(rhs.map_bytes_), size_(rhs.size_) {
+			rhs.map_ = nullptr;
+			rhs.map_bytes_ = rhs.size_ = 0;
+		}
+
+		mapped_array &operator=(mapped_array &&rhs) noexcept {
+			if (this != &rhs) {
+				close();
+				wstl::swap(map_, rhs.map_);
+				wstl::swap(map_bytes_, rhs.map_bytes_);
+				wstl::swap(size_, rhs.size_);
+			}
+			return *this;
+		}
+
+		~mapped_array() {
+			close();
+		}
+
+		void open(const char *path, bool verify = false);
+
+		void close() noexcept {
+			if (map_ != nullptr) {
+				::munmap(map_, map_bytes_);
+			}
+			map_ = nullptr;
+			map_bytes_ = size_ = 0;
+		}
+
+		const_iterator begin() const noexcept {
+			return data();
+		}
+
+		const_iterator end() const noexcept {
+			return data() + size_;
+		}
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		const_reference operator[](size_type n) const {
+			WSTL_DEBUG(n < size_);
+			return data()[n];
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return data()[0];
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return data()[size_ - 1];
+		}
+
+		const_pointer data() const noexcept {
+			return map_ == nullptr ? nullptr
+								   : reinterpret_cast<const_pointer>(static_cast<const unsigned char *>(map_) + sizeof(serial_header));
+		}
+
+		span<const T> view() const noexcept {
+			return span<const T>(data(), size_);
+		}
+	};
+
+	// open
+	template <class T>
+	void mapped_array<T>::open(const char *path, bool verify) {
+		close();
+		const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+		THROW_RUNTIME_ERROR_IF(fd < 0, "mapped_array : cannot open file");
+		struct stat st;
+		if (::fstat(fd, &st) != 0 || static_cast<size_type>(st.st_size) < sizeof(serial_header)) {
+			::close(fd);
+			throw std::runtime_error("mapped_array : file too small");
+		}
+		const auto bytes = static_cast<size_type>(st.st_size);
+		void *p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mapped_array : mmap failed");
+		map_ = p;
+		map_bytes_ = bytes;
+		try {
+			serial_header header;
+			std::memcpy(&header, map_, sizeof(header));
+			serial_check_header(header, serial_tag::vector, sizeof(T));
+			THROW_RUNTIME_ERROR_IF(header.count > (bytes - sizeof(serial_header)) / sizeof(T),
+								   "mapped_array : file truncated");
+			size_ = static_cast<size_type>(header.count);
+			if (verify) {
+				serial_verify(header, data());
+			}
+		} catch (...) {
+			close();
+			throw;
+		}
+	}
+#endif // !_WIN32
+} // namespace wstl
+
+#endif // WSTL_SERIALIZE_H
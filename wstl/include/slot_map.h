@@ -0,0 +1,320 @@
+#ifndef WSTL_SLOT_MAP_H
+#define WSTL_SLOT_MAP_H
+
+/*
+	该文件实现 slot_map<T>：以稳定句柄访问、元素紧凑存放的容器
+
+	insert 返回一个句柄 slot_map_key{index, generation}，之后通过句柄访问元素，插入、删除、查找都是 O(1)。
+	元素连续存放在 wstl::vector 中，begin() / end() 按存放顺序遍历，与遍历普通数组一样快；
+	删除时用最后一个元素填补空位（vector::unordered_erase），因此遍历顺序不固定，元素的地址也会改变，只有句柄保持稳定。
+
+	存储：
+		values_      : 元素，紧凑存放
+		value_slots_ : values_[i] 对应的槽位下标，删除时用来修正被搬移元素的槽位
+		slots_       : 槽位，占用时记录元素在 values_ 中的下标，空闲时记录下一个空闲槽位（空闲链表）
+
+	代数（generation）：
+		每个槽位有一个代数，占用时为奇数，空闲时为偶数，每次插入、删除都加一。
+		句柄记录插入时的代数，元素被删除后槽位即使被复用，代数也已不同，旧句柄查找失败而不会访问到新元素。
+		同一个槽位被复用约 2^31 次后代数回绕，极旧的句柄可能重新生效。
+*/
+
+#include <cstdint>
+
+#include "exceptdef.h"
+#include "util.h"
+#include "vector.h"
+
+namespace wstl {
+
+	// slot_map 的句柄
+	struct slot_map_key {
+		uint32_t index;
+		uint32_t generation;
+	};
+
+	inline bool operator==(const slot_map_key &lhs, const slot_map_key &rhs) {
+		return lhs.index == rhs.index && lhs.generation == rhs.generation;
+	}
+
+	inline bool operator!=(const slot_map_key &lhs, const slot_map_key &rhs) {
+		return !(lhs == rhs);
+	}
+
+	// slot_map 类模板
+	template <class T>
+	class slot_map {
+	public:
+		// slot_map 的嵌套型别定义
+		typedef T value_type;
+		typedef slot_map_key key_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef typename vector<T>::iterator iterator;
+		typedef typename vector<T>::const_iterator const_iterator;
+
+	private:
+		static constexpr uint32_t null_slot = 0xffffffffu;
+
+		struct slot {
+			uint32_t index; // 占用时为元素下标，空闲时为下一个空闲槽位
+			uint32_t generation;
+		};
+
+		vector<T> values_;
+		vector<uint32_t> value_slots_;
+		vector<slot> slots_;
+		uint32_t free_head_;
+
+	public:
+		// 构造、复制、移动、析构函数
+
+		slot_map() noexcept : free_head_(null_slot) {}
+
+		slot_map(const slot_map &) = default;
+		slot_map &operator=(const slot_map &) = default;
+
+		slot_map(slot_map &&rhs) noexcept
+			: values_(wstl::move(rhs.values_)), value_slots_(wstl::move(rhs.value_slots_)),
+			  slots_(wstl::move(rhs.slots_)), free_head_(rhs.free_head_) {
+			rhs.free_head_ = null_slot;
+		}
+
+		slot_map &operator=(slot_map &&rhs) noexcept {
+			if (this != &rhs) {
+				values_ = wstl::move(rhs.values_);
+				value_slots_ = wstl::move(rhs.value_slots_);
+				slots_ = wstl::move(rhs.slots_);
+				free_head_ = rhs.free_head_;
+				rhs.free_head_ = null_slot;
+			}
+			return *this;
+		}
+
+		~slot_map() = default;
+
+	public:
+		// 迭代器相关操作，按存放顺序遍历元素
+
+		iterator begin() noexcept {
+			return values_.begin();
+		}
+
+		const_iterator begin() const noexcept {
+			return values_.begin();
+		}
+
+		iterator end() noexcept {
+			return values_.end();
+		}
+
+		const_iterator end() const noexcept {
+			return values_.end();
+		}
+
+		pointer data() noexcept {
+			return values_.data();
+		}
+
+		const_pointer data() const noexcept {
+			return values_.data();
+		}
+
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return values_.empty();
+		}
+
+		size_type size() const noexcept {
+			return values_.size();
+		}
+
+		// 槽位数：曾经同时存在的元素个数的最大值
+		size_type slot_count() const noexcept {
+			return slots_.size();
+		}
+
+		void reserve(size_type n);
+
+		// 访问元素
+
+		// 代数为偶数的句柄不可能由 insert 发放，直接判为失效
+		bool contains(key_type key) const noexcept {
+			return (key.generation & 1) != 0 && key.index < slots_.size() && slots_[key.index].generation == key.generation;
+		}
+
+		// find, 句柄失效时返回 end()
+		iterator find(key_type key) noexcept {
+			return contains(key) ? values_.begin() + slots_[key.index].index : values_.end();
+		}
+
+		const_iterator find(key_type key) const noexcept {
+			return contains(key) ? values_.begin() + slots_[key.index].index : values_.end();
+		}
+
+		reference operator[](key_type key) {
+			WSTL_DEBUG(contains(key));
+			return values_[slots_[key.index].index];
+		}
+
+		const_reference operator[](key_type key) const {
+			WSTL_DEBUG(contains(key));
+			return values_[slots_[key.index].index];
+		}
+
+		reference at(key_type key) {
+			THROW_OUT_OF_RANGE_IF(!contains(key), "slot_map<T> : invalid key");
+			return (*this)[key];
+		}
+
+		const_reference at(key_type key) const {
+			THROW_OUT_OF_RANGE_IF(!contains(key), "slot_map<T> : invalid key");
+			return (*this)[key];
+		}
+
+		// 遍历时取得元素对应的句柄
+		key_type key_of(const_iterator position) const noexcept {
+			WSTL_DEBUG(position >= begin() && position < end());
+			const auto s = value_slots_[position - begin()];
+			return key_type{s, slots_[s].generation};
+		}
+
+		// 修改容器相关操作
+
+		template <class... Args>
+		key_type emplace(Args &&...args);
+
+		key_type insert(const value_type &value) {
+			return emplace(value);
+		}
+
+		key_type insert(value_type &&value) {
+			return emplace(wstl::move(value));
+		}
+
+		// erase, 句柄失效时返回 false
+		bool erase(key_type key);
+
+		// erase, 删除 position 处的元素，返回填补该位置的元素（删除的是最后一个元素时为 end()）
+		iterator erase(const_iterator position);
+
+		void clear();
+
+		void swap(slot_map &rhs) noexcept {
+			values_.swap(rhs.values_);
+			value_slots_.swap(rhs.value_slots_);
+			slots_.swap(rhs.slots_);
+			wstl::swap(free_head_, rhs.free_head_);
+		}
+
+	private:
+		// helper functions
+
+		uint32_t acquire_slot();
+
+		void release_slot(uint32_t s);
+	};
+
+	/*****************************************************************************************/
+
+	template <class T>
+	constexpr uint32_t slot_map<T>::null_slot;
+
+	// reserve, 预留 n 个元素与槽位的空间
+	template <class T>
+	void slot_map<T>::reserve(size_type n) {
+		values_.reserve(n);
+		value_slots_.reserve(n);
+		slots_.reserve(n);
+	}
+
+	// emplace, 在末尾构造元素并占用一个槽位，构造或分配失败时容器不变
+	template <class T>
+	template <class... Args>
+	typename slot_map<T>::key_type slot_map<T>::emplace(Args &&...args) {
+		const auto s = acquire_slot();
+		values_.emplace_back(wstl::forward<Args>(args)...);
+		try {
+			value_slots_.push_back(s);
+		} catch (...) {
+			values_.pop_back();
+			throw;
+		}
+		auto &entry = slots_[s];
+		free_head_ = entry.index;
+		entry.index = static_cast<uint32_t>(values_.size() - 1);
+		++entry.generation;
+		return key_type{s, entry.generation};
+	}
+
+	// erase
+	template <class T>
+	bool slot_map<T>::erase(key_type key) {
+		if (!contains(key)) {
+			return false;
+		}
+		erase(values_.begin() + slots_[key.index].index);
+		return true;
+	}
+
+	template <class T>
+	typename slot_map<T>::iterator slot_map<T>::erase(const_iterator position) {
+		WSTL_DEBUG(position >= begin() && position < end());
+		const auto i = static_cast<size_type>(position - begin());
+		release_slot(value_slots_[i]);
+		// 最后一个元素移到 i，修正它的槽位
+		if (i + 1 != values_.size()) {
+			slots_[value_slots_.back()].index = static_cast<uint32_t>(i);
+		}
+		value_slots_.unordered_erase(value_slots_.begin() + i);
+		return values_.unordered_erase(values_.begin() + i);
+	}
+
+	// clear, 删除所有元素，已发放的句柄全部失效
+	template <class T>
+	void slot_map<T>::clear() {
+		for (auto it = value_slots_.begin(); it != value_slots_.end(); ++it) {
+			release_slot(*it);
+		}
+		values_.clear();
+		value_slots_.clear();
+	}
+
+	// helper function
+
+	// acquire_slot, 返回空闲链表头部的槽位，没有空闲槽位时先新建一个并放入空闲链表
+	// 槽位在 emplace 成功后才真正取出，失败时留在空闲链表中
+	template <class T>
+	uint32_t slot_map<T>::acquire_slot() {
+		if (free_head_ == null_slot) {
+			THROW_LENGTH_ERROR_IF(slots_.size() >= null_slot, "slot_map<T> : too many slots");
+			slots_.push_back(slot{null_slot, 0});
+			free_head_ = static_cast<uint32_t>(slots_.size() - 1);
+		}
+		return free_head_;
+	}
+
+	// release_slot, 代数加一使旧句柄失效，并把槽位放回空闲链表
+	template <class T>
+	void slot_map<T>::release_slot(uint32_t s) {
+		auto &entry = slots_[s];
+		++entry.generation;
+		entry.index = free_head_;
+		free_head_ = s;
+	}
+
+	// 重载 swap
+	template <class T>
+	void swap(slot_map<T> &lhs, slot_map<T> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_SLOT_MAP_H
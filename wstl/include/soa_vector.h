@@ -0,0 +1,892 @@
+#ifndef WSTL_SOA_VECTOR_H
+#define WSTL_SOA_VECTOR_H
+
+/*
+	该文件实现按字段分列存放的 soa_vector<Ts...>（structure of arrays）
+
+	vector<Record> 把每条记录的所有字段放在一起，只读写其中一两个字段的循环也要把整条记录读进缓存。
+	soa_vector<T0, T1, ...> 把第 k 个字段的所有值连续存放在自己的数组中，循环只触及用到的字段，
+	field<k>() 返回该字段的 span，可以直接交给编译器向量化或手写 SIMD 的循环。
+
+	存储：
+		所有字段数组位于同一次分配中，共用 size / capacity，扩容策略与 vector::get_new_cap 相同。
+		每个字段数组的起始地址按 field_alignment（至少一个缓存行）对齐。
+		字段类型必须可以 noexcept 移动构造，扩容时逐列搬移不会中途失败。
+
+	按行访问：
+		operator[] / 迭代器返回代理引用 soa_reference，代表一整行：get<k>() 取得字段的引用，
+		对它赋值写入的是各字段的值，swap 交换两行的值，可以转换为 value_type（std::tuple<Ts...>）。
+		迭代器是随机访问迭代器，wstl 的 reverse / rotate / remove_if / 堆算法等都可以作用于整行。
+		比较函数会同时收到代理引用与 value_type，wstl::get<k>() 对二者都适用，soa_field_less<k> 按第 k 个字段比较。
+		代理引用的移动赋值、转换为 value_type 都会复制字段的值，以免 *a = *b 这样的写法误把 *b 的值移走。
+*/
+
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+
+#include "aligned_allocator.h"
+#include "algobase.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "span.h"
+#include "sync.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace wstl {
+
+	// 对参数包求值的辅助类型
+
+	template <class... Ts>
+	struct soa_all_nothrow_move;
+
+	template <>
+	struct soa_all_nothrow_move<> : std::true_type {};
+
+	template <class T, class... Ts>
+	struct soa_all_nothrow_move<T, Ts...>
+		: std::integral_constant<bool, std::is_nothrow_move_constructible<T>::value && soa_all_nothrow_move<Ts...>::value> {};
+
+	template <class... Ts>
+	struct soa_all_trivially_copyable;
+
+	template <>
+	struct soa_all_trivially_copyable<> : std::true_type {};
+
+	template <class T, class... Ts>
+	struct soa_all_trivially_copyable<T, Ts...>
+		: std::integral_constant<bool, std::is_trivially_copyable<T>::value && soa_all_trivially_copyable<Ts...>::value> {};
+
+	template <class... Ts>
+	struct soa_max_align;
+
+	template <>
+	struct soa_max_align<> : std::integral_constant<size_t, cache_line_size> {};
+
+	template <class T, class... Ts>
+	struct soa_max_align<T, Ts...>
+		: std::integral_constant<size_t, (alignof(T) > soa_max_align<Ts...>::value ? alignof(T) : soa_max_align<Ts...>::value)> {};
+
+	template <class... Ts>
+	struct soa_row_size;
+
+	template <>
+	struct soa_row_size<> : std::integral_constant<size_t, 0> {};
+
+	template <class T, class... Ts>
+	struct soa_row_size<T, Ts...> : std::integral_constant<size_t, sizeof(T) + soa_row_size<Ts...>::value> {};
+
+	template <class... Ts>
+	class soa_reference;
+
+	template <class... Ts>
+	class soa_iterator;
+
+	template <class... Ts>
+	class soa_vector;
+
+	/*****************************************************************************************/
+	// soa_reference, 代表 soa_vector 中一整行的代理引用，Ts 为 const 时只读
+
+	template <class... Ts>
+	class soa_reference {
+		template <class...>
+		friend class soa_reference;
+
+	public:
+		typedef std::tuple<typename std::remove_const<Ts>::type...> value_type;
+
+	private:
+		typedef make_index_sequence<sizeof...(Ts)> indices;
+
+		std::tuple<Ts *...> ptrs_;
+
+	public:
+		explicit soa_reference(const std::tuple<Ts *...> &ptrs) noexcept : ptrs_(ptrs) {}
+
+		soa_reference(const soa_reference &) = default;
+
+		// 可写的行引用可以转换为只读的行引用
+		template <class... Us>
+		soa_reference(const soa_reference<Us...> &rhs) noexcept : ptrs_(rhs.ptrs_) {}
+
+		template <size_t I>
+		typename std::tuple_element<I, std::tuple<Ts...>>::type &get() const noexcept {
+			return *std::get<I>(ptrs_);
+		}
+
+		// 赋值写入各字段的值，引用仍然指向原来的行
+		soa_reference &operator=(const soa_reference &rhs) {
+			assign(rhs, indices());
+			return *this;
+		}
+
+		template <class... Us>
+		soa_reference &operator=(const soa_reference<Us...> &rhs) {
+			assign(rhs, indices());
+			return *this;
+		}
+
+		soa_reference &operator=(const value_type &value) {
+			assign_value(value, indices());
+			return *this;
+		}
+
+		soa_reference &operator=(value_type &&value) {
+			move_value(value, indices());
+			return *this;
+		}
+
+		operator value_type() const {
+			return to_value(indices());
+		}
+
+		// 各字段引用组成的 tuple，便于比较或结构化地取出字段
+		std::tuple<Ts &...> tie() const noexcept {
+			return tie(indices());
+		}
+
+		// 交换两行的值
+		void swap(const soa_reference &rhs) const {
+			swap_values(rhs, indices());
+		}
+
+	private:
+		template <class... Us, size_t... Is>
+		void assign(const soa_reference<Us...> &rhs, index_sequence<Is...>) {
+			const int expand[] = {0, (*std::get<Is>(ptrs_) = *std::get<Is>(rhs.ptrs_), 0)...};
+			(void)expand;
+		}
+
+		template <size_t... Is>
+		void assign_value(const value_type &value, index_sequence<Is...>) {
+			const int expand[] = {0, (*std::get<Is>(ptrs_) = std::get<Is>(value), 0)...};
+			(void)expand;
+		}
+
+		template <size_t... Is>
+		void move_value(value_type &value, index_sequence<Is...>) {
+			const int expand[] = {0, (*std::get<Is>(ptrs_) = wstl::move(std::get<Is>(value)), 0)...};
+			(void)expand;
+		}
+
+		template <size_t... Is>
+		value_type to_value(index_sequence<Is...>) const {
+			return value_type(*std::get<Is>(ptrs_)...);
+		}
+
+		template <size_t... Is>
+		std::tuple<Ts &...> tie(index_sequence<Is...>) const noexcept {
+			return std::tuple<Ts &...>(*std::get<Is>(ptrs_)...);
+		}
+
+		template <size_t... Is>
+		void swap_values(const soa_reference &rhs, index_sequence<Is...>) const {
+			const int expand[] = {0, (wstl::swap(*std::get<Is>(ptrs_), *std::get<Is>(rhs.ptrs_)), 0)...};
+			(void)expand;
+		}
+	};
+
+	// 代理引用是纯右值，不能绑定到 wstl::swap(T &, T &)，由这个重载交换两行的值（wstl::iter_swap 调用 swap 成员）
+	template <class... Ts>
+	void swap(soa_reference<Ts...> lhs, soa_reference<Ts...> rhs) {
+		lhs.swap(rhs);
+	}
+
+	// 按行比较，逐个字段按字典序
+
+	template <class... Ts, class... Us>
+	bool operator==(const soa_reference<Ts...> &lhs, const soa_reference<Us...> &rhs) {
+		return lhs.tie() == rhs.tie();
+	}
+
+	template <class... Ts, class... Us>
+	bool operator!=(const soa_reference<Ts...> &lhs, const soa_reference<Us...> &rhs) {
+		return !(lhs == rhs);
+	}
+
+	template <class... Ts, class... Us>
+	bool operator<(const soa_reference<Ts...> &lhs, const soa_reference<Us...> &rhs) {
+		return lhs.tie() < rhs.tie();
+	}
+
+	// get, 取得一行中第 I 个字段，对 soa_reference 与 std::tuple 都适用
+
+	template <size_t I, class... Ts>
+	typename std::tuple_element<I, std::tuple<Ts...>>::type &get(const soa_reference<Ts...> &row) noexcept {
+		return row.template get<I>();
+	}
+
+	template <size_t I, class... Ts>
+	typename std::tuple_element<I, std::tuple<Ts...>>::type &get(std::tuple<Ts...> &row) noexcept {
+		return std::get<I>(row);
+	}
+
+	template <size_t I, class... Ts>
+	const typename std::tuple_element<I, std::tuple<Ts...>>::type &get(const std::tuple<Ts...> &row) noexcept {
+		return std::get<I>(row);
+	}
+
+	// soa_field_less, 按第 I 个字段比较两行
+	template <size_t I>
+	struct soa_field_less {
+		template <class Row1, class Row2>
+		bool operator()(const Row1 &lhs, const Row2 &rhs) const {
+			return wstl::get<I>(lhs) < wstl::get<I>(rhs);
+		}
+	};
+
+	/*****************************************************************************************/
+	// soa_iterator, 保存各字段数组的起始地址与行号的随机访问迭代器
+
+	template <class... Ts>
+	class soa_iterator {
+		template <class...>
+		friend class soa_iterator;
+
+	public:
+		typedef random_access_iterator_tag iterator_category;
+		typedef std::tuple<typename std::remove_const<Ts>::type...> value_type;
+		typedef ptrdiff_t difference_type;
+		typedef void pointer;
+		typedef soa_reference<Ts...> reference;
+
+	private:
+		typedef make_index_sequence<sizeof...(Ts)> indices;
+
+		std::tuple<Ts *...> base_;
+		difference_type index_;
+
+	public:
+		soa_iterator() noexcept : base_(), index_(0) {}
+
+		soa_iterator(const std::tuple<Ts *...> &base, difference_type index) noexcept : base_(base), index_(index) {}
+
+		// iterator 可以转换为 const_iterator
+		template <class... Us>
+		soa_iterator(const soa_iterator<Us...> &rhs) noexcept : base_(rhs.base_), index_(rhs.index_) {}
+
+		reference operator*() const noexcept {
+			return reference(row(index_, indices()));
+		}
+
+		reference operator[](difference_type n) const noexcept {
+			return reference(row(index_ + n, indices()));
+		}
+
+		difference_type index() const noexcept {
+			return index_;
+		}
+
+		soa_iterator &operator++() noexcept {
+			++index_;
+			return *this;
+		}
+
+		soa_iterator operator++(int) noexcept {
+			soa_iterator tmp = *this;
+			++index_;
+			return tmp;
+		}
+
+		soa_iterator &operator--() noexcept {
+			--index_;
+			return *this;
+		}
+
+		soa_iterator operator--(int) noexcept {
+			soa_iterator tmp = *this;
+			--index_;
+			return tmp;
+		}
+
+		soa_iterator &operator+=(difference_type n) noexcept {
+			index_ += n;
+			return *this;
+		}
+
+		soa_iterator &operator-=(difference_type n) noexcept {
+			index_ -= n;
+			return *this;
+		}
+
+		soa_iterator operator+(difference_type n) const noexcept {
+			return soa_iterator(base_, index_ + n);
+		}
+
+		soa_iterator operator-(difference_type n) const noexcept {
+			return soa_iterator(base_, index_ - n);
+		}
+
+		friend soa_iterator operator+(difference_type n, const soa_iterator &it) noexcept {
+			return it + n;
+		}
+
+		// 同一个容器的迭代器之间比较行号
+		template <class... Us>
+		difference_type operator-(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ - rhs.index_;
+		}
+
+		template <class... Us>
+		bool operator==(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ == rhs.index_;
+		}
+
+		template <class... Us>
+		bool operator!=(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ != rhs.index_;
+		}
+
+		template <class... Us>
+		bool operator<(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ < rhs.index_;
+		}
+
+		template <class... Us>
+		bool operator>(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ > rhs.index_;
+		}
+
+		template <class... Us>
+		bool operator<=(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ <= rhs.index_;
+		}
+
+		template <class... Us>
+		bool operator>=(const soa_iterator<Us...> &rhs) const noexcept {
+			return index_ >= rhs.index_;
+		}
+
+	private:
+		template <size_t... Is>
+		std::tuple<Ts *...> row(difference_type n, index_sequence<Is...>) const noexcept {
+			return std::tuple<Ts *...>((std::get<Is>(base_) + n)...);
+		}
+	};
+
+	/*****************************************************************************************/
+	// soa_vector 类模板
+
+	template <class... Ts>
+	class soa_vector {
+		static_assert(sizeof...(Ts) > 0, "soa_vector requires at least one field");
+		static_assert(soa_all_nothrow_move<Ts...>::value, "soa_vector requires nothrow move constructible fields");
+
+	public:
+		// soa_vector 的嵌套型别定义
+		typedef std::tuple<Ts...> value_type;
+		typedef soa_reference<Ts...> reference;
+		typedef soa_reference<const Ts...> const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef soa_iterator<Ts...> iterator;
+		typedef soa_iterator<const Ts...> const_iterator;
+
+		template <size_t I>
+		using field_type = typename std::tuple_element<I, value_type>::type;
+
+		static constexpr size_type field_count = sizeof...(Ts);
+
+		// 每个字段数组起始地址的对齐
+		static constexpr size_type field_alignment = soa_max_align<Ts...>::value;
+
+	private:
+		typedef make_index_sequence<sizeof...(Ts)> indices;
+
+		void *storage_;			  // 所有字段数组所在的单次分配
+		std::tuple<Ts *...> fields_; // 各字段数组的起始地址
+		size_type size_;
+		size_type cap_;
+
+	public:
+		// 构造、复制、移动、析构函数
+
+		soa_vector() noexcept : storage_(nullptr), fields_(), size_(0), cap_(0) {}
+
+		// n 行值初始化的元素；委托构造，构造途中抛出异常时析构函数会释放已构造的行
+		explicit soa_vector(size_type n) : soa_vector() {
+			resize(n);
+		}
+
+		soa_vector(std::initializer_list<value_type> il) : soa_vector() {
+			reserve(il.size());
+			for (auto it = il.begin(); it != il.end(); ++it) {
+				push_back(*it);
+			}
+		}
+
+		soa_vector(const soa_vector &rhs) : soa_vector() {
+			copy_from(rhs, soa_all_trivially_copyable<Ts...>());
+		}
+
+		soa_vector(soa_vector &&rhs) noexcept : storage_(rhs.storage_), fields_(rhs.fields_), size_(rhs.size_), cap_(rhs.cap_) {
+			rhs.storage_ = nullptr;
+			rhs.fields_ = std::tuple<Ts *...>();
+			rhs.size_ = 0;
+			rhs.cap_ = 0;
+		}
+
+		soa_vector &operator=(const soa_vector &rhs) {
+			if (this != &rhs) {
+				soa_vector tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		soa_vector &operator=(soa_vector &&rhs) noexcept {
+			soa_vector tmp(wstl::move(rhs));
+			swap(tmp);
+			return *this;
+		}
+
+		~soa_vector() {
+			destroy_rows(fields_, 0, size_, indices());
+			aligned_deallocate(storage_);
+		}
+
+	public:
+		// 迭代器相关操作
+
+		iterator begin() noexcept {
+			return iterator(fields_, 0);
+		}
+
+		const_iterator begin() const noexcept {
+			return cbegin();
+		}
+
+		iterator end() noexcept {
+			return iterator(fields_, static_cast<difference_type>(size_));
+		}
+
+		const_iterator end() const noexcept {
+			return cend();
+		}
+
+		const_iterator cbegin() const noexcept {
+			return const_iterator(iterator(fields_, 0));
+		}
+
+		const_iterator cend() const noexcept {
+			return const_iterator(iterator(fields_, static_cast<difference_type>(size_)));
+		}
+
+		// 容量相关操作
+
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		size_type size() const noexcept {
+			return size_;
+		}
+
+		size_type capacity() const noexcept {
+			return cap_;
+		}
+
+		size_type max_size() const noexcept {
+			return (static_cast<size_type>(-1) - field_count * field_alignment) / soa_row_size<Ts...>::value;
+		}
+
+		void reserve(size_type n) {
+			if (cap_ < n) {
+				THROW_LENGTH_ERROR_IF(n > max_size(), "soa_vector : exceed max_size() in soa_vector::reserve");
+				reallocate(n);
+			}
+		}
+
+		void shrink_to_fit() {
+			if (size_ < cap_) {
+				reallocate(size_);
+			}
+		}
+
+		// 按字段访问
+
+		template <size_t I>
+		field_type<I> *data() noexcept {
+			return std::get<I>(fields_);
+		}
+
+		template <size_t I>
+		const field_type<I> *data() const noexcept {
+			return std::get<I>(fields_);
+		}
+
+		// 第 I 个字段的所有值，起始地址按 field_alignment 对齐
+		template <size_t I>
+		span<field_type<I>> field() noexcept {
+			return span<field_type<I>>(data<I>(), size_);
+		}
+
+		template <size_t I>
+		span<const field_type<I>> field() const noexcept {
+			return span<const field_type<I>>(data<I>(), size_);
+		}
+
+		// 按行访问
+
+		reference operator[](size_type n) noexcept {
+			WSTL_DEBUG(n < size_);
+			return begin()[static_cast<difference_type>(n)];
+		}
+
+		const_reference operator[](size_type n) const noexcept {
+			WSTL_DEBUG(n < size_);
+			return cbegin()[static_cast<difference_type>(n)];
+		}
+
+		reference at(size_type n) {
+			THROW_OUT_OF_RANGE_IF(n >= size_, "soa_vector : out of range");
+			return (*this)[n];
+		}
+
+		const_reference at(size_type n) const {
+			THROW_OUT_OF_RANGE_IF(n >= size_, "soa_vector : out of range");
+			return (*this)[n];
+		}
+
+		reference front() noexcept {
+			WSTL_DEBUG(!empty());
+			return (*this)[0];
+		}
+
+		const_reference front() const noexcept {
+			WSTL_DEBUG(!empty());
+			return (*this)[0];
+		}
+
+		reference back() noexcept {
+			WSTL_DEBUG(!empty());
+			return (*this)[size_ - 1];
+		}
+
+		const_reference back() const noexcept {
+			WSTL_DEBUG(!empty());
+			return (*this)[size_ - 1];
+		}
+
+		// 修改容器相关操作
+
+		// emplace_back, 每个字段各取一个参数构造，参数可以引用本容器中的元素
+		template <class... Args>
+		void emplace_back(Args &&...args);
+
+		void push_back(const value_type &row) {
+			push_back_row(row, indices());
+		}
+
+		void push_back(value_type &&row) {
+			push_back_row(wstl::move(row), indices());
+		}
+
+		void pop_back() {
+			WSTL_DEBUG(!empty());
+			--size_;
+			destroy_rows(fields_, size_, size_ + 1, indices());
+		}
+
+		iterator erase(const_iterator position);
+
+		iterator erase(const_iterator first, const_iterator last);
+
+		// 新增的行值初始化
+		void resize(size_type new_size);
+
+		void clear() noexcept {
+			destroy_rows(fields_, 0, size_, indices());
+			size_ = 0;
+		}
+
+		void swap(soa_vector &rhs) noexcept {
+			wstl::swap(storage_, rhs.storage_);
+			wstl::swap(fields_, rhs.fields_);
+			wstl::swap(size_, rhs.size_);
+			wstl::swap(cap_, rhs.cap_);
+		}
+
+	private:
+		// helper functions
+
+		// 分配 / 释放
+
+		static size_type field_bytes(size_type n, size_type elem_size) noexcept {
+			return (n * elem_size + field_alignment - 1) / field_alignment * field_alignment;
+		}
+
+		template <size_t... Is>
+		static void *allocate(size_type n, std::tuple<Ts *...> &fields, index_sequence<Is...>);
+
+		void reallocate(size_type new_cap);
+
+		size_type get_new_cap(size_type add_size);
+
+		// 逐行构造 / 销毁
+
+		template <size_t... Is, class... Args>
+		static void construct_row(const std::tuple<Ts *...> &fields, size_type i, index_sequence<Is...>, Args &&...args);
+
+		template <size_t... Is>
+		static void value_init_row(const std::tuple<Ts *...> &fields, size_type i, index_sequence<Is...>);
+
+		template <size_t... Is>
+		static void destroy_partial_row(const std::tuple<Ts *...> &fields, size_type i, size_t n, index_sequence<Is...>);
+
+		template <size_t... Is>
+		static void destroy_rows(const std::tuple<Ts *...> &fields, size_type first, size_type last, index_sequence<Is...>);
+
+		template <size_t... Is>
+		static void move_rows(const std::tuple<Ts *...> &from, size_type n, const std::tuple<Ts *...> &to, index_sequence<Is...>);
+
+		template <size_t... Is>
+		void move_down(size_type first, size_type last, size_type result, index_sequence<Is...>);
+
+		template <size_t... Is>
+		void push_back_row(const value_type &row, index_sequence<Is...>) {
+			emplace_back(std::get<Is>(row)...);
+		}
+
+		template <size_t... Is>
+		void push_back_row(value_type &&row, index_sequence<Is...>) {
+			emplace_back(wstl::move(std::get<Is>(row))...);
+		}
+
+		void copy_from(const soa_vector &rhs, std::true_type);
+
+		void copy_from(const soa_vector &rhs, std::false_type);
+
+		template <size_t... Is>
+		void copy_fields(const soa_vector &rhs, index_sequence<Is...>);
+
+		template <size_t... Is>
+		void copy_row(const soa_vector &rhs, size_type i, index_sequence<Is...>) {
+			emplace_back(std::get<Is>(rhs.fields_)[i]...);
+		}
+	};
+
+	/*****************************************************************************************/
+
+	template <class... Ts>
+	constexpr typename soa_vector<Ts...>::size_type soa_vector<Ts...>::field_count;
+
+	template <class... Ts>
+	constexpr typename soa_vector<Ts...>::size_type soa_vector<Ts...>::field_alignment;
+
+	// emplace_back, 需要扩容时先在新存储中构造新行，再搬移旧行
+	template <class... Ts>
+	template <class... Args>
+	void soa_vector<Ts...>::emplace_back(Args &&...args) {
+		static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector::emplace_back takes one argument per field");
+		if (size_ != cap_) {
+			construct_row(fields_, size_, indices(), wstl::forward<Args>(args)...);
+			++size_;
+			return;
+		}
+		const auto new_cap = get_new_cap(1);
+		std::tuple<Ts *...> new_fields;
+		auto new_storage = allocate(new_cap, new_fields, indices());
+		try {
+			construct_row(new_fields, size_, indices(), wstl::forward<Args>(args)...);
+		} catch (...) {
+			aligned_deallocate(new_storage);
+			throw;
+		}
+		move_rows(fields_, size_, new_fields, indices());
+		destroy_rows(fields_, 0, size_, indices());
+		aligned_deallocate(storage_);
+		storage_ = new_storage;
+		fields_ = new_fields;
+		cap_ = new_cap;
+		++size_;
+	}
+
+	// erase, 删除 position 处的行，各字段分别前移
+	template <class... Ts>
+	typename soa_vector<Ts...>::iterator soa_vector<Ts...>::erase(const_iterator position) {
+		return erase(position, position + 1);
+	}
+
+	template <class... Ts>
+	typename soa_vector<Ts...>::iterator soa_vector<Ts...>::erase(const_iterator first, const_iterator last) {
+		WSTL_DEBUG(cbegin() <= first && first <= last && last <= cend());
+		const auto i = static_cast<size_type>(first.index());
+		const auto j = static_cast<size_type>(last.index());
+		if (i != j) {
+			move_down(j, size_, i, indices());
+			destroy_rows(fields_, size_ - (j - i), size_, indices());
+			size_ -= j - i;
+		}
+		return begin() + static_cast<difference_type>(i);
+	}
+
+	// resize
+	template <class... Ts>
+	void soa_vector<Ts...>::resize(size_type new_size) {
+		if (new_size <= size_) {
+			destroy_rows(fields_, new_size, size_, indices());
+			size_ = new_size;
+			return;
+		}
+		reserve(new_size);
+		for (; size_ < new_size; ++size_) {
+			value_init_row(fields_, size_, indices());
+		}
+	}
+
+	// helper function
+
+	// allocate, 一次分配容纳 n 行的存储，各字段数组依次排列并按 field_alignment 对齐
+	template <class... Ts>
+	template <size_t... Is>
+	void *soa_vector<Ts...>::allocate(size_type n, std::tuple<Ts *...> &fields, index_sequence<Is...>) {
+		const size_type bytes[] = {field_bytes(n, sizeof(Ts))...};
+		size_type offsets[sizeof...(Ts)];
+		size_type total = 0;
+		for (size_t k = 0; k < sizeof...(Ts); ++k) {
+			offsets[k] = total;
+			total += bytes[k];
+		}
+		auto storage = static_cast<unsigned char *>(aligned_allocate(total == 0 ? field_alignment : total, field_alignment));
+		fields = std::tuple<Ts *...>(reinterpret_cast<Ts *>(storage + offsets[Is])...);
+		return storage;
+	}
+
+	// reallocate, 搬到容量为 new_cap 的新存储
+	template <class... Ts>
+	void soa_vector<Ts...>::reallocate(size_type new_cap) {
+		std::tuple<Ts *...> new_fields;
+		auto new_storage = allocate(new_cap, new_fields, indices());
+		move_rows(fields_, size_, new_fields, indices());
+		destroy_rows(fields_, 0, size_, indices());
+		aligned_deallocate(storage_);
+		storage_ = new_storage;
+		fields_ = new_fields;
+		cap_ = new_cap;
+	}
+
+	// get_new_cap, 与 vector 相同：首次至少 16 行，之后按 1.5 倍增长
+	template <class... Ts>
+	typename soa_vector<Ts...>::size_type soa_vector<Ts...>::get_new_cap(size_type add_size) {
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - add_size, "soa_vector : size too big in soa_vector::get_new_cap");
+		if (size_ > max_size() - size_ / 2) {
+			return size_ + add_size;
+		}
+		return size_ == 0 ? wstl::max(static_cast<size_type>(16), add_size)
+						  : wstl::max(size_ + size_ / 2, size_ + add_size);
+	}
+
+	// construct_row, 依次构造第 i 行的各字段，某个字段构造失败时销毁本行已构造的字段
+	template <class... Ts>
+	template <size_t... Is, class... Args>
+	void soa_vector<Ts...>::construct_row(const std::tuple<Ts *...> &fields, size_type i, index_sequence<Is...>,
+										  Args &&...args) {
+		size_t constructed = 0;
+		try {
+			const int expand[] = {0, (wstl::construct(std::get<Is>(fields) + i, wstl::forward<Args>(args)), ++constructed, 0)...};
+			(void)expand;
+		} catch (...) {
+			destroy_partial_row(fields, i, constructed, indices());
+			throw;
+		}
+	}
+
+	template <class... Ts>
+	template <size_t... Is>
+	void soa_vector<Ts...>::value_init_row(const std::tuple<Ts *...> &fields, size_type i, index_sequence<Is...>) {
+		size_t constructed = 0;
+		try {
+			const int expand[] = {0, (wstl::construct(std::get<Is>(fields) + i), ++constructed, 0)...};
+			(void)expand;
+		} catch (...) {
+			destroy_partial_row(fields, i, constructed, indices());
+			throw;
+		}
+	}
+
+	// destroy_partial_row, 销毁第 i 行的前 n 个字段
+	template <class... Ts>
+	template <size_t... Is>
+	void soa_vector<Ts...>::destroy_partial_row(const std::tuple<Ts *...> &fields, size_type i, size_t n,
+												index_sequence<Is...>) {
+		const int expand[] = {0, (Is < n ? wstl::destroy(std::get<Is>(fields) + i) : void(), 0)...};
+		(void)expand;
+	}
+
+	// destroy_rows, 销毁 [first, last) 行，平凡析构的字段什么也不做
+	template <class... Ts>
+	template <size_t... Is>
+	void soa_vector<Ts...>::destroy_rows(const std::tuple<Ts *...> &fields, size_type first, size_type last,
+										 index_sequence<Is...>) {
+		const int expand[] = {0, (wstl::destroy(std::get<Is>(fields) + first, std::get<Is>(fields) + last), 0)...};
+		(void)expand;
+	}
+
+	// move_rows, 把前 n 行逐列移动构造到未初始化的新存储，平凡类型按列 memmove
+	template <class... Ts>
+	template <size_t... Is>
+	void soa_vector<Ts...>::move_rows(const std::tuple<Ts *...> &from, size_type n, const std::tuple<Ts *...> &to,
+									  index_sequence<Is...>) {
+		const int expand[] = {0, (wstl::uninitialized_move(std::get<Is>(from), std::get<Is>(from) + n, std::get<Is>(to)), 0)...};
+		(void)expand;
+	}
+
+	// move_down, 把 [first, last) 行逐列移动赋值到 result 开始的位置（result < first）
+	template <class... Ts>
+	template <size_t... Is>
+	void soa_vector<Ts...>::move_down(size_type first, size_type last, size_type result, index_sequence<Is...>) {
+		const int expand[] = {0, (wstl::move(std::get<Is>(fields_) + first, std::get<Is>(fields_) + last, std::get<Is>(fields_) + result), 0)...};
+		(void)expand;
+	}
+
+	// copy_from, 字段都可平凡复制时逐列整段复制，否则逐行构造
+	template <class... Ts>
+	void soa_vector<Ts...>::copy_from(const soa_vector &rhs, std::true_type) {
+		reserve(rhs.size_);
+		copy_fields(rhs, indices());
+		size_ = rhs.size_;
+	}
+
+	template <class... Ts>
+	void soa_vector<Ts...>::copy_from(const soa_vector &rhs, std::false_type) {
+		reserve(rhs.size_);
+		for (size_type i = 0; i < rhs.size_; ++i) {
+			copy_row(rhs, i, indices());
+		}
+	}
+
+	template <class... Ts>
+	template <size_t... Is>
+	void soa_vector<Ts...>::copy_fields(const soa_vector &rhs, index_sequence<Is...>) {
+		const int expand[] = {0, (wstl::uninitialized_copy(std::get<Is>(rhs.fields_), std::get<Is>(rhs.fields_) + rhs.size_, std::get<Is>(fields_)), 0)...};
+		(void)expand;
+	}
+
+	// 重载比较操作符
+
+	template <class... Ts>
+	bool operator==(const soa_vector<Ts...> &lhs, const soa_vector<Ts...> &rhs) {
+		return lhs.size() == rhs.size() && wstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class... Ts>
+	bool operator!=(const soa_vector<Ts...> &lhs, const soa_vector<Ts...> &rhs) {
+		return !(lhs == rhs);
+	}
+
+	// 重载 swap
+	template <class... Ts>
+	void swap(soa_vector<Ts...> &lhs, soa_vector<Ts...> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+} // namespace wstl
+
+#endif // WSTL_SOA_VECTOR_H
@@ -0,0 +1,278 @@
+#ifndef WSTL_SPAN_H
+#define WSTL_SPAN_H
+
+/*
+	该文件实现 span<T, Extent>：指向一段连续对象的非拥有视图
+
+	Extent 为 dynamic_extent 时 span 保存 {指针, 长度}，否则只保存指针，长度是编译期常量。
+	span 可以由原始数组、{指针, 长度}、[first, last) 以及任何提供 data() / size() 的连续容器（如 wstl::vector）构造，
+	first / last / subspan 只调整指针与长度，不复制元素。视图不延长被引用对象的生命周期。
+*/
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "exceptdef.h"
+#include "iterator.h"
+
+namespace wstl {
+
+	constexpr size_t dynamic_extent = static_cast<size_t>(-1);
+
+	template <class T, size_t Extent = dynamic_extent>
+	class span;
+
+	// span_storage, 静态长度只保存指针
+	template <class T, size_t Extent>
+	struct span_storage {
+		T *ptr;
+
+		constexpr span_storage() noexcept : ptr(nullptr) {}
+
+		constexpr span_storage(T *p, size_t) noexcept : ptr(p) {}
+
+		constexpr size_t size() const noexcept {
+			return Extent;
+		}
+	};
+
+	template <class T>
+	struct span_storage<T, dynamic_extent> {
+		T *ptr;
+		size_t len;
+
+		constexpr span_storage() noexcept : ptr(nullptr), len(0) {}
+
+		constexpr span_storage(T *p, size_t n) noexcept : ptr(p), len(n) {}
+
+		constexpr size_t size() const noexcept {
+			return len;
+		}
+	};
+
+	// is_span
+	template <class T>
+	struct is_span : std::false_type {};
+
+	template <class T, size_t Extent>
+	struct is_span<span<T, Extent>> : std::true_type {};
+
+	// is_span_compatible_container, Container 提供 data() / size()，且其元素指针可以转换为 T *
+	template <class Container, class T, class = void>
+	struct is_span_compatible_container : std::false_type {};
+
+	template <class Container, class T>
+	struct is_span_compatible_container<
+		Container, T,
+		typename std::enable_if<
+			!is_span<typename std::remove_cv<Container>::type>::value && !std::is_array<Container>::value &&
+			std::is_convertible<typename std::remove_pointer<decltype(std::declval<Container &>().data())>::type (*)[],
+								T (*)[]>::value &&
+			std::is_convertible<decltype(std::declval<Container &>().size()), size_t>::value>::type> : std::true_type {};
+
+	// span 类模板
+	template <class T, size_t Extent>
+	class span {
+	public:
+		// span 的嵌套型别定义
+		typedef T element_type;
+		typedef typename std::remove_cv<T>::type value_type;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+
+		typedef pointer iterator;
+		typedef wstl::reverse_iterator<iterator> reverse_iterator;
+
+		static constexpr size_type extent = Extent;
+
+	private:
+		span_storage<T, Extent> storage_;
+
+	public:
+		// 构造函数
+
+		template <size_t E = Extent, typename std::enable_if<E == 0 || E == dynamic_extent, int>::type = 0>
+		constexpr span() noexcept : storage_() {}
+
+		span(pointer ptr, size_type count) : storage_(ptr, count) {
+			WSTL_DEBUG(Extent == dynamic_extent || count == Extent);
+		}
+
+		template <class Pointer, typename std::enable_if<std::is_same<Pointer, pointer>::value, int>::type = 0>
+		span(Pointer first, Pointer last) : storage_(first, static_cast<size_type>(last - first)) {
+			WSTL_DEBUG(!(last < first));
+			WSTL_DEBUG(Extent == dynamic_extent || static_cast<size_type>(last - first) == Extent);
+		}
+
+		template <size_t N, typename std::enable_if<Extent == dynamic_extent || Extent == N, int>::type = 0>
+		constexpr span(element_type (&arr)[N]) noexcept : storage_(arr, N) {}
+
+		// 从连续容器构造，例如 wstl::vector、wstl::basic_string
+		template <class Container,
+				  typename std::enable_if<is_span_compatible_container<Container, T>::value, int>::type = 0>
+		span(Container &c) : storage_(c.data(), static_cast<size_type>(c.size())) {
+			WSTL_DEBUG(Extent == dynamic_extent || static_cast<size_type>(c.size()) == Extent);
+		}
+
+		template <class Container,
+				  typename std::enable_if<is_span_compatible_container<const Container, T>::value, int>::type = 0>
+		span(const Container &c) : storage_(c.data(), static_cast<size_type>(c.size())) {
+			WSTL_DEBUG(Extent == dynamic_extent || static_cast<size_type>(c.size()) == Extent);
+		}
+
+		// span<U, N> -> span<const U, N> / span<U, dynamic_extent> 等转换
+		template <class U, size_t N,
+				  typename std::enable_if<(Extent == dynamic_extent || N == dynamic_extent || Extent == N) &&
+											  std::is_convertible<U (*)[], T (*)[]>::value,
+										  int>::type = 0>
+		span(const span<U, N> &rhs) noexcept : storage_(rhs.data(), rhs.size()) {
+			WSTL_DEBUG(Extent == dynamic_extent || rhs.size() == Extent);
+		}
+
+		span(const span &rhs) noexcept = default;
+
+		span &operator=(const span &rhs) noexcept = default;
+
+	public:
+		// 迭代器相关操作
+
+		constexpr iterator begin() const noexcept {
+			return storage_.ptr;
+		}
+
+		constexpr iterator end() const noexcept {
+			return storage_.ptr + storage_.size();
+		}
+
+		reverse_iterator rbegin() const noexcept {
+			return reverse_iterator(end());
+		}
+
+		reverse_iterator rend() const noexcept {
+			return reverse_iterator(begin());
+		}
+
+		// 容量相关操作
+
+		constexpr size_type size() const noexcept {
+			return storage_.size();
+		}
+
+		constexpr size_type size_bytes() const noexcept {
+			return storage_.size() * sizeof(element_type);
+		}
+
+		constexpr bool empty() const noexcept {
+			return storage_.size() == 0;
+		}
+
+		// 访问元素相关操作
+
+		reference operator[](size_type n) const {
+			WSTL_DEBUG(n < size());
+			return storage_.ptr[n];
+		}
+
+		reference front() const {
+			WSTL_DEBUG(!empty());
+			return storage_.ptr[0];
+		}
+
+		reference back() const {
+			WSTL_DEBUG(!empty());
+			return storage_.ptr[size() - 1];
+		}
+
+		constexpr pointer data() const noexcept {
+			return storage_.ptr;
+		}
+
+		// 子视图
+
+		template <size_t Count>
+		span<element_type, Count> first() const {
+			static_assert(Extent == dynamic_extent || Count <= Extent, "span::first : count out of range");
+			WSTL_DEBUG(Count <= size());
+			return span<element_type, Count>(data(), Count);
+		}
+
+		span<element_type, dynamic_extent> first(size_type count) const {
+			WSTL_DEBUG(count <= size());
+			return span<element_type, dynamic_extent>(data(), count);
+		}
+
+		template <size_t Count>
+		span<element_type, Count> last() const {
+			static_assert(Extent == dynamic_extent || Count <= Extent, "span::last : count out of range");
+			WSTL_DEBUG(Count <= size());
+			return span<element_type, Count>(data() + (size() - Count), Count);
+		}
+
+		span<element_type, dynamic_extent> last(size_type count) const {
+			WSTL_DEBUG(count <= size());
+			return span<element_type, dynamic_extent>(data() + (size() - count), count);
+		}
+
+		template <size_t Offset, size_t Count = dynamic_extent>
+		span<element_type, (Count != dynamic_extent ? Count : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent))>
+		subspan() const {
+			static_assert(Extent == dynamic_extent || (Offset <= Extent && (Count == dynamic_extent || Count <= Extent - Offset)),
+						  "span::subspan : out of range");
+			WSTL_DEBUG(Offset <= size() && (Count == dynamic_extent || Count <= size() - Offset));
+			typedef span<element_type, (Count != dynamic_extent ? Count : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent))>
+				result_type;
+			return result_type(data() + Offset, Count == dynamic_extent ? size() - Offset : Count);
+		}
+
+		span<element_type, dynamic_extent> subspan(size_type offset, size_type count = dynamic_extent) const {
+			WSTL_DEBUG(offset <= size() && (count == dynamic_extent || count <= size() - offset));
+			return span<element_type, dynamic_extent>(data() + offset, count == dynamic_extent ? size() - offset : count);
+		}
+	};
+
+	template <class T, size_t Extent>
+	constexpr typename span<T, Extent>::size_type span<T, Extent>::extent;
+
+	// as_bytes / as_writable_bytes, 以字节视图访问对象表示
+
+	template <class T, size_t Extent>
+	span<const unsigned char, (Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T))> as_bytes(span<T, Extent> s) noexcept {
+		typedef span<const unsigned char, (Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T))> result_type;
+		return result_type(reinterpret_cast<const unsigned char *>(s.data()), s.size_bytes());
+	}
+
+	template <class T, size_t Extent, typename std::enable_if<!std::is_const<T>::value, int>::type = 0>
+	span<unsigned char, (Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T))> as_writable_bytes(span<T, Extent> s) noexcept {
+		typedef span<unsigned char, (Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T))> result_type;
+		return result_type(reinterpret_cast<unsigned char *>(s.data()), s.size_bytes());
+	}
+
+	// make_span, C++11 没有类模板实参推导，用函数模板代替
+
+	template <class T>
+	span<T> make_span(T *ptr, size_t count) {
+		return span<T>(ptr, count);
+	}
+
+	template <class T, size_t N>
+	span<T, N> make_span(T (&arr)[N]) noexcept {
+		return span<T, N>(arr);
+	}
+
+	template <class Container>
+	auto make_span(Container &c) -> span<typename std::remove_pointer<decltype(c.data())>::type> {
+		return span<typename std::remove_pointer<decltype(c.data())>::type>(c);
+	}
+
+	template <class Container>
+	auto make_span(const Container &c) -> span<typename std::remove_pointer<decltype(c.data())>::type> {
+		return span<typename std::remove_pointer<decltype(c.data())>::type>(c);
+	}
+} // namespace wstl
+
+#endif // WSTL_SPAN_H
@@ -0,0 +1,221 @@
+#ifndef WSTL_STATS_H
+#define WSTL_STATS_H
+
+/*
+	该文件实现内存分配与容器行为的统计计数
+
+	alloc_stats：
+		一组分配计数器：分配 / 释放次数、累计字节、存活字节、峰值字节，以及按大小分桶（2 的幂）的直方图，由 stats_allocator 更新。
+		每个标签类型对应一组计数器，标签用 WSTL_ALLOC_TAG(name) 定义，可以按调用点区分内存的去向。
+		计数器在第一次使用时登记到全局链表，for_each_alloc_stats 遍历所有已登记的计数器，便于定期导出到监控系统。
+
+	vector_stats：
+		vector 重新分配存储的次数，以及因此搬移的字节数（reserve、shrink_to_fit 与插入时扩容）。
+		只有定义了 WSTL_ENABLE_STATS 时 vector 才会更新这些计数，否则 WSTL_STATS_VECTOR_REALLOC 展开为空，没有任何开销。
+		WSTL_ENABLE_STATS 必须在所有翻译单元中保持一致（CMake 选项 WSTL_ENABLE_STATS 会为 wstl 目标统一定义）。
+
+	计数器全部使用 relaxed 原子操作，快照中的各个字段分别读取，彼此之间不保证一致。
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "sync.h"
+
+namespace wstl {
+
+	constexpr size_t alloc_histogram_buckets = 32;
+
+	// alloc_histogram_bucket, 第 i 个桶统计大小在 [2^i, 2^(i+1)) 字节的分配，最后一个桶包含所有更大的分配
+	inline size_t alloc_histogram_bucket(size_t bytes) noexcept {
+		if (bytes == 0) {
+			return 0;
+		}
+#if defined(__GNUC__) || defined(__clang__)
+		const auto log2 = static_cast<size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(bytes)));
+#else
+		size_t log2 = 0;
+		while (bytes >>= 1) {
+			++log2;
+		}
+#endif
+		return log2 < alloc_histogram_buckets ? log2 : alloc_histogram_buckets - 1;
+	}
+
+	// alloc_stats_snapshot, 某一时刻的计数
+	struct alloc_stats_snapshot {
+		const char *name;
+		uint64_t allocations;
+		uint64_t deallocations;
+		uint64_t bytes_allocated; // 累计分配的字节数
+		uint64_t bytes_freed;     // 累计释放的字节数
+		uint64_t live_bytes;      // 当前仍未释放的字节数
+		uint64_t peak_bytes;      // live_bytes 的最大值
+		uint64_t histogram[alloc_histogram_buckets];
+	};
+
+	// alloc_stats, 一组分配计数器，构造时登记到全局链表，不可复制
+	class alignas(cache_line_size) alloc_stats {
+	public:
+		explicit alloc_stats(const char *name) noexcept
+			: name_(name), allocations_(0), deallocations_(0), bytes_allocated_(0), bytes_freed_(0), live_bytes_(0),
+			  peak_bytes_(0), next_(nullptr) {
+			for (auto &bucket : histogram_) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+			auto &head = registry();
+			auto old_head = head.load(std::memory_order_relaxed);
+			do {
+				next_ = old_head;
+			} while (!head.compare_exchange_weak(old_head, this, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		alloc_stats(const alloc_stats &) = delete;
+		alloc_stats &operator=(const alloc_stats &) = delete;
+
+		const char *name() const noexcept {
+			return name_;
+		}
+
+		void record_allocate(size_t bytes) noexcept {
+			allocations_.fetch_add(1, std::memory_order_relaxed);
+			bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+			histogram_[alloc_histogram_bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+			const auto live = live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			auto peak = peak_bytes_.load(std::memory_order_relaxed);
+			while (peak < live && !peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+			}
+		}
+
+		void record_deallocate(size_t bytes) noexcept {
+			deallocations_.fetch_add(1, std::memory_order_relaxed);
+			bytes_freed_.fetch_add(bytes, std::memory_order_relaxed);
+			live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+		}
+
+		alloc_stats_snapshot snapshot() const noexcept {
+			alloc_stats_snapshot result;
+			result.name = name_;
+			result.allocations = allocations_.load(std::memory_order_relaxed);
+			result.deallocations = deallocations_.load(std::memory_order_relaxed);
+			result.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+			result.bytes_freed = bytes_freed_.load(std::memory_order_relaxed);
+			result.live_bytes = live_bytes_.load(std::memory_order_relaxed);
+			result.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+			for (size_t i = 0; i < alloc_histogram_buckets; ++i) {
+				result.histogram[i] = histogram_[i].load(std::memory_order_relaxed);
+			}
+			return result;
+		}
+
+		// reset, 清零累计计数与直方图，峰值从当前的存活字节数重新开始，存活字节数保持不变
+		void reset() noexcept {
+			allocations_.store(0, std::memory_order_relaxed);
+			deallocations_.store(0, std::memory_order_relaxed);
+			bytes_allocated_.store(0, std::memory_order_relaxed);
+			bytes_freed_.store(0, std::memory_order_relaxed);
+			peak_bytes_.store(live_bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			for (auto &bucket : histogram_) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		// 遍历已登记的计数器
+		static alloc_stats *head() noexcept {
+			return registry().load(std::memory_order_acquire);
+		}
+
+		alloc_stats *next() const noexcept {
+			return next_;
+		}
+
+	private:
+		static std::atomic<alloc_stats *> &registry() noexcept {
+			static std::atomic<alloc_stats *> head(nullptr);
+			return head;
+		}
+
+	private:
+		const char *name_;
+		std::atomic<uint64_t> allocations_;
+		std::atomic<uint64_t> deallocations_;
+		std::atomic<uint64_t> bytes_allocated_;
+		std::atomic<uint64_t> bytes_freed_;
+		std::atomic<uint64_t> live_bytes_;
+		std::atomic<uint64_t> peak_bytes_;
+		std::atomic<uint64_t> histogram_[alloc_histogram_buckets];
+		alloc_stats *next_;
+	};
+
+	// 标签类型：提供静态成员函数 name()，每个标签对应一组独立的 alloc_stats
+#define WSTL_ALLOC_TAG(tag)                       \
+	struct tag {                                  \
+		static const char *name() noexcept {      \
+			return #tag;                          \
+		}                                         \
+	}
+
+	WSTL_ALLOC_TAG(default_alloc_tag);
+
+	// alloc_stats_for, 标签 Tag 对应的计数器
+	template <class Tag>
+	alloc_stats &alloc_stats_for() noexcept {
+		static alloc_stats stats(Tag::name());
+		return stats;
+	}
+
+	// for_each_alloc_stats, 对每个已登记的计数器调用 f(const alloc_stats_snapshot &)
+	template <class Function>
+	void for_each_alloc_stats(Function f) {
+		for (auto p = alloc_stats::head(); p != nullptr; p = p->next()) {
+			f(p->snapshot());
+		}
+	}
+
+	// vector_stats_snapshot
+	struct vector_stats_snapshot {
+		uint64_t reallocations;
+		uint64_t bytes_moved;
+	};
+
+	// vector_stats, 所有 vector 共享的重新分配计数
+	class vector_stats {
+	public:
+		static void record_reallocate(size_t bytes_moved) noexcept {
+			counters().reallocations.fetch_add(1, std::memory_order_relaxed);
+			counters().bytes_moved.fetch_add(bytes_moved, std::memory_order_relaxed);
+		}
+
+		static vector_stats_snapshot snapshot() noexcept {
+			vector_stats_snapshot result;
+			result.reallocations = counters().reallocations.load(std::memory_order_relaxed);
+			result.bytes_moved = counters().bytes_moved.load(std::memory_order_relaxed);
+			return result;
+		}
+
+		static void reset() noexcept {
+			counters().reallocations.store(0, std::memory_order_relaxed);
+			counters().bytes_moved.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		struct alignas(cache_line_size) counter_block {
+			std::atomic<uint64_t> reallocations;
+			std::atomic<uint64_t> bytes_moved;
+		};
+
+		static counter_block &counters() noexcept {
+			static counter_block block{{0}, {0}};
+			return block;
+		}
+	};
+
+#ifdef WSTL_ENABLE_STATS
+#define WSTL_STATS_VECTOR_REALLOC(bytes_moved) ::wstl::vector_stats::record_reallocate(bytes_moved)
+#elif !defined(WSTL_STATS_VECTOR_REALLOC)
+#define WSTL_STATS_VECTOR_REALLOC(bytes_moved) ((void)0)
+#endif
+} // namespace wstl
+
+#endif // WSTL_STATS_H
@@ -0,0 +1,143 @@
+#ifndef WSTL_STATS_ALLOCATOR_H
+#define WSTL_STATS_ALLOCATOR_H
+
+/*
+	该文件实现统计分配器 stats_allocator<T, Tag, Alloc>
+
+	stats_allocator 把分配与释放转交给 Alloc（默认 wstl::allocator<T>），同时更新标签 Tag 对应的 alloc_stats，
+	接口与 wstl::allocator 相同，可以直接作为容器的 Alloc 参数：
+
+		WSTL_ALLOC_TAG(index_tag);
+		wstl::vector<int, wstl::stats_allocator<int, index_tag>> index;
+		auto s = wstl::stats_allocator<int, index_tag>::snapshot();
+
+	同一个标签可以用于不同的元素类型，计数合并在一起。计数器的实现与导出见 stats.h。
+*/
+
+#include "allocator.h"
+#include "stats.h"
+#include "util.h"
+
+namespace wstl {
+
+	// 模版类 stats_allocator
+	template <class T, class Tag = default_alloc_tag, class Alloc = wstl::allocator<T>>
+	class stats_allocator {
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef Tag tag_type;
+		typedef Alloc inner_allocator_type;
+
+		// rebind, 标签不变，计数仍合并在一起
+		template <class U>
+		struct rebind {
+			typedef stats_allocator<U, Tag, typename Alloc::template rebind<U>::other> other;
+		};
+
+	public:
+		static T *allocate();
+		static T *allocate(size_type n);
+
+		static void deallocate(T *ptr);
+		static void deallocate(T *ptr, size_type n);
+
+		static void construct(T *ptr);
+		static void construct(T *ptr, const T &value);
+		static void construct(T *ptr, T &&value);
+
+		template <class... Args>
+		static void construct(T *ptr, Args &&...args);
+
+		static void destroy(T *ptr);
+		static void destroy(T *first, T *last);
+
+		// 标签 Tag 的计数器
+		static alloc_stats &stats() noexcept {
+			return alloc_stats_for<Tag>();
+		}
+
+		static alloc_stats_snapshot snapshot() noexcept {
+			return stats().snapshot();
+		}
+	};
+
+	// allocate 分配内存
+
+	template <class T, class Tag, class Alloc>
+	T *stats_allocator<T, Tag, Alloc>::allocate() {
+		auto ptr = Alloc::allocate();
+		stats().record_allocate(sizeof(T));
+		return ptr;
+	}
+
+	template <class T, class Tag, class Alloc>
+	T *stats_allocator<T, Tag, Alloc>::allocate(size_type n) {
+		auto ptr = Alloc::allocate(n);
+		if (ptr != nullptr) {
+			stats().record_allocate(n * sizeof(T));
+		}
+		return ptr;
+	}
+
+	// deallocate 释放内存
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::deallocate(T *ptr) {
+		if (ptr != nullptr) {
+			stats().record_deallocate(sizeof(T));
+			Alloc::deallocate(ptr);
+		}
+	}
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::deallocate(T *ptr, size_type n) {
+		if (ptr != nullptr) {
+			stats().record_deallocate(n * sizeof(T));
+			Alloc::deallocate(ptr, n);
+		}
+	}
+
+	// construct 构造对象
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::construct(T *ptr) {
+		Alloc::construct(ptr);
+	}
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::construct(T *ptr, const T &value) {
+		Alloc::construct(ptr, value);
+	}
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::construct(T *ptr, T &&value) {
+		Alloc::construct(ptr, wstl::move(value));
+	}
+
+	template <class T, class Tag, class Alloc>
+	template <class... Args>
+	void stats_allocator<T, Tag, Alloc>::construct(T *ptr, Args &&...args) {
+		Alloc::construct(ptr, wstl::forward<Args>(args)...);
+	}
+
+	// destroy 析构对象
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::destroy(T *ptr) {
+		Alloc::destroy(ptr);
+	}
+
+	template <class T, class Tag, class Alloc>
+	void stats_allocator<T, Tag, Alloc>::destroy(T *first, T *last) {
+		Alloc::destroy(first, last);
+	}
+} // namespace wstl
+
+#endif // WSTL_STATS_ALLOCATOR_H
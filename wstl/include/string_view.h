@@ -0,0 +1,695 @@
+#ifndef WSTL_STRING_VIEW_H
+#define WSTL_STRING_VIEW_H
+
+/*
+	该文件实现 basic_string_view 类模板以及 string_view、wstring_view、u16string_view、u32string_view
+
+	basic_string_view 只保存 {指针, 长度}，不拥有字符，substr / remove_prefix / remove_suffix 不分配内存，
+	可以直接切分 wstl::basic_string、字符串字面量或接收到的原始缓冲区。视图不延长被引用字符的生命周期。
+
+	查找算法（string_search）也定义在这里，basic_string 的查找函数转发给 basic_string_view：
+		Traits 为 std::char_traits<char> 时，find 使用 SSE2 每次检查 16 个起始位置（先比较首尾字符，命中后再比较中间部分），
+		rfind 单个字符使用 SSE2 从尾部向前扫描；其他情况逐字符调用 Traits。
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define WSTL_STRING_SSE2 1
+#endif
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+
+namespace wstl {
+
+	/*****************************************************************************************/
+	// 									字符串查找
+	/*****************************************************************************************/
+
+	// string_search, 按 Traits 逐字符比较的通用版本，返回匹配位置或 nullptr
+	template <class CharT, class Traits>
+	struct string_search {
+		static const CharT *find_char(const CharT *s, size_t n, CharT ch) noexcept {
+			return Traits::find(s, n, ch);
+		}
+
+		static const CharT *rfind_char(const CharT *s, size_t n, CharT ch) noexcept {
+			while (n != 0) {
+				if (Traits::eq(s[--n], ch)) {
+					return s + n;
+				}
+			}
+			return nullptr;
+		}
+
+		// 在 [s, s + n) 中查找 [pattern, pattern + m)，要求 0 < m <= n
+		static const CharT *find(const CharT *s, size_t n, const CharT *pattern, size_t m) noexcept {
+			const auto last = s + (n - m) + 1;
+			for (auto p = s; p != last; ++p) {
+				p = Traits::find(p, static_cast<size_t>(last - p), pattern[0]);
+				if (p == nullptr) {
+					return nullptr;
+				}
+				if (Traits::compare(p + 1, pattern + 1, m - 1) == 0) {
+					return p;
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	// char 的特化版本：单字符查找使用 memchr，子串查找与反向查找使用 SSE2
+	template <>
+	struct string_search<char, std::char_traits<char>> {
+		static const char *find_char(const char *s, size_t n, char ch) noexcept {
+			return n == 0 ? nullptr : static_cast<const char *>(std::memchr(s, ch, n));
+		}
+
+		static const char *rfind_char(const char *s, size_t n, char ch) noexcept {
+#ifdef WSTL_STRING_SSE2
+			const auto target = _mm_set1_epi8(ch);
+			while (n >= 16) {
+				n -= 16;
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + n));
+				const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+				if (mask != 0) {
+					return s + n + (31 - __builtin_clz(mask));
+				}
+			}
+#endif
+			while (n != 0) {
+				if (s[--n] == ch) {
+					return s + n;
+				}
+			}
+			return nullptr;
+		}
+
+		static const char *find(const char *s, size_t n, const char *pattern, size_t m) noexcept {
+			if (m == 1) {
+				return find_char(s, n, pattern[0]);
+			}
+			size_t i = 0;
+#ifdef WSTL_STRING_SSE2
+			// 每轮检查起始位置 [i, i + 16)：首字符与 pattern[0] 相等且尾字符与 pattern[m - 1] 相等的位置才需要完整比较
+			const auto first = _mm_set1_epi8(pattern[0]);
+			const auto last = _mm_set1_epi8(pattern[m - 1]);
+			for (; i + m + 15 <= n; i += 16) {
+				const auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+				const auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+				const auto eq = _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last));
+				auto mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+				while (mask != 0) {
+					const auto bit = static_cast<size_t>(__builtin_ctz(mask));
+					if (std::memcmp(s + i + bit + 1, pattern + 1, m - 2) == 0) {
+						return s + i + bit;
+					}
+					mask &= mask - 1;
+				}
+			}
+#endif
+			for (; i + m <= n; ++i) {
+				auto p = find_char(s + i, n - m + 1 - i, pattern[0]);
+				if (p == nullptr) {
+					return nullptr;
+				}
+				i = static_cast<size_t>(p - s);
+				if (std::memcmp(p + 1, pattern + 1, m - 1) == 0) {
+					return p;
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	/*****************************************************************************************/
+	// 									basic_string_view
+	/*****************************************************************************************/
+
+	// basic_string_view 类模板
+	template <class CharT, class Traits = std::char_traits<CharT>>
+	class basic_string_view {
+		static_assert(std::is_same<CharT, typename Traits::char_type>::value, "Traits::char_type must be CharT");
+
+	public:
+		// basic_string_view 的嵌套型别定义
+		typedef Traits traits_type;
+		typedef CharT value_type;
+		typedef CharT *pointer;
+		typedef const CharT *const_pointer;
+		typedef CharT &reference;
+		typedef const CharT &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		typedef const_pointer iterator;
+		typedef const_pointer const_iterator;
+		typedef wstl::reverse_iterator<const_iterator> reverse_iterator;
+		typedef wstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+	private:
+		const_pointer data_;
+		size_type size_;
+
+	public:
+		// 构造函数
+
+		constexpr basic_string_view() noexcept : data_(nullptr), size_(0) {}
+
+		constexpr basic_string_view(const_pointer s, size_type n) noexcept : data_(s), size_(n) {}
+
+		basic_string_view(const_pointer s) : data_(s), size_(traits_type::length(s)) {}
+
+		constexpr basic_string_view(const basic_string_view &rhs) noexcept = default;
+
+		basic_string_view &operator=(const basic_string_view &rhs) noexcept = default;
+
+	public:
+		// 迭代器相关操作
+
+		constexpr const_iterator begin() const noexcept {
+			return data_;
+		}
+
+		constexpr const_iterator end() const noexcept {
+			return data_ + size_;
+		}
+
+		constexpr const_iterator cbegin() const noexcept {
+			return data_;
+		}
+
+		constexpr const_iterator cend() const noexcept {
+			return data_ + size_;
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		const_reverse_iterator crbegin() const noexcept {
+			return rbegin();
+		}
+
+		const_reverse_iterator crend() const noexcept {
+			return rend();
+		}
+
+		// 容量相关操作
+
+		constexpr size_type size() const noexcept {
+			return size_;
+		}
+
+		constexpr size_type length() const noexcept {
+			return size_;
+		}
+
+		constexpr size_type max_size() const noexcept {
+			return static_cast<size_type>(-1) / sizeof(value_type);
+		}
+
+		constexpr bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		// 访问元素相关操作
+
+		const_reference operator[](size_type n) const {
+			WSTL_DEBUG(n < size_);
+			return data_[n];
+		}
+
+		const_reference at(size_type n) const {
+			THROW_OUT_OF_RANGE_IF(n >= size_, "basic_string_view : out of range");
+			return data_[n];
+		}
+
+		const_reference front() const {
+			WSTL_DEBUG(!empty());
+			return data_[0];
+		}
+
+		const_reference back() const {
+			WSTL_DEBUG(!empty());
+			return data_[size_ - 1];
+		}
+
+		constexpr const_pointer data() const noexcept {
+			return data_;
+		}
+
+		// 修改视图相关操作
+
+		void remove_prefix(size_type n) {
+			WSTL_DEBUG(n <= size_);
+			data_ += n;
+			size_ -= n;
+		}
+
+		void remove_suffix(size_type n) {
+			WSTL_DEBUG(n <= size_);
+			size_ -= n;
+		}
+
+		void swap(basic_string_view &rhs) noexcept {
+			wstl::swap(data_, rhs.data_);
+			wstl::swap(size_, rhs.size_);
+		}
+
+		// 其他操作
+
+		size_type copy(pointer dest, size_type n, size_type pos = 0) const {
+			THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view : out of range");
+			n = wstl::min(n, size_ - pos);
+			traits_type::copy(dest, data_ + pos, n);
+			return n;
+		}
+
+		basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+			THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view : out of range");
+			return basic_string_view(data_ + pos, wstl::min(n, size_ - pos));
+		}
+
+		// 比较相关操作
+
+		int compare(basic_string_view sv) const noexcept {
+			const auto result = traits_type::compare(data_, sv.data_, wstl::min(size_, sv.size_));
+			if (result != 0) {
+				return result;
+			}
+			return size_ < sv.size_ ? -1 : (size_ > sv.size_ ? 1 : 0);
+		}
+
+		int compare(size_type pos1, size_type n1, basic_string_view sv) const {
+			return substr(pos1, n1).compare(sv);
+		}
+
+		int compare(size_type pos1, size_type n1, basic_string_view sv, size_type pos2, size_type n2) const {
+			return substr(pos1, n1).compare(sv.substr(pos2, n2));
+		}
+
+		int compare(const_pointer s) const {
+			return compare(basic_string_view(s));
+		}
+
+		int compare(size_type pos1, size_type n1, const_pointer s) const {
+			return substr(pos1, n1).compare(basic_string_view(s));
+		}
+
+		int compare(size_type pos1, size_type n1, const_pointer s, size_type n2) const {
+			return substr(pos1, n1).compare(basic_string_view(s, n2));
+		}
+
+		bool starts_with(basic_string_view sv) const noexcept {
+			return size_ >= sv.size_ && traits_type::compare(data_, sv.data_, sv.size_) == 0;
+		}
+
+		bool starts_with(value_type ch) const noexcept {
+			return !empty() && traits_type::eq(front(), ch);
+		}
+
+		bool starts_with(const_pointer s) const {
+			return starts_with(basic_string_view(s));
+		}
+
+		bool ends_with(basic_string_view sv) const noexcept {
+			return size_ >= sv.size_ && traits_type::compare(data_ + size_ - sv.size_, sv.data_, sv.size_) == 0;
+		}
+
+		bool ends_with(value_type ch) const noexcept {
+			return !empty() && traits_type::eq(back(), ch);
+		}
+
+		bool ends_with(const_pointer s) const {
+			return ends_with(basic_string_view(s));
+		}
+
+		bool contains(basic_string_view sv) const noexcept {
+			return find(sv) != npos;
+		}
+
+		bool contains(value_type ch) const noexcept {
+			return find(ch) != npos;
+		}
+
+		bool contains(const_pointer s) const {
+			return find(s) != npos;
+		}
+
+		// 查找相关操作
+
+		size_type find(const_pointer s, size_type pos, size_type n) const noexcept;
+
+		size_type find(basic_string_view sv, size_type pos = 0) const noexcept {
+			return find(sv.data_, pos, sv.size_);
+		}
+
+		size_type find(const_pointer s, size_type pos = 0) const {
+			return find(s, pos, traits_type::length(s));
+		}
+
+		size_type find(value_type ch, size_type pos = 0) const noexcept;
+
+		size_type rfind(const_pointer s, size_type pos, size_type n) const noexcept;
+
+		size_type rfind(basic_string_view sv, size_type pos = npos) const noexcept {
+			return rfind(sv.data_, pos, sv.size_);
+		}
+
+		size_type rfind(const_pointer s, size_type pos = npos) const {
+			return rfind(s, pos, traits_type::length(s));
+		}
+
+		size_type rfind(value_type ch, size_type pos = npos) const noexcept;
+
+		size_type find_first_of(const_pointer s, size_type pos, size_type n) const noexcept;
+
+		size_type find_first_of(basic_string_view sv, size_type pos = 0) const noexcept {
+			return find_first_of(sv.data_, pos, sv.size_);
+		}
+
+		size_type find_first_of(const_pointer s, size_type pos = 0) const {
+			return find_first_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_first_of(value_type ch, size_type pos = 0) const noexcept {
+			return find(ch, pos);
+		}
+
+		size_type find_last_of(const_pointer s, size_type pos, size_type n) const noexcept;
+
+		size_type find_last_of(basic_string_view sv, size_type pos = npos) const noexcept {
+			return find_last_of(sv.data_, pos, sv.size_);
+		}
+
+		size_type find_last_of(const_pointer s, size_type pos = npos) const {
+			return find_last_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_last_of(value_type ch, size_type pos = npos) const noexcept {
+			return rfind(ch, pos);
+		}
+
+		size_type find_first_not_of(const_pointer s, size_type pos, size_type n) const noexcept;
+
+		size_type find_first_not_of(basic_string_view sv, size_type pos = 0) const noexcept {
+			return find_first_not_of(sv.data_, pos, sv.size_);
+		}
+
+		size_type find_first_not_of(const_pointer s, size_type pos = 0) const {
+			return find_first_not_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_first_not_of(value_type ch, size_type pos = 0) const noexcept {
+			return find_first_not_of(&ch, pos, 1);
+		}
+
+		size_type find_last_not_of(const_pointer s, size_type pos, size_type n) const noexcept;
+
+		size_type find_last_not_of(basic_string_view sv, size_type pos = npos) const noexcept {
+			return find_last_not_of(sv.data_, pos, sv.size_);
+		}
+
+		size_type find_last_not_of(const_pointer s, size_type pos = npos) const {
+			return find_last_not_of(s, pos, traits_type::length(s));
+		}
+
+		size_type find_last_not_of(value_type ch, size_type pos = npos) const noexcept {
+			return find_last_not_of(&ch, pos, 1);
+		}
+	};
+
+	template <class CharT, class Traits>
+	constexpr typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
+
+	/******************************************************************************************************/
+
+	// find, 查找子串
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::find(const_pointer s, size_type pos, size_type n) const noexcept {
+		if (n == 0) {
+			return pos <= size_ ? pos : npos;
+		}
+		if (pos >= size_ || n > size_ - pos) {
+			return npos;
+		}
+		const auto result = string_search<CharT, Traits>::find(data_ + pos, size_ - pos, s, n);
+		return result == nullptr ? npos : static_cast<size_type>(result - data_);
+	}
+
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::find(value_type ch, size_type pos) const noexcept {
+		if (pos >= size_) {
+			return npos;
+		}
+		const auto result = string_search<CharT, Traits>::find_char(data_ + pos, size_ - pos, ch);
+		return result == nullptr ? npos : static_cast<size_type>(result - data_);
+	}
+
+	// rfind, 查找起始位置不大于 pos 的最后一个子串
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::rfind(const_pointer s, size_type pos, size_type n) const noexcept {
+		if (n > size_) {
+			return npos;
+		}
+		pos = wstl::min(pos, size_ - n);
+		if (n == 0) {
+			return pos;
+		}
+		for (;;) {
+			const auto hit = string_search<CharT, Traits>::rfind_char(data_, pos + 1, s[0]);
+			if (hit == nullptr) {
+				return npos;
+			}
+			pos = static_cast<size_type>(hit - data_);
+			if (traits_type::compare(hit + 1, s + 1, n - 1) == 0) {
+				return pos;
+			}
+			if (pos == 0) {
+				return npos;
+			}
+			--pos;
+		}
+	}
+
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::rfind(value_type ch, size_type pos) const noexcept {
+		if (size_ == 0) {
+			return npos;
+		}
+		const auto result = string_search<CharT, Traits>::rfind_char(data_, wstl::min(pos, size_ - 1) + 1, ch);
+		return result == nullptr ? npos : static_cast<size_type>(result - data_);
+	}
+
+	// find_first_of / find_last_of / find_first_not_of / find_last_not_of
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::find_first_of(const_pointer s, size_type pos, size_type n) const noexcept {
+		for (; n != 0 && pos < size_; ++pos) {
+			if (traits_type::find(s, n, data_[pos]) != nullptr) {
+				return pos;
+			}
+		}
+		return npos;
+	}
+
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::find_last_of(const_pointer s, size_type pos, size_type n) const noexcept {
+		if (size_ == 0 || n == 0) {
+			return npos;
+		}
+		for (auto i = wstl::min(pos, size_ - 1) + 1; i != 0;) {
+			if (traits_type::find(s, n, data_[--i]) != nullptr) {
+				return i;
+			}
+		}
+		return npos;
+	}
+
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::find_first_not_of(const_pointer s, size_type pos, size_type n) const noexcept {
+		for (; pos < size_; ++pos) {
+			if (traits_type::find(s, n, data_[pos]) == nullptr) {
+				return pos;
+			}
+		}
+		return npos;
+	}
+
+	template <class CharT, class Traits>
+	typename basic_string_view<CharT, Traits>::size_type
+	basic_string_view<CharT, Traits>::find_last_not_of(const_pointer s, size_type pos, size_type n) const noexcept {
+		if (size_ == 0) {
+			return npos;
+		}
+		for (auto i = wstl::min(pos, size_ - 1) + 1; i != 0;) {
+			if (traits_type::find(s, n, data_[--i]) == nullptr) {
+				return i;
+			}
+		}
+		return npos;
+	}
+
+	/******************************************************************************************************/
+	// 重载比较操作符
+	// 每个操作符有三个版本，另一侧只要能隐式转换为 basic_string_view（const CharT *、basic_string）即可参与比较
+
+	template <class T>
+	struct string_view_identity {
+		typedef T type;
+	};
+
+	template <class CharT, class Traits>
+	bool operator==(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator==(basic_string_view<CharT, Traits> lhs,
+					typename string_view_identity<basic_string_view<CharT, Traits>>::type rhs) noexcept {
+		return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator==(typename string_view_identity<basic_string_view<CharT, Traits>>::type lhs,
+					basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator!=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <class CharT, class Traits>
+	bool operator!=(basic_string_view<CharT, Traits> lhs,
+					typename string_view_identity<basic_string_view<CharT, Traits>>::type rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <class CharT, class Traits>
+	bool operator!=(typename string_view_identity<basic_string_view<CharT, Traits>>::type lhs,
+					basic_string_view<CharT, Traits> rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <class CharT, class Traits>
+	bool operator<(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) < 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator<(basic_string_view<CharT, Traits> lhs,
+				   typename string_view_identity<basic_string_view<CharT, Traits>>::type rhs) noexcept {
+		return lhs.compare(rhs) < 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator<(typename string_view_identity<basic_string_view<CharT, Traits>>::type lhs,
+				   basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) < 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator>(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) > 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator>(basic_string_view<CharT, Traits> lhs,
+				   typename string_view_identity<basic_string_view<CharT, Traits>>::type rhs) noexcept {
+		return lhs.compare(rhs) > 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator>(typename string_view_identity<basic_string_view<CharT, Traits>>::type lhs,
+				   basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) > 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator<=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) <= 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator<=(basic_string_view<CharT, Traits> lhs,
+					typename string_view_identity<basic_string_view<CharT, Traits>>::type rhs) noexcept {
+		return lhs.compare(rhs) <= 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator<=(typename string_view_identity<basic_string_view<CharT, Traits>>::type lhs,
+					basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) <= 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator>=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) >= 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator>=(basic_string_view<CharT, Traits> lhs,
+					typename string_view_identity<basic_string_view<CharT, Traits>>::type rhs) noexcept {
+		return lhs.compare(rhs) >= 0;
+	}
+
+	template <class CharT, class Traits>
+	bool operator>=(typename string_view_identity<basic_string_view<CharT, Traits>>::type lhs,
+					basic_string_view<CharT, Traits> rhs) noexcept {
+		return lhs.compare(rhs) >= 0;
+	}
+
+	// 输出到流
+	template <class CharT, class Traits>
+	std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, basic_string_view<CharT, Traits> sv) {
+		return os.write(sv.data(), static_cast<std::streamsize>(sv.size()));
+	}
+
+	// hash_bytes, FNV-1a，basic_string 与 basic_string_view 的哈希值相同
+	inline size_t hash_bytes(const void *data, size_t n) noexcept {
+		auto p = static_cast<const unsigned char *>(data);
+		uint64_t h = 14695981039346656037ULL;
+		for (size_t i = 0; i < n; ++i) {
+			h = (h ^ p[i]) * 1099511628211ULL;
+		}
+		return static_cast<size_t>(h);
+	}
+
+	typedef basic_string_view<char> string_view;
+	typedef basic_string_view<wchar_t> wstring_view;
+	typedef basic_string_view<char16_t> u16string_view;
+	typedef basic_string_view<char32_t> u32string_view;
+} // namespace wstl
+
+namespace std {
+	template <class CharT>
+	struct hash<wstl::basic_string_view<CharT, std::char_traits<CharT>>> {
+		size_t operator()(wstl::basic_string_view<CharT, std::char_traits<CharT>> sv) const noexcept {
+			return wstl::hash_bytes(sv.data(), sv.size() * sizeof(CharT));
+		}
+	};
+} // namespace std
+
+#endif // WSTL_STRING_VIEW_H
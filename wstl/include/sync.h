@@ -0,0 +1,134 @@
+#ifndef WSTL_SYNC_H
+#define WSTL_SYNC_H
+
+// 这个头文件包含并发容器共用的同步工具：cpu_relax、自旋退避、读写自旋锁以及缓存行相关常量
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace wstl {
+
+	// 缓存行大小，用于填充热点原子变量，避免伪共享
+	constexpr size_t cache_line_size = 64;
+
+	// cpu_relax, 自旋等待时提示 CPU 当前处于忙等状态
+	inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+	// spin_backoff, 指数退避：先自旋若干次，超过上限后让出时间片
+	class spin_backoff {
+	public:
+		static constexpr unsigned spin_limit = 64;
+
+		spin_backoff() noexcept : count_(1) {}
+
+		// 执行一次退避，返回 false 表示自旋阶段已结束（调用者可以考虑挂起）
+		bool pause() noexcept {
+			if (count_ <= spin_limit) {
+				for (unsigned i = 0; i < count_; ++i) {
+					cpu_relax();
+				}
+				count_ <<= 1;
+				return true;
+			}
+			std::this_thread::yield();
+			return false;
+		}
+
+		void reset() noexcept {
+			count_ = 1;
+		}
+
+	private:
+		unsigned count_;
+	};
+
+	// spin_rw_lock, 读写自旋锁，写者优先，占用一个 32 位字
+	// 读锁只有一次 fetch_add，适合临界区很短、读多写少的场景
+	class spin_rw_lock {
+	public:
+		spin_rw_lock() noexcept : state_(0) {}
+
+		spin_rw_lock(const spin_rw_lock &) = delete;
+		spin_rw_lock &operator=(const spin_rw_lock &) = delete;
+
+		void lock() noexcept {
+			spin_backoff backoff;
+			for (;;) {
+				auto s = state_.load(std::memory_order_relaxed);
+				if ((s & ~writer_pending) == 0) {
+					if (state_.compare_exchange_weak(s, writer, std::memory_order_acquire, std::memory_order_relaxed)) {
+						return;
+					}
+				} else if ((s & writer_pending) == 0) {
+					state_.fetch_or(writer_pending, std::memory_order_relaxed);
+				}
+				backoff.pause();
+			}
+		}
+
+		void unlock() noexcept {
+			state_.fetch_sub(writer, std::memory_order_release);
+		}
+
+		void lock_shared() noexcept {
+			spin_backoff backoff;
+			for (;;) {
+				if ((state_.load(std::memory_order_relaxed) & (writer | writer_pending)) == 0) {
+					const auto s = state_.fetch_add(reader, std::memory_order_acquire);
+					if ((s & writer) == 0) {
+						return;
+					}
+					state_.fetch_sub(reader, std::memory_order_relaxed);
+				}
+				backoff.pause();
+			}
+		}
+
+		void unlock_shared() noexcept {
+			state_.fetch_sub(reader, std::memory_order_release);
+		}
+
+	private:
+		static constexpr unsigned writer = 1;
+		static constexpr unsigned writer_pending = 2;
+		static constexpr unsigned reader = 4;
+
+		std::atomic<unsigned> state_;
+	};
+
+	// 读锁 RAII 守卫，写锁直接使用 std::lock_guard
+	template <class SharedLock>
+	class shared_lock_guard {
+	public:
+		explicit shared_lock_guard(SharedLock &lock) noexcept : lock_(lock) {
+			lock_.lock_shared();
+		}
+
+		shared_lock_guard(const shared_lock_guard &) = delete;
+		shared_lock_guard &operator=(const shared_lock_guard &) = delete;
+
+		~shared_lock_guard() {
+			lock_.unlock_shared();
+		}
+
+	private:
+		SharedLock &lock_;
+	};
+}
+
+#endif // WSTL_SYNC_H
@@ -53,6 +53,24 @@ namespace wstl {
 	template <typename T1, typename T2>
 	struct is_pair<wstl::pair<T1, T2>> : wstl::w_true_type {
 	};
+
+	// index_sequence, 编译期下标序列，用于按下标展开参数包（C++11 中没有 std::index_sequence）
+
+	template <size_t... Is>
+	struct index_sequence {
+	};
+
+	template <size_t N, size_t... Is>
+	struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, Is...> {
+	};
+
+	template <size_t... Is>
+	struct make_index_sequence_impl<0, Is...> {
+		typedef index_sequence<Is...> type;
+	};
+
+	template <size_t N>
+	using make_index_sequence = typename make_index_sequence_impl<N>::type;
 }
 
 #endif // WSTL_TYPE_TRAITS_H
\ No newline at end of file
@@ -9,9 +9,25 @@
 		emplace，emplace_back，push_back
 	当 std::is_nothrow_move_constructible<T>::value 为 true 时，以下函数提供强异常安全保证：
 		insert，resize，reserve
+
+	并行初始化：
+	vector(n, value, parallel_init) 由多个线程分段构造元素，段的边界按元素的实际地址向上取整到系统页面边界
+	（sysconf(_SC_PAGESIZE)，Windows 下取 4 KiB），分配器无需返回页对齐的地址。
+	大数组的页面在第一次写入时才分配物理内存（first-touch），因此各段落在初始化它的线程所在的 NUMA 节点上，
+	之后由同样划分的线程读写时不必跨节点访问。配合 numa_allocator<T, numa_policy::local> 使用效果最稳定。
+
+	统计：
+	定义 WSTL_ENABLE_STATS 时，每次重新分配存储都会计入 vector_stats（次数与搬移的字节数），见 stats.h。
 */
 
+#include <cstdint>
+#include <exception>
 #include <initializer_list>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
 
 #include "algo.h"
 #include "allocator.h"
@@ -20,6 +36,12 @@
 #include "memory.h"
 #include "util.h"
 
+#ifdef WSTL_ENABLE_STATS
+#include "stats.h"
+#elif !defined(WSTL_STATS_VECTOR_REALLOC)
+#define WSTL_STATS_VECTOR_REALLOC(bytes_moved) ((void)0)
+#endif
+
 namespace wstl {
 
 #ifdef max
@@ -32,6 +54,21 @@ namespace wstl {
 #undef min
 #endif
 
+	// parallel_init_t, 选择并行 first-touch 初始化的标签
+	struct parallel_init_t {};
+
+	constexpr parallel_init_t parallel_init{};
+
+	// vector_page_size, 系统页面大小，用于划分并行初始化的段
+	inline size_t vector_page_size() noexcept {
+#if !defined(_WIN32)
+		static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+		return page;
+#else
+		return 4096; // Windows 在 x86 / x64 / ARM64 上的页面均为 4 KiB
+#endif
+	}
+
 	// vector 类模板
 	template <class T, class Alloc = wstl::allocator<T>>
 	class vector {
@@ -79,18 +116,23 @@ namespace wstl {
 			fill_init(n, value);
 		}
 
+		// threads 为 0 时使用 std::thread::hardware_concurrency() 个线程（含调用线程）
+		vector(size_type n, const value_type &value, parallel_init_t, size_type threads = 0) {
+			parallel_fill_init(n, value, threads);
+		}
+
 		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
 		vector(InputIterator first, InputIterator last) {
-			WSTL_DEBUG(!(last < first));
-			range_init(first, last);
+			WSTL_DEBUG(wstl::valid_range(first, last));
+			range_init(first, last, wstl::iterator_category(first));
 		}
 
 		vector(std::initializer_list<value_type> il) {
-			range_init(il.begin(), il.end());
+			range_init(il.begin(), il.end(), wstl::forward_iterator_tag());
 		}
 
 		vector(const vector &rhs) {
-			range_init(rhs.begin_, rhs.end_);
+			range_init(rhs.begin_, rhs.end_, wstl::forward_iterator_tag());
 		}
 
 		vector(vector &&rhs) noexcept {
@@ -248,12 +290,12 @@ namespace wstl {
 
 		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
 		void assign(InputIterator first, InputIterator last) {
-			WSTL_DEBUG(!(last < first));
-			copy_assign(first, last);
+			WSTL_DEBUG(wstl::valid_range(first, last));
+			copy_assign(first, last, wstl::iterator_category(first));
 		}
 
 		void assign(std::initializer_list<value_type> il) {
-			copy_assign(il.begin(), il.end());
+			copy_assign(il.begin(), il.end(), wstl::forward_iterator_tag());
 		}
 
 		// emplace / emplace_back
@@ -264,6 +306,23 @@ namespace wstl {
 		template <class... Args>
 		void emplace_back(Args &&...args);
 
+		// append_range / append_n / emplace_back_n, 批量追加：只检查一次容量（必要时按 get_new_cap(n) 扩容一次），
+		// 然后在尾部连续构造；平凡类型的连续区间直接 memmove
+
+		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
+		void append_range(InputIterator first, InputIterator last) {
+			WSTL_DEBUG(wstl::valid_range(first, last));
+			append_range_cat(first, last, wstl::iterator_category(first));
+		}
+
+		// 追加 n 个元素，第 i 个由 gen() 的第 i 次调用结果构造
+		template <class Generator>
+		void append_n(size_type n, Generator gen);
+
+		// 追加 n 个元素，每个都以 args... 构造
+		template <class... Args>
+		void emplace_back_n(size_type n, const Args &...args);
+
 		// push_back / pop_back
 
 		void push_back(const value_type &value);
@@ -290,7 +349,7 @@ namespace wstl {
 		template <class InputIterator, typename std::enable_if<wstl::is_input_iterator<InputIterator>::value, int>::type = 0>
 		void insert(const_iterator position, InputIterator first, InputIterator last) {
 			WSTL_DEBUG(position >= begin() && position <= end());
-			WSTL_DEBUG(!(last < first));
+			WSTL_DEBUG(wstl::valid_range(first, last));
 			copy_insert(const_cast<iterator>(position), first, last);
 		}
 
@@ -304,6 +363,28 @@ namespace wstl {
 
 		iterator erase(const_iterator first, const_iterator last);
 
+		// 删除下标在有序序列 [first, last) 中的元素，一次遍历完成，返回删除的元素个数
+		template <class InputIterator>
+		size_type erase_indices(InputIterator first, InputIterator last);
+
+		size_type erase_indices(std::initializer_list<size_type> il) {
+			return erase_indices(il.begin(), il.end());
+		}
+
+		// 不保持顺序的删除：用最后一个元素填补被删除的位置，O(1)
+		iterator unordered_erase(const_iterator position);
+
+		// 删除下标为 index 的元素并返回它，空位由最后一个元素填补
+		value_type swap_remove(size_type index);
+
+		// 不保持顺序地删除下标在有序序列 [first, last) 中的元素，返回删除的元素个数
+		template <class BidirectionalIterator>
+		size_type unordered_erase_indices(BidirectionalIterator first, BidirectionalIterator last);
+
+		size_type unordered_erase_indices(std::initializer_list<size_type> il) {
+			return unordered_erase_indices(il.begin(), il.end());
+		}
+
 		void clear() {
 			erase(begin(), end());
 		}
@@ -316,6 +397,11 @@ namespace wstl {
 			resize(new_size, value_type());
 		}
 
+		// resize_and_overwrite, 扩容到至少 n 个元素（新增部分不构造），再调用 op(data(), n) 写入内容，
+		// op 返回最终长度 (<= n)，并负责写入 [size(), 最终长度) 的全部元素；只用于可平凡析构的类型
+		template <class Operation>
+		void resize_and_overwrite(size_type n, Operation op);
+
 		void reverse() {
 			wstl::reverse(begin(), end());
 		}
@@ -335,8 +421,13 @@ namespace wstl {
 
 		void fill_init(size_type n, const value_type &value);
 
+		void parallel_fill_init(size_type n, const value_type &value, size_type threads);
+
 		template <class InputIterator>
-		void range_init(InputIterator first, InputIterator last);
+		void range_init(InputIterator first, InputIterator last, input_iterator_tag);
+
+		template <class ForwardIterator>
+		void range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
 
 		void destroy_and_recover(iterator first, iterator last, size_type n);
 
@@ -369,6 +460,23 @@ namespace wstl {
 		template <class InputIterator>
 		void copy_insert(iterator position, InputIterator first, InputIterator last);
 
+		template <class InputIterator>
+		void copy_insert_cat(iterator position, InputIterator first, InputIterator last, input_iterator_tag);
+
+		template <class ForwardIterator>
+		void copy_insert_cat(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+		// append
+
+		template <class Construct>
+		void append_construct(size_type n, Construct construct);
+
+		template <class InputIterator>
+		void append_range_cat(InputIterator first, InputIterator last, input_iterator_tag);
+
+		template <class ForwardIterator>
+		void append_range_cat(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
 		// shrink_to_fit
 		void reinsert(size_type size);
 	};
@@ -417,6 +525,7 @@ namespace wstl {
 			const auto old_size = size();
 			auto tmp = data_allocator::allocate(n);
 			wstl::uninitialized_move(begin_, end_, tmp);
+			WSTL_STATS_VECTOR_REALLOC(size() * sizeof(value_type));
 			destroy_and_recover(begin_, end_, cap_ - begin_);
 			begin_ = tmp;
 			end_ = begin_ + old_size;
@@ -464,6 +573,20 @@ namespace wstl {
 		}
 	}
 
+	// append_n, 在末尾追加 n 个由 gen() 构造的元素
+	template <class T, class Alloc>
+	template <class Generator>
+	void vector<T, Alloc>::append_n(size_type n, Generator gen) {
+		append_construct(n, [&gen](pointer p) { data_allocator::construct(p, gen()); });
+	}
+
+	// emplace_back_n, 在末尾追加 n 个以 args... 构造的元素
+	template <class T, class Alloc>
+	template <class... Args>
+	void vector<T, Alloc>::emplace_back_n(size_type n, const Args &...args) {
+		append_construct(n, [&](pointer p) { data_allocator::construct(p, args...); });
+	}
+
 	// push_back, 在末尾插入元素
 	template <class T, class Alloc>
 	void vector<T, Alloc>::push_back(const value_type &value) {
@@ -530,6 +653,71 @@ namespace wstl {
 		return pos;
 	}
 
+	// erase_indices, 下标须严格递增且小于 size()
+	// 相邻两个被删除元素之间的保留段整段前移，总共只搬移一遍元素，而逐个 erase 每次都要搬移整个尾部
+	template <class T, class Alloc>
+	template <class InputIterator>
+	typename vector<T, Alloc>::size_type vector<T, Alloc>::erase_indices(InputIterator first, InputIterator last) {
+		if (first == last) {
+			return 0;
+		}
+		auto index = static_cast<size_type>(*first);
+		WSTL_DEBUG(index < size());
+		iterator result = begin_ + index;
+		for (++first; first != last; ++first) {
+			const auto next = static_cast<size_type>(*first);
+			WSTL_DEBUG(next > index && next < size());
+			result = wstl::move(begin_ + index + 1, begin_ + next, result);
+			index = next;
+		}
+		result = wstl::move(begin_ + index + 1, end_, result);
+		const auto n = static_cast<size_type>(end_ - result);
+		data_allocator::destroy(result, end_);
+		end_ = result;
+		return n;
+	}
+
+	// unordered_erase, 把最后一个元素移到 position，返回 position（删除的是最后一个元素时为 end()）
+	template <class T, class Alloc>
+	typename vector<T, Alloc>::iterator vector<T, Alloc>::unordered_erase(const_iterator position) {
+		WSTL_DEBUG(position >= begin() && position < end());
+		iterator pos = const_cast<iterator>(position);
+		if (pos != end_ - 1) {
+			*pos = wstl::move(*(end_ - 1));
+		}
+		data_allocator::destroy(end_ - 1);
+		--end_;
+		return pos;
+	}
+
+	// swap_remove
+	template <class T, class Alloc>
+	typename vector<T, Alloc>::value_type vector<T, Alloc>::swap_remove(size_type index) {
+		THROW_OUT_OF_RANGE_IF(index >= size(), "vector<T> : out of range");
+		value_type value(wstl::move(begin_[index]));
+		unordered_erase(begin_ + index);
+		return value;
+	}
+
+	// unordered_erase_indices, 下标须严格递增且小于 size()
+	// 从最大的下标开始删除，填补空位的尾部元素此时一定不在待删除之列，每个下标只搬移一个元素
+	template <class T, class Alloc>
+	template <class BidirectionalIterator>
+	typename vector<T, Alloc>::size_type
+	vector<T, Alloc>::unordered_erase_indices(BidirectionalIterator first, BidirectionalIterator last) {
+		size_type n = 0;
+		auto bound = size();
+		while (last != first) {
+			--last;
+			const auto index = static_cast<size_type>(*last);
+			WSTL_DEBUG(index < bound);
+			unordered_erase(begin_ + index);
+			bound = index;
+			++n;
+		}
+		return n;
+	}
+
 	// resize, 修改容器大小
 	template <class T, class Alloc>
 	void vector<T, Alloc>::resize(size_type new_size, const value_type &value) {
@@ -540,6 +728,18 @@ namespace wstl {
 		}
 	}
 
+	// resize_and_overwrite
+	template <class T, class Alloc>
+	template <class Operation>
+	void vector<T, Alloc>::resize_and_overwrite(size_type n, Operation op) {
+		static_assert(std::is_trivially_destructible<T>::value,
+					  "vector<T> : resize_and_overwrite requires a trivially destructible type");
+		reserve(n);
+		const auto new_size = static_cast<size_type>(op(begin_, n));
+		WSTL_DEBUG(new_size <= n);
+		end_ = begin_ + new_size;
+	}
+
 	// swap, 交换两个 vector 容器
 	template <class T, class Alloc>
 	void vector<T, Alloc>::swap(vector &rhs) noexcept {
@@ -590,10 +790,97 @@ namespace wstl {
 		wstl::uninitialized_fill_n(begin_, n, value);
 	}
 
+	// parallel_fill_init, 多线程分段填充初始化
+	template <class T, class Alloc>
+	void vector<T, Alloc>::parallel_fill_init(size_type n, const value_type &value, size_type threads) {
+		// 每段至少一个页面，且段的边界落在页面边界上，避免两个线程首次写入同一个页面
+		const size_type page = vector_page_size();
+		const size_type page_elems = sizeof(T) >= page ? 1 : page / sizeof(T);
+		if (threads == 0) {
+			threads = std::thread::hardware_concurrency();
+		}
+		threads = wstl::min(threads, (n + page_elems - 1) / page_elems);
+		if (threads <= 1) {
+			fill_init(n, value);
+			return;
+		}
+		init_space(n, wstl::max(static_cast<size_type>(16), n));
+
+		// begin_ 不一定页对齐，按实际地址把第 i 段的起点向上取整到页面边界，再换算为第一个不早于该边界开始的元素
+		// sizeof(T) 不整除页面大小时，跨越边界的那个元素仍会与下一段共享一个页面
+		const size_type chunk = (n + threads - 1) / threads;
+		const auto base = reinterpret_cast<uintptr_t>(begin_);
+		vector<size_type> bounds(threads + 1);
+		bounds[0] = 0;
+		for (size_type i = 1; i < threads; ++i) {
+			const auto addr = (base + i * chunk * sizeof(T) + page - 1) / page * page;
+			const auto index = (addr - base + sizeof(T) - 1) / sizeof(T);
+			bounds[i] = wstl::max(bounds[i - 1], wstl::min(n, static_cast<size_type>(index)));
+		}
+		bounds[threads] = n;
+
+		vector<std::exception_ptr> errors(threads);
+		auto fill_chunk = [this, &bounds, &value, &errors](size_type i) {
+			const auto first = bounds[i];
+			const auto last = bounds[i + 1];
+			try {
+				wstl::uninitialized_fill_n(begin_ + first, last - first, value);
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		};
+
+		vector<std::thread> workers;
+		workers.reserve(threads - 1);
+		for (size_type i = 1; i < threads; ++i) {
+			try {
+				workers.emplace_back(fill_chunk, i);
+			} catch (...) {
+				// 无法创建线程时由调用线程完成这一段
+				fill_chunk(i);
+			}
+		}
+		fill_chunk(0);
+		for (auto &worker : workers) {
+			worker.join();
+		}
+
+		// uninitialized_fill_n 失败时已销毁本段内构造的元素，这里销毁其余成功的段并释放空间
+		std::exception_ptr error;
+		for (size_type i = 0; i < threads; ++i) {
+			if (errors[i] && !error) {
+				error = errors[i];
+			}
+		}
+		if (error) {
+			for (size_type i = 0; i < threads; ++i) {
+				if (!errors[i]) {
+					data_allocator::destroy(begin_ + bounds[i], begin_ + bounds[i + 1]);
+				}
+			}
+			data_allocator::deallocate(begin_, cap_ - begin_);
+			begin_ = end_ = cap_ = nullptr;
+			std::rethrow_exception(error);
+		}
+	}
+
 	// range_init, 区间初始化
+	// 输入迭代器只能遍历一次，无法预先求出长度，逐个追加并按 get_new_cap 摊还扩容
 	template <class T, class Alloc>
 	template <class InputIterator>
-	void vector<T, Alloc>::range_init(InputIterator first, InputIterator last) {
+	void vector<T, Alloc>::range_init(InputIterator first, InputIterator last, input_iterator_tag) {
+		init_space(0, 16);
+		try {
+			append_range_cat(first, last, input_iterator_tag());
+		} catch (...) {
+			destroy_and_recover(begin_, end_, cap_ - begin_);
+			throw;
+		}
+	}
+
+	template <class T, class Alloc>
+	template <class ForwardIterator>
+	void vector<T, Alloc>::range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
 		const auto len = static_cast<size_type>(wstl::distance(first, last));
 		const auto new_size = wstl::max(static_cast<size_type>(16), len);
 		init_space(len, new_size);
@@ -685,6 +972,7 @@ namespace wstl {
 			data_allocator::deallocate(new_begin, new_size);
 			throw;
 		}
+		WSTL_STATS_VECTOR_REALLOC(size() * sizeof(value_type));
 		destroy_and_recover(begin_, end_, cap_ - begin_);
 		begin_ = new_begin;
 		end_ = new_end;
@@ -707,6 +995,7 @@ namespace wstl {
 			data_allocator::deallocate(new_begin, new_size);
 			throw;
 		}
+		WSTL_STATS_VECTOR_REALLOC(size() * sizeof(value_type));
 		destroy_and_recover(begin_, end_, cap_ - begin_);
 		begin_ = new_begin;
 		end_ = new_end;
@@ -729,6 +1018,7 @@ namespace wstl {
 			data_allocator::deallocate(new_begin, new_size);
 			throw;
 		}
+		WSTL_STATS_VECTOR_REALLOC(size() * sizeof(value_type));
 		destroy_and_recover(begin_, end_, cap_ - begin_);
 		begin_ = new_begin;
 		end_ = new_end;
@@ -770,6 +1060,7 @@ namespace wstl {
 				destroy_and_recover(new_begin, new_end, new_size);
 				throw;
 			}
+			WSTL_STATS_VECTOR_REALLOC(size() * sizeof(value_type));
 			destroy_and_recover(begin_, end_, cap_ - begin_);
 			begin_ = new_begin;
 			end_ = new_end;
@@ -785,6 +1076,33 @@ namespace wstl {
 		if (first == last) {
 			return;
 		}
+		if (position == end_) {
+			append_range_cat(first, last, wstl::iterator_category(first));
+			return;
+		}
+		copy_insert_cat(position, first, last, wstl::iterator_category(first));
+	}
+
+	// 输入迭代器只能遍历一次：先追加到尾部（按 get_new_cap 摊还扩容），再把新元素旋转到 position
+	// 追加途中抛出异常时删除已追加的元素，原有元素不受影响
+	template <class T, class Alloc>
+	template <class InputIterator>
+	void vector<T, Alloc>::copy_insert_cat(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+		const auto offset = position - begin_;
+		const auto old_size = size();
+		try {
+			append_range_cat(first, last, input_iterator_tag());
+		} catch (...) {
+			erase(begin_ + old_size, end_);
+			throw;
+		}
+		wstl::rotate(begin_ + offset, begin_ + old_size, end_);
+	}
+
+	// 前向迭代器先求出长度，容量足够时原地后移，否则只扩容一次
+	template <class T, class Alloc>
+	template <class ForwardIterator>
+	void vector<T, Alloc>::copy_insert_cat(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
 		const auto n = wstl::distance(first, last);
 		if (static_cast<size_type>(cap_ - end_) >= n) {
 			const auto after_elems = end_ - position;
@@ -812,6 +1130,7 @@ namespace wstl {
 				destroy_and_recover(new_begin, new_end, new_size);
 				throw;
 			}
+			WSTL_STATS_VECTOR_REALLOC(size() * sizeof(value_type));
 			destroy_and_recover(begin_, end_, cap_ - begin_);
 			begin_ = new_begin;
 			end_ = new_end;
@@ -819,6 +1138,77 @@ namespace wstl {
 		}
 	}
 
+	// append_construct, 在末尾依次调用 n 次 construct(p) 构造元素
+	// 需要扩容时先在新空间的尾部构造新元素，再搬移旧元素，因此构造参数可以引用本容器中的元素
+	template <class T, class Alloc>
+	template <class Construct>
+	void vector<T, Alloc>::append_construct(size_type n, Construct construct) {
+		if (static_cast<size_type>(cap_ - end_) >= n) {
+			for (; n > 0; --n) {
+				construct(end_);
+				++end_;
+			}
+			return;
+		}
+		const auto old_size = size();
+		const auto new_size = get_new_cap(n);
+		auto new_begin = data_allocator::allocate(new_size);
+		auto new_end = new_begin + old_size;
+		try {
+			for (; n > 0; --n) {
+				construct(new_end);
+				++new_end;
+			}
+			wstl::uninitialized_move(begin_, end_, new_begin);
+		} catch (...) {
+			data_allocator::destroy(new_begin + old_size, new_end);
+			data_allocator::deallocate(new_begin, new_size);
+			throw;
+		}
+		WSTL_STATS_VECTOR_REALLOC(old_size * sizeof(value_type));
+		destroy_and_recover(begin_, end_, cap_ - begin_);
+		begin_ = new_begin;
+		end_ = new_end;
+		cap_ = begin_ + new_size;
+	}
+
+	// append_range_cat, 输入迭代器无法预知长度，逐个追加
+	template <class T, class Alloc>
+	template <class InputIterator>
+	void vector<T, Alloc>::append_range_cat(InputIterator first, InputIterator last, input_iterator_tag) {
+		for (; first != last; ++first) {
+			emplace_back(*first);
+		}
+	}
+
+	// 前向迭代器先求出长度，最多扩容一次；[first, last) 可以是本容器中的元素
+	template <class T, class Alloc>
+	template <class ForwardIterator>
+	void vector<T, Alloc>::append_range_cat(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		const auto n = static_cast<size_type>(wstl::distance(first, last));
+		if (static_cast<size_type>(cap_ - end_) >= n) {
+			end_ = wstl::uninitialized_copy(first, last, end_);
+			return;
+		}
+		const auto old_size = size();
+		const auto new_size = get_new_cap(n);
+		auto new_begin = data_allocator::allocate(new_size);
+		auto new_end = new_begin + old_size;
+		try {
+			new_end = wstl::uninitialized_copy(first, last, new_end);
+			wstl::uninitialized_move(begin_, end_, new_begin);
+		} catch (...) {
+			data_allocator::destroy(new_begin + old_size, new_end);
+			data_allocator::deallocate(new_begin, new_size);
+			throw;
+		}
+		WSTL_STATS_VECTOR_REALLOC(old_size * sizeof(value_type));
+		destroy_and_recover(begin_, end_, cap_ - begin_);
+		begin_ = new_begin;
+		end_ = new_end;
+		cap_ = begin_ + new_size;
+	}
+
 	// reinsert, 重新插入元素
 	template <class T, class Alloc>
 	void vector<T, Alloc>::reinsert(size_type size) {
@@ -829,6 +1219,8 @@ namespace wstl {
 			data_allocator::deallocate(new_begin, size);
 			throw;
 		}
+		// 参数 size 遮蔽了成员函数 size()
+		WSTL_STATS_VECTOR_REALLOC(static_cast<size_type>(end_ - begin_) * sizeof(value_type));
 		destroy_and_recover(begin_, end_, cap_ - begin_);
 		begin_ = new_begin;
 		end_ = begin_ + size;
@@ -874,6 +1266,24 @@ namespace wstl {
 		lhs.swap(rhs);
 	}
 
+	// erase_if, 删除满足 pred 的元素，返回删除的元素个数
+	template <class T, class Alloc, class Predicate>
+	typename vector<T, Alloc>::size_type erase_if(vector<T, Alloc> &v, Predicate pred) {
+		const auto it = wstl::remove_if(v.begin(), v.end(), pred);
+		const auto n = static_cast<typename vector<T, Alloc>::size_type>(v.end() - it);
+		v.erase(it, v.end());
+		return n;
+	}
+
+	// erase, 删除等于 value 的元素，返回删除的元素个数
+	template <class T, class Alloc, class U>
+	typename vector<T, Alloc>::size_type erase(vector<T, Alloc> &v, const U &value) {
+		const auto it = wstl::remove(v.begin(), v.end(), value);
+		const auto n = static_cast<typename vector<T, Alloc>::size_type>(v.end() - it);
+		v.erase(it, v.end());
+		return n;
+	}
+
 } // namespace wstl
 
 #endif // WSTL_VECTOR_H
\ No newline at end of file